@@ -0,0 +1,189 @@
+/// \file Dashboard.cpp
+/// \brief Code for the dashboard class CDashboard.
+
+#include <algorithm>
+#include <utility>
+
+#include <DirectXMath.h>
+
+#include "Dashboard.h"
+
+/// Name and timezone offset from UTC in minutes of each data center. The
+/// offsets are standard time, so they ignore daylight saving time.
+
+static const std::pair<const char*, int> DASHBOARD_CLOCKS[] = {
+  {"Oregon", -480}, {"California", -480}, {"Iowa", -360}, {"Texas", -360},
+  {"Virginia", -300}, {"Ohio", -300}, {"Sao Paulo", -180}, {"Dublin", 0},
+  {"London", 0}, {"Frankfurt", 60}, {"Paris", 60}, {"Stockholm", 60},
+  {"Tel Aviv", 120}, {"Bahrain", 180}, {"Dubai", 240}, {"Mumbai", 330},
+  {"Hyderabad", 330}, {"Jakarta", 420}, {"Singapore", 480}, {"Hong Kong", 480},
+  {"Seoul", 540}, {"Tokyo", 540}, {"Sydney", 600}, {"Melbourne", 600},
+  {"Auckland", 720}
+}; //DASHBOARD_CLOCKS
+
+static const float HAND_LENGTH[] = {140.0f, 140.0f, 110.0f}; ///< Hand lengths, indexed by `ClockHand`.
+static const float NAME_HEIGHT = 28.0f; ///< Height of the space for a clock's name.
+
+/// Get one clock's lane of an array of four-clock vectors.
+/// \param v Array of four-clock vectors.
+/// \param i Clock index.
+/// \return Reference to the clock's lane.
+
+static float& Lane(std::vector<XMFLOAT4>& v, UINT i){
+  return (&v[i/4].x)[i%4];
+} //Lane
+
+/// Lay out the clocks in a grid that fills the window, with each clock
+/// scaled to fit its cell above its name, and find the distinct timezones.
+/// \param pRenderer Pointer to the renderer, which must have the sprites loaded.
+/// \param w Window width.
+/// \param h Window height.
+
+void CDashboard::Initialize(LSpriteRenderer* pRenderer, UINT w, UINT h){
+  m_stdClock.clear();
+  m_stdOffset.clear();
+
+  m_fLineWidth = pRenderer->GetWidth(eSprite::Line);
+  m_fWinHeight = (float)h;
+
+  const UINT n = (UINT)(sizeof(DASHBOARD_CLOCKS)/sizeof(DASHBOARD_CLOCKS[0])); //number of clocks
+  const UINT cols = (UINT)ceilf(sqrtf((float)n)); //number of columns
+  const UINT rows = (n + cols - 1)/cols; //number of rows
+  const float cellw = (float)w/cols; //cell width
+  const float cellh = (float)h/rows; //cell height
+  const float scale = std::min(cellw, cellh - NAME_HEIGHT)/
+    pRenderer->GetWidth(eSprite::Background); //scale of each clock
+
+  for(UINT i=0; i<n; i++){
+    CClock c;
+    c.m_strName = DASHBOARD_CLOCKS[i].first;
+    c.m_nOffset = DASHBOARD_CLOCKS[i].second;
+    c.m_vPos = Vector2((i%cols + 0.5f)*cellw, h - (i/cols + 0.5f)*cellh + NAME_HEIGHT/2.0f);
+    c.m_fScale = scale;
+
+    const auto p = std::find(m_stdOffset.begin(), m_stdOffset.end(), c.m_nOffset);
+    c.m_nZone = (UINT)(p - m_stdOffset.begin());
+    if(p == m_stdOffset.end())m_stdOffset.push_back(c.m_nOffset); //new timezone
+
+    m_stdClock.push_back(c);
+  } //for
+
+  m_stdHandTime.assign(3*m_stdOffset.size(), 0.0f);
+
+  const size_t k = (n + 3)/4; //number of four-clock vectors
+  m_stdX.assign(k, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+  m_stdY.assign(k, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+  m_stdScale.assign(k, XMFLOAT4(0.0f, 0.0f, 0.0f, 0.0f));
+
+  for(UINT i=0; i<n; i++){
+    Lane(m_stdX, i) = m_stdClock[i].m_vPos.x;
+    Lane(m_stdY, i) = m_stdClock[i].m_vPos.y;
+    Lane(m_stdScale, i) = m_stdClock[i].m_fScale;
+  } //for
+
+  m_stdHand.assign(3*n, LSpriteDesc2D());
+
+  for(UINT i=0; i<n; i++){
+    m_stdHand[3*i + (UINT)ClockHand::Second].m_nSpriteIndex = (UINT)eSprite::RedLine;
+    m_stdHand[3*i + (UINT)ClockHand::Minute].m_nSpriteIndex = (UINT)eSprite::Line;
+    m_stdHand[3*i + (UINT)ClockHand::Hour].m_nSpriteIndex = (UINT)eSprite::Line;
+  } //for
+
+  m_nTime = 0; //so that the next update isn't skipped
+} //Initialize
+
+/// Update the dashboard to a new time, unless it is already at that time.
+/// First convert the time to each timezone once, and then compute the
+/// hand sprites for all clocks four at a time, with the sine and cosine
+/// of the hand angles from `XMVectorSinCos()`. Each hand sprite is the line
+/// sprite centered halfway along the hand, rotated to the hand's angle,
+/// and stretched to its length.
+/// \param t The current time.
+
+void CDashboard::Update(time_t t){
+  if(t == m_nTime)return; //nothing has changed
+  m_nTime = t;
+
+  for(UINT z=0; z<m_stdOffset.size(); z++){ //once per timezone
+    const time_t local = t + 60*(time_t)m_stdOffset[z]; //time in timezone
+    struct tm timeinfo;
+    gmtime_s(&timeinfo, &local);
+
+    const float fSecs = (float)timeinfo.tm_sec;
+    const float fMins = timeinfo.tm_min + fSecs/60;
+    const float fHrs  = timeinfo.tm_hour%12 + fMins/60;
+
+    float* p = &m_stdHandTime[3*z]; //shorthand
+    p[(UINT)ClockHand::Second] = fSecs;
+    p[(UINT)ClockHand::Minute] = fMins;
+    p[(UINT)ClockHand::Hour] = 5*fHrs;
+  } //for
+
+  const UINT n = (UINT)m_stdClock.size(); //number of clocks
+  const XMVECTOR top = XMVectorReplicate(XM_PIDIV2); //angle of 12 o'clock
+
+  for(UINT k=0; k<m_stdX.size(); k++){ //four clocks at a time
+    const XMVECTOR x = XMLoadFloat4(&m_stdX[k]);
+    const XMVECTOR y = XMLoadFloat4(&m_stdY[k]);
+    const XMVECTOR scale = XMLoadFloat4(&m_stdScale[k]);
+
+    for(UINT h=0; h<3; h++){ //for each hand
+      XMFLOAT4 time(0.0f, 0.0f, 0.0f, 0.0f); //hand times, zero for padding
+
+      for(UINT j=0; j<4 && 4*k + j<n; j++)
+        (&time.x)[j] = m_stdHandTime[3*m_stdClock[4*k + j].m_nZone + h];
+
+      const XMVECTOR theta = XMVectorSubtract(top,
+        XMVectorScale(XMLoadFloat4(&time), XM_2PI/60.0f)); //hand angles
+      XMVECTOR sine, cosine;
+      XMVectorSinCos(&sine, &cosine, theta);
+
+      const XMVECTOR half = XMVectorScale(scale, HAND_LENGTH[h]/2.0f); //half hand lengths
+      XMFLOAT4 midx, midy, roll, stretch;
+      XMStoreFloat4(&midx, XMVectorMultiplyAdd(half, cosine, x));
+      XMStoreFloat4(&midy, XMVectorMultiplyAdd(half, sine, y));
+      XMStoreFloat4(&roll, theta);
+      XMStoreFloat4(&stretch, XMVectorScale(half, 2.0f/m_fLineWidth));
+
+      for(UINT j=0; j<4 && 4*k + j<n; j++){
+        LSpriteDesc2D& d = m_stdHand[3*(4*k + j) + h]; //shorthand
+        d.m_vPos = Vector2((&midx.x)[j], (&midy.x)[j]);
+        d.m_fRoll = (&roll.x)[j];
+        d.m_fXScale = (&stretch.x)[j];
+      } //for
+    } //for
+  } //for
+} //Update
+
+/// Draw the clock faces, then all of the hands from the list of hand
+/// sprites, then the bezels, and then the names.
+/// \param pRenderer Pointer to the renderer.
+
+void CDashboard::Draw(LSpriteRenderer* pRenderer) const{
+  LSpriteDesc2D d; //sprite descriptor for faces and bezels
+
+  d.m_nSpriteIndex = (UINT)eSprite::Background;
+
+  for(const CClock& c: m_stdClock){
+    d.m_vPos = c.m_vPos;
+    d.m_fXScale = d.m_fYScale = c.m_fScale;
+    pRenderer->Draw(&d);
+  } //for
+
+  for(const LSpriteDesc2D& hand: m_stdHand)
+    pRenderer->Draw(&hand);
+
+  d.m_nSpriteIndex = (UINT)eSprite::Bezel;
+
+  for(const CClock& c: m_stdClock){
+    d.m_vPos = c.m_vPos;
+    d.m_fXScale = d.m_fYScale = c.m_fScale;
+    pRenderer->Draw(&d);
+  } //for
+
+  for(const CClock& c: m_stdClock){
+    const float r = c.m_fScale*pRenderer->GetWidth(eSprite::Background)/2.0f; //face radius
+    const Vector2 pos(c.m_vPos.x - r, m_fWinHeight - c.m_vPos.y + r); //screen position of name
+    pRenderer->DrawScreenText(c.m_strName.c_str(), pos);
+  } //for
+} //Draw
@@ -0,0 +1,60 @@
+/// \file Dashboard.h
+/// \brief Interface for the clock class CClock and the dashboard class CDashboard.
+
+#ifndef __L4RC_GAME_DASHBOARD_H__
+#define __L4RC_GAME_DASHBOARD_H__
+
+#include <string>
+#include <vector>
+
+#include "GameDefines.h"
+#include "SpriteDesc.h"
+#include "SpriteRenderer.h"
+
+/// \brief Clock.
+///
+/// One clock on the dashboard.
+
+class CClock{
+  public:
+    std::string m_strName; ///< Name shown under the clock.
+    int m_nOffset = 0; ///< Timezone offset from UTC in minutes.
+    Vector2 m_vPos; ///< Position of center.
+    float m_fScale = 1.0f; ///< Scale, 1 for the size of the single clock.
+    UINT m_nZone = 0; ///< Index of timezone.
+}; //CClock
+
+/// \brief Dashboard.
+///
+/// A grid of small clocks, one for each data center, each showing the time
+/// in its own timezone. The time in each timezone is worked out only once a
+/// second, however many clocks share it. The hands of all clocks are then
+/// computed in one pass, four clocks at a time with DirectXMath, into a
+/// single list of sprite descriptors that each stretch the line sprite into
+/// one hand. Drawing the dashboard is a pass over that list in the batched
+/// sprite renderer, with one sprite per hand instead of the many that
+/// `DrawLine()` uses. The clock centers and scales are kept in structure of
+/// arrays form, padded to a multiple of four.
+
+class CDashboard{
+  private:
+    std::vector<CClock> m_stdClock; ///< Clocks.
+    std::vector<int> m_stdOffset; ///< Offset of each timezone in minutes.
+    std::vector<float> m_stdHandTime; ///< Hand times for each timezone, indexed by `ClockHand`.
+
+    std::vector<XMFLOAT4> m_stdX; ///< Clock center x coordinates.
+    std::vector<XMFLOAT4> m_stdY; ///< Clock center y coordinates.
+    std::vector<XMFLOAT4> m_stdScale; ///< Clock scales.
+
+    std::vector<LSpriteDesc2D> m_stdHand; ///< Hand sprites, three per clock.
+    float m_fLineWidth = 1.0f; ///< Width of line sprite.
+    float m_fWinHeight = 0.0f; ///< Window height.
+    time_t m_nTime = 0; ///< Time that the hands are for.
+
+  public:
+    void Initialize(LSpriteRenderer*, UINT, UINT); ///< Lay out the clocks.
+    void Update(time_t); ///< Update timezones and hands.
+    void Draw(LSpriteRenderer*) const; ///< Draw the clocks.
+}; //CDashboard
+
+#endif //__L4RC_GAME_DASHBOARD_H__
@@ -7,14 +7,15 @@
 #include "SpriteRenderer.h"
 #include "ComponentIncludes.h"
 
-/// Create the renderer and the sprite descriptor load images and sounds, and
-/// begin the game.
+/// Create the renderer and the sprite descriptor load images and sounds,
+/// lay out the dashboard, and begin the game.
 
 void CGame::Initialize(){
   m_pRenderer = new LSpriteRenderer(eSpriteMode::Batched2D); 
   m_pRenderer->Initialize(eSprite::Size); 
   LoadImages(); //load images from xml file list
   LoadSounds(); //load the sounds for this game
+  m_cDashboard.Initialize(m_pRenderer, m_nWinWidth, m_nWinHeight); //lay out dashboard
 } //Initialize
 
 /// Load the specific images needed for this game. This is where `eSprite`
@@ -55,61 +56,191 @@ void CGame::Release(){
 void CGame::KeyboardHandler(){
   m_pKeyboard->GetState(); //get current keyboard state 
   
-  if(m_pKeyboard->TriggerDown(VK_F2)) //toggle frame rate 
+  if(m_pKeyboard->TriggerDown(VK_F2)){ //toggle frame rate 
     m_bDrawFrameRate = !m_bDrawFrameRate;
+    m_bRedraw = true;
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F3)){ //toggle idle mode
+    m_bIdle = !m_bIdle;
+    if(m_bIdle)m_bSweep = false;
+    m_bRedraw = true;
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F4)){ //toggle sweep mode
+    m_bSweep = !m_bSweep;
+    if(m_bSweep)m_bIdle = false;
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F6)){ //toggle dashboard
+    m_bDashboard = !m_bDashboard;
+    m_bRedraw = true;
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F5)){ //time the hand geometry
+    RunBench();
+    m_bRedraw = true;
+  } //if
 } //KeyboardHandler
 
-/// Draw the current frame rate to a hard-coded position in the window.
-/// The frame rate will be drawn in a hard-coded position using the font
-/// specified in gamesettings.xml.
+/// Update the cached date and time string and the cached ends of the hands
+/// to a new time, and play the tick sound. This is the only place that the
+/// time is converted to local time and formatted, and the only place that
+/// the hand ends are computed, so it costs nothing to render the same second
+/// more than once.
+/// \param t The new time.
 
-void CGame::DrawFrameRateText(){
-  const std::string s = std::to_string(m_pTimer->GetFPS()) + " fps"; //frame rate
-  const Vector2 pos(m_nWinWidth - 128.0f, 30.0f); //hard-coded position
-  m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
-} //DrawFrameRateText
+void CGame::UpdateTime(time_t t){
+  m_nTime = t;
 
-/// Draw date and time string to a fixed position.
-/// \param t The current time.
+  //date and time string
 
-void CGame::RenderDateAndTime(time_t t){
   const UINT bufsize = 256;
   char buffer[bufsize];
-  //const time_t t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
   ctime_s(buffer, bufsize, &t);
-  m_pRenderer->DrawScreenText(buffer, Vector2(150.0f, 580.0f));
-} //RenderDateAndTime
+  m_strDate = buffer;
 
-/// Draw the clock's hands.
-/// \param t The current time.
+  //parse time info into fHrs, fMins, fSecs.
 
-void CGame::RenderClockHands(time_t t){
   struct tm timeinfo;
   localtime_s(&timeinfo, &t);
 
-  //parse time info into fHrs, fMins, fSecs.
-
   const float fSecs = (float)timeinfo.tm_sec;
   const float fMins = timeinfo.tm_min + fSecs/60;
   const float fHrs  = timeinfo.tm_hour%12 + fMins/60;
 
+  m_vHandEnd[(UINT)ClockHand::Hour]   = GetHandEnd(5*fHrs, 110.0f);
+  m_vHandEnd[(UINT)ClockHand::Minute] = GetHandEnd(fMins, 140.0f);
+  m_vHandEnd[(UINT)ClockHand::Second] = GetHandEnd(fSecs, 140.0f);
+
+  m_pAudio->play(eSound::Tick); //tick sound once per second
+} //UpdateTime
+
+/// Block until the clock next changes, which is at the start of the next
+/// second, or until there is input for the window, whichever comes first.
+/// Waiting for input as well as for time means that the keyboard stays
+/// responsive even though the thread sleeps for most of each second.
+
+void CGame::WaitForChange() const{
+  const auto now = std::chrono::system_clock::now(); //current time
+  const long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    now.time_since_epoch()).count()%1000; //milliseconds into current second
+
+  MsgWaitForMultipleObjectsEx(0, nullptr, (DWORD)(1000 - ms), QS_ALLINPUT,
+    MWMO_INPUTAVAILABLE);
+} //WaitForChange
+
+/// Match the monotonic clock to the wall clock for the sweep second hand.
+/// This is called whenever the wall clock changes second, with the time
+/// that the change was seen, so the small error in when that happens
+/// doesn't matter. Between calls the sweep second hand follows the
+/// monotonic clock, so it never runs backwards or jumps if the wall clock
+/// is adjusted within the second.
+/// \param now Current wall clock time.
+
+void CGame::SetSweepBase(const std::chrono::system_clock::time_point& now){
+  const long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+    now.time_since_epoch()).count()%60000000; //microseconds past the minute
+
+  m_fSweepBase = us/1000000.0f;
+  m_tSweepBase = std::chrono::steady_clock::now();
+} //SetSweepBase
+
+/// Get the time to show on the sweep second hand from the monotonic clock.
+/// \return Seconds past the minute, including the fraction of a second.
+
+const float CGame::GetSweepSeconds() const{
+  const std::chrono::duration<float> dt = 
+    std::chrono::steady_clock::now() - m_tSweepBase; //time since base
+
+  return fmodf(m_fSweepBase + dt.count(), 60.0f);
+} //GetSweepSeconds
+
+/// Time the geometry of all three hands over many frames, computed with
+/// `cos()` and `sin()` in `GetHandEnd()` and by looking it up in the hand
+/// table, and put the time per frame for each in nanoseconds into a string
+/// to draw.
+
+void CGame::RunBench(){
+  using clock = std::chrono::high_resolution_clock; //shorthand
+  const UINT n = 1000000; //number of frames
+  Vector2 sum; //sum of hand ends, so that the work can't be optimized away
+
+  const auto t0 = clock::now(); //start time
+
+  for(UINT i=0; i<n; i++){
+    const float t = 60.0f*i/n; //time in units of 1/60 of a rotation
+    sum += GetHandEnd(t/12.0f, 110.0f) + GetHandEnd(t, 140.0f) + 
+      GetHandEnd(60.0f*t, 140.0f);
+  } //for
+
+  const auto t1 = clock::now(); //end of cos and sin, start of table
+
+  for(UINT i=0; i<n; i++){
+    const float t = 60.0f*i/n; //time in units of 1/60 of a rotation
+    sum += 3.0f*m_vWinCenter + 110.0f*m_cHandTable.GetDirection(t/12.0f) + 
+      140.0f*m_cHandTable.GetDirection(t) + 
+      140.0f*m_cHandTable.GetDirection(60.0f*t);
+  } //for
+
+  const auto t2 = clock::now(); //end time
+
+  const std::chrono::duration<double, std::nano> trig = t1 - t0; //time for cos and sin
+  const std::chrono::duration<double, std::nano> table = t2 - t1; //time for table
+
+  volatile float sink = sum.x + sum.y; //use the sum
+  (void)sink;
+
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer), "cos/sin %.1f ns, table %.1f ns",
+    trig.count()/n, table.count()/n);
+  m_strBench = buffer;
+} //RunBench
+
+/// Draw the current frame rate to a hard-coded position in the window.
+/// The frame rate will be drawn in a hard-coded position using the font
+/// specified in gamesettings.xml.
+
+void CGame::DrawFrameRateText(){
+  const std::string s = std::to_string(m_pTimer->GetFPS()) + " fps"; //frame rate
+  const Vector2 pos(m_nWinWidth - 128.0f, 30.0f); //hard-coded position
+  m_pRenderer->DrawScreenText(s.c_str(), pos); //draw to screen
+} //DrawFrameRateText
+
+/// Draw the result of the last hand geometry benchmark, if there is one, to a
+/// hard-coded position in the window.
+
+void CGame::DrawBenchText(){
+  if(!m_strBench.empty())
+    m_pRenderer->DrawScreenText(m_strBench.c_str(), Vector2(30.0f, 30.0f));
+} //DrawBenchText
+
+/// Draw the cached date and time string to a fixed position.
+
+void CGame::RenderDateAndTime(){
+  m_pRenderer->DrawScreenText(m_strDate.c_str(), Vector2(150.0f, 580.0f));
+} //RenderDateAndTime
+
+/// Draw the clock's hands from the cached hand ends, except for the second
+/// hand in sweep mode, which is drawn at the exact time every frame using the
+/// hand table.
+
+void CGame::RenderClockHands(){
   //hour hand
-  Vector2 vEnd = GetHandEnd(5*fHrs, 110.0f); //position of end of hand
+  Vector2 vEnd = m_vHandEnd[(UINT)ClockHand::Hour]; //position of end of hand
   m_pRenderer->DrawLine(eSprite::Line, m_vWinCenter, vEnd); //draw hand
   RenderArrowhead(vEnd); //draw arrowhead on hand
 
   //minute hand
-  vEnd = GetHandEnd(fMins, 140.0f); //position of end of hand
+  vEnd = m_vHandEnd[(UINT)ClockHand::Minute]; //position of end of hand
   m_pRenderer->DrawLine(eSprite::Line, m_vWinCenter, vEnd); //draw hand
   RenderArrowhead(vEnd); //draw arrowhead on hand
 
   //second hand
-  vEnd = GetHandEnd(fSecs, 140.0f); //position of end of hand
+  vEnd = m_bSweep? //position of end of hand
+    m_vWinCenter + 140.0f*m_cHandTable.GetDirection(GetSweepSeconds()):
+    m_vHandEnd[(UINT)ClockHand::Second];
   m_pRenderer->DrawLine(eSprite::RedLine, m_vWinCenter, vEnd); //draw hand
-  
-  //tick sound once per second
-  if(fSecs != m_fPrevTicks)m_pAudio->play(eSound::Tick);
-  m_fPrevTicks = fSecs;
 } //RenderClockHands
 
 /// Get the position of the end of a clock hand.
@@ -134,22 +265,29 @@ void CGame::RenderArrowhead(const Vector2& vEnd){
   //**** Students enrolled in CSCE 5255 - Your arrowhead code goes here
 } //RenderArrowhead
 
-/// Draw the clock. The renderer is notified of the start and end of the
-/// frame so that it can let Direct3D do its pipelining jiggery-pokery.
+/// Draw the clock, or the dashboard if it is switched on. The renderer is
+/// notified of the start and end of the frame so that it can let Direct3D
+/// do its pipelining jiggery-pokery.
 
 void CGame::RenderFrame(){
   m_pRenderer->BeginFrame(); //required before rendering
-  
-  m_pRenderer->Draw(eSprite::Background, m_vWinCenter); //draw background
-  
-  const time_t t = 
-    std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-  RenderDateAndTime(t); //draw date and time string
-  RenderClockHands(t); //render clock hands
 
-  m_pRenderer->Draw(eSprite::Bezel, m_vWinCenter); //draw bezel
+  if(m_bDashboard){ //draw dashboard
+    m_cDashboard.Update(m_nTime); //does nothing unless the second has changed
+    m_cDashboard.Draw(m_pRenderer);
+  } //if
+
+  else{ //draw single clock
+    m_pRenderer->Draw(eSprite::Background, m_vWinCenter); //draw background
+    
+    RenderDateAndTime(); //draw date and time string
+    RenderClockHands(); //render clock hands
+
+    m_pRenderer->Draw(eSprite::Bezel, m_vWinCenter); //draw bezel
+  } //else
 
   if(m_bDrawFrameRate)DrawFrameRateText(); //draw frame rate, if required
+  DrawBenchText(); //draw benchmark result, if any
 
   m_pRenderer->EndFrame(); //required after rendering
 } //RenderFrame
@@ -158,7 +296,11 @@ void CGame::RenderFrame(){
 /// of animation, which involves the following. Handle keyboard input.
 /// Notify the  audio player at the start of each frame so that it can prevent
 /// multiple copies of a sound from starting on the same frame.  
-/// Move the game objects. Render a frame of animation.
+/// Move the game objects. Update the cached date string and hands if the
+/// second has changed. Render a frame of animation. In idle mode the frame is
+/// only rendered if something on it has changed, and otherwise the thread
+/// blocks until the next second instead, so that the clock uses next to no
+/// CPU or GPU time.
 
 void CGame::ProcessFrame(){
   KeyboardHandler(); //handle keyboard input
@@ -167,5 +309,19 @@ void CGame::ProcessFrame(){
   m_pTimer->Tick([&](){ //all time-dependent function calls should go here
   });
 
-  RenderFrame(); //render a frame of animation
+  const auto now = std::chrono::system_clock::now(); //current time
+  const time_t t = std::chrono::system_clock::to_time_t(now);
+
+  if(t != m_nTime){ //the clock has changed
+    UpdateTime(t);
+    SetSweepBase(now);
+    m_bRedraw = true;
+  } //if
+
+  if(!m_bIdle || m_bRedraw){
+    RenderFrame(); //render a frame of animation
+    m_bRedraw = false;
+  } //if
+
+  else WaitForChange(); //nothing to draw until the next second
 } //ProcessFrame
\ No newline at end of file
@@ -4,11 +4,15 @@
 #ifndef __L4RC_GAME_GAME_H__
 #define __L4RC_GAME_GAME_H__
 
+#include <chrono>
+
 #include "Component.h"
 #include "Settings.h"
 #include "SpriteDesc.h"
 #include "SpriteRenderer.h"
 #include "EventTimer.h"
+#include "Dashboard.h"
+#include "HandTable.h"
 
 /// \brief The game class.
 ///
@@ -25,16 +29,35 @@ class CGame:
 
   private:
     bool m_bDrawFrameRate = false; ///< Draw the frame rate.
-    float m_fPrevTicks = 0.0f; ///< Time of previous tick.
+    bool m_bIdle = false; ///< Render only when the clock changes.
+    bool m_bRedraw = true; ///< Render the next frame even if the clock hasn't changed.
+    bool m_bSweep = false; ///< Sweep the second hand smoothly instead of ticking.
+    bool m_bDashboard = false; ///< Draw the dashboard instead of the single clock.
     LSpriteRenderer* m_pRenderer = nullptr; ///< Pointer to renderer.
+
+    time_t m_nTime = 0; ///< Time that the cached date string and hands are for.
+    std::string m_strDate; ///< Cached date and time string.
+    Vector2 m_vHandEnd[3]; ///< Cached ends of hands, indexed by `ClockHand`.
+
+    CHandTable m_cHandTable; ///< Hand directions for the sweep second hand.
+    float m_fSweepBase = 0.0f; ///< Seconds past the minute at `m_tSweepBase`.
+    std::chrono::steady_clock::time_point m_tSweepBase; ///< Monotonic time of `m_fSweepBase`.
+    std::string m_strBench; ///< Result of the last hand geometry benchmark.
+    CDashboard m_cDashboard; ///< Dashboard of data center clocks.
     
     void LoadImages(); ///< Load images.
     void LoadSounds(); ///< Load sounds.
     void KeyboardHandler(); ///< The keyboard handler.
+    void UpdateTime(time_t); ///< Update cached date string and hands.
+    void WaitForChange() const; ///< Block until the clock changes.
+    void SetSweepBase(const std::chrono::system_clock::time_point&); ///< Set sweep base time.
+    const float GetSweepSeconds() const; ///< Get seconds past the minute.
+    void RunBench(); ///< Time the hand geometry.
     void RenderFrame(); ///< Render an animation frame.
     void DrawFrameRateText(); ///< Draw frame rate text to screen.
-    void RenderDateAndTime(time_t); ///< Render date and time.
-    void RenderClockHands(time_t); ///< Render clock hands.
+    void DrawBenchText(); ///< Draw benchmark result to screen.
+    void RenderDateAndTime(); ///< Render date and time.
+    void RenderClockHands(); ///< Render clock hands.
     void RenderArrowhead(const Vector2&); ///< Render arrowhead on a hand.
     Vector2 GetHandEnd(float, float) const; ///< Get position of end of hand.
 
@@ -0,0 +1,31 @@
+/// \file HandTable.cpp
+/// \brief Code for the hand direction table class CHandTable.
+
+#include <algorithm>
+
+#include "HandTable.h"
+
+/// Fill the table with the direction of a hand at each of `HANDTABLE_SIZE`
+/// evenly spaced times, using the same angle as `CGame::GetHandEnd()`.
+
+CHandTable::CHandTable(){
+  for(UINT i=0; i<=HANDTABLE_SIZE; i++){
+    const float theta = XM_PIDIV2 - i*XM_2PI/HANDTABLE_SIZE; //rotation angle
+    m_vDir[i] = Vector2(cosf(theta), sinf(theta));
+  } //for
+} //constructor
+
+/// Get the direction of a hand by linear interpolation between the two
+/// table entries on either side of it.
+/// \param t Time in units of 1/60 of a full rotation, may be fractional.
+/// \return Direction of hand, very nearly a unit vector.
+
+const Vector2 CHandTable::GetDirection(float t) const{
+  float f = t*(HANDTABLE_SIZE/60.0f); //fractional table index
+  f -= HANDTABLE_SIZE*floorf(f*(1.0f/HANDTABLE_SIZE)); //wrap to one rotation
+
+  const UINT i = std::min((UINT)f, HANDTABLE_SIZE - 1); //entry before
+  const float s = f - i; //fraction of the way to the entry after
+
+  return (1.0f - s)*m_vDir[i] + s*m_vDir[i + 1];
+} //GetDirection
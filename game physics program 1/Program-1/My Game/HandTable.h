@@ -0,0 +1,31 @@
+/// \file HandTable.h
+/// \brief Interface for the hand direction table class CHandTable.
+
+#ifndef __L4RC_GAME_HANDTABLE_H__
+#define __L4RC_GAME_HANDTABLE_H__
+
+#include "GameDefines.h"
+
+const UINT HANDTABLE_SIZE = 3600; ///< Number of directions in a full rotation.
+
+/// \brief Hand direction table.
+///
+/// Unit vectors pointing along a clock hand at `HANDTABLE_SIZE` evenly
+/// spaced times around the dial, starting at 12 o'clock and going clockwise,
+/// computed once with `cos()` and `sin()` in the constructor. The direction
+/// at any other time is found by linear interpolation between the two
+/// nearest entries. With 3600 entries they are a tenth of a degree apart,
+/// and the interpolated vector is shorter than a unit vector by less than
+/// one part in a million, which is far less than a pixel on a clock hand.
+
+class CHandTable{
+  private:
+    Vector2 m_vDir[HANDTABLE_SIZE + 1]; ///< Directions, the last one repeating the first.
+
+  public:
+    CHandTable(); ///< Constructor.
+
+    const Vector2 GetDirection(float) const; ///< Get direction of hand.
+}; //CHandTable
+
+#endif //__L4RC_GAME_HANDTABLE_H__
@@ -0,0 +1,248 @@
+/// \file BallBatch.cpp
+/// \brief Code for the ball batch class CBallBatch.
+
+#include <DirectXMath.h>
+
+#include "BallBatch.h"
+
+/// Get one ball's lane of an array of four-ball vectors.
+/// \param v Array of four-ball vectors.
+/// \param i Ball index.
+/// \return Reference to the ball's lane.
+
+static float& Lane(std::vector<XMFLOAT4>& v, UINT i){
+  return (&v[i/4].x)[i%4];
+} //Lane
+
+/// Get one ball's lane of an array of four-ball vectors.
+/// \param v Array of four-ball vectors.
+/// \param i Ball index.
+/// \return The ball's lane.
+
+static float Lane(const std::vector<XMFLOAT4>& v, UINT i){
+  return (&v[i/4].x)[i%4];
+} //Lane
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Load and store functions.
+
+/// Load balls into the batch, padding it out to a whole number of
+/// four-ball vectors with balls that are in a pocket.
+/// \param balls Balls.
+
+void CBallBatch::Load(const std::vector<CPoolBall>& balls){
+  m_nBalls = (UINT)balls.size();
+  const size_t n = (m_nBalls + 3)/4; //number of four-ball vectors
+
+  m_stdX.resize(n);
+  m_stdY.resize(n);
+  m_stdVelX.resize(n);
+  m_stdVelY.resize(n);
+  m_stdRadius.resize(n);
+  m_stdInPocket.resize(n);
+
+  for(UINT i=0; i<4*n; i++){
+    const bool pad = i >= m_nBalls; //whether this is padding
+
+    Lane(m_stdX, i) = pad? 0.0f: balls[i].m_vPos.x;
+    Lane(m_stdY, i) = pad? 0.0f: balls[i].m_vPos.y;
+    Lane(m_stdVelX, i) = pad? 0.0f: balls[i].m_vVel.x;
+    Lane(m_stdVelY, i) = pad? 0.0f: balls[i].m_vVel.y;
+    Lane(m_stdRadius, i) = pad? 0.0f: balls[i].m_fRadius;
+    Lane(m_stdInPocket, i) = pad || balls[i].m_bInPocket? 1.0f: 0.0f;
+  } //for
+} //Load
+
+/// Store the balls back out of the batch, without the padding.
+/// \param balls [out] Balls, which must be the ones that were loaded.
+
+void CBallBatch::Store(std::vector<CPoolBall>& balls) const{
+  for(UINT i=0; i<m_nBalls; i++){
+    CPoolBall& b = balls[i]; //shorthand
+
+    b.m_vPos = Vector2(Lane(m_stdX, i), Lane(m_stdY, i));
+    b.m_vVel = Vector2(Lane(m_stdVelX, i), Lane(m_stdVelY, i));
+    b.m_bInPocket = Lane(m_stdInPocket, i) != 0.0f;
+  } //for
+} //Store
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Collision functions.
+
+/// Collision response for all balls against the pockets and then the rails.
+/// Pockets go first so that balls that go in are ignored by the rails.
+/// \param t Table.
+
+void CBallBatch::Collide(const CPoolTable& t){
+  m_stdEvent.clear();
+  PocketCollide(t);
+  RailCollide(t);
+} //Collide
+
+/// Collision response for all balls against the pockets. A ball goes into a
+/// corner pocket when its center is within one and a half radii of both
+/// cushions, and into a center pocket when it is within one and a half radii
+/// of a long cushion and three quarters of a radius of the middle of it. The
+/// tests are done four balls at a time. A ball that goes in is stopped and
+/// put in the pocket, and a pocket event is recorded with the position and
+/// speed that it went in with.
+/// \param t Table.
+
+void CBallBatch::PocketCollide(const CPoolTable& t){
+  const XMVECTOR left = XMVectorReplicate(t.m_fLeft);
+  const XMVECTOR right = XMVectorReplicate(t.m_fRight);
+  const XMVECTOR bottom = XMVectorReplicate(t.m_fBottom);
+  const XMVECTOR top = XMVectorReplicate(t.m_fTop);
+  const XMVECTOR middle = XMVectorReplicate((t.m_fLeft + t.m_fRight)/2.0f);
+  const XMVECTOR zero = XMVectorZero();
+
+  for(UINT k=0; k<m_stdX.size(); k++){
+    const XMVECTOR x = XMLoadFloat4(&m_stdX[k]);
+    const XMVECTOR y = XMLoadFloat4(&m_stdY[k]);
+    const XMVECTOR hpw = XMVectorScale(XMLoadFloat4(&m_stdRadius[k]), 1.5f); //half pocket width
+
+    const XMVECTOR topband = XMVectorGreater(y, XMVectorSubtract(top, hpw));
+    const XMVECTOR botband = XMVectorLess(y, XMVectorAdd(bottom, hpw));
+    const XMVECTOR leftband = XMVectorLess(x, XMVectorAdd(left, hpw));
+    const XMVECTOR rightband = XMVectorGreater(x, XMVectorSubtract(right, hpw));
+    const XMVECTOR midband = XMVectorLess(XMVectorAbs(XMVectorSubtract(x, middle)),
+      XMVectorScale(hpw, 0.5f));
+
+    XMVECTOR in = XMVectorAndInt(XMVectorOrInt(topband, botband),
+      XMVectorOrInt(XMVectorOrInt(leftband, rightband), midband)); //mouth of a pocket
+    in = XMVectorAndCInt(in, XMVectorGreater(XMLoadFloat4(&m_stdInPocket[k]), zero));
+
+    if(XMVector4EqualInt(in, zero))continue; //the usual case
+
+    XMFLOAT4 hit; //1 for balls that go in, otherwise 0
+    XMStoreFloat4(&hit, XMVectorSelect(zero, XMVectorSplatOne(), in));
+
+    for(UINT j=0; j<4; j++){
+      if((&hit.x)[j] == 0.0f)continue;
+
+      const UINT i = 4*k + j; //ball index
+      const float px = Lane(m_stdX, i); //shorthand
+      const float hpw = 1.5f*Lane(m_stdRadius, i); //half pocket width
+
+      const UINT row = Lane(m_stdY, i) > t.m_fTop - hpw? 0: 3; //first pocket in row
+      const UINT col = px < t.m_fLeft + hpw? 0: px > t.m_fRight - hpw? 2: 1; //column
+
+      CPoolEvent e;
+      e.m_eType = ePoolEvent::Pocket;
+      e.m_nBall = i;
+      e.m_nOther = row + col;
+      e.m_vPos = Vector2(px, Lane(m_stdY, i));
+      e.m_fSpeed = Vector2(Lane(m_stdVelX, i), Lane(m_stdVelY, i)).Length();
+      m_stdEvent.push_back(e);
+
+      Lane(m_stdX, i) = t.m_vPocket[e.m_nOther].x;
+      Lane(m_stdY, i) = t.m_vPocket[e.m_nOther].y;
+      Lane(m_stdVelX, i) = Lane(m_stdVelY, i) = 0.0f;
+      Lane(m_stdInPocket, i) = 1.0f;
+    } //for
+  } //for
+} //PocketCollide
+
+/// Collision response for all balls against the rails, four balls at a time.
+/// A ball whose center has gone past where it would touch a rail is mirrored
+/// back across that position, and the component of its velocity normal to
+/// the rail is reversed and multiplied by `POOL_RESTITUTION`. Both happen
+/// for both axes at once, which takes care of a ball that has gone into a
+/// corner. A rail event is recorded with where the ball was when it hit,
+/// found by going back along its velocity, and its speed after bouncing.
+/// \param t Table.
+
+void CBallBatch::RailCollide(const CPoolTable& t){
+  const XMVECTOR left = XMVectorReplicate(t.m_fLeft);
+  const XMVECTOR right = XMVectorReplicate(t.m_fRight);
+  const XMVECTOR bottom = XMVectorReplicate(t.m_fBottom);
+  const XMVECTOR top = XMVectorReplicate(t.m_fTop);
+  const XMVECTOR zero = XMVectorZero();
+
+  for(UINT k=0; k<m_stdX.size(); k++){
+    const XMVECTOR x = XMLoadFloat4(&m_stdX[k]);
+    const XMVECTOR y = XMLoadFloat4(&m_stdY[k]);
+    const XMVECTOR r = XMLoadFloat4(&m_stdRadius[k]);
+    const XMVECTOR out = XMVectorGreater(XMLoadFloat4(&m_stdInPocket[k]), zero); //in a pocket
+
+    //ball center at rail collision for each of the 4 rails
+
+    const XMVECTOR LEFT = XMVectorAdd(left, r);
+    const XMVECTOR RIGHT = XMVectorSubtract(right, r);
+    const XMVECTOR BOTTOM = XMVectorAdd(bottom, r);
+    const XMVECTOR TOP = XMVectorSubtract(top, r);
+
+    const XMVECTOR hitleft = XMVectorLess(x, LEFT);
+    const XMVECTOR hitbot = XMVectorLess(y, BOTTOM);
+    const XMVECTOR hitx = XMVectorAndCInt(XMVectorOrInt(hitleft, XMVectorGreater(x, RIGHT)), out);
+    const XMVECTOR hity = XMVectorAndCInt(XMVectorOrInt(hitbot, XMVectorGreater(y, TOP)), out);
+
+    if(XMVector4EqualInt(XMVectorOrInt(hitx, hity), zero))continue; //the usual case
+
+    //position after bounce is twice the position at collision minus the position
+
+    const XMVECTOR xr = XMVectorSubtract(XMVectorScale(XMVectorSelect(RIGHT, LEFT, hitleft), 2.0f), x);
+    const XMVECTOR yr = XMVectorSubtract(XMVectorScale(XMVectorSelect(TOP, BOTTOM, hitbot), 2.0f), y);
+
+    //flip ball velocity and slow down
+
+    const XMVECTOR vx = XMLoadFloat4(&m_stdVelX[k]);
+    const XMVECTOR vy = XMLoadFloat4(&m_stdVelY[k]);
+    const XMVECTOR vxr = XMVectorScale(vx, -POOL_RESTITUTION);
+    const XMVECTOR vyr = XMVectorScale(vy, -POOL_RESTITUTION);
+
+    //record the events before the balls are overwritten
+
+    XMFLOAT4 fx, fy; //1 for balls that hit a vertical or horizontal rail, otherwise 0
+    XMStoreFloat4(&fx, XMVectorSelect(zero, XMVectorSplatOne(), hitx));
+    XMStoreFloat4(&fy, XMVectorSelect(zero, XMVectorSplatOne(), hity));
+
+    for(UINT j=0; j<4; j++){
+      const bool bHitX = (&fx.x)[j] != 0.0f; //hit a vertical rail
+      const bool bHitY = (&fy.x)[j] != 0.0f; //hit a horizontal rail
+      if(!bHitX && !bHitY)continue;
+
+      const UINT i = 4*k + j; //ball index
+      const float rad = Lane(m_stdRadius, i); //radius
+      const Vector2 p(Lane(m_stdX, i), Lane(m_stdY, i)); //position
+      const Vector2 v(Lane(m_stdVelX, i), Lane(m_stdVelY, i)); //velocity
+
+      CPoolEvent e;
+      e.m_eType = ePoolEvent::Rail;
+      e.m_nBall = i;
+
+      if(bHitX){ //vertical rail
+        e.m_nOther = p.x < t.m_fLeft + rad? 0: 1;
+        const float wall = e.m_nOther == 0? t.m_fLeft + rad: t.m_fRight - rad; //center at collision
+        e.m_vPos = Vector2(wall, v.x == 0.0f? p.y: p.y - v.y*(p.x - wall)/v.x); //position at TOI
+      } //if
+
+      else{ //horizontal rail
+        e.m_nOther = p.y < t.m_fBottom + rad? 2: 3;
+        const float wall = e.m_nOther == 2? t.m_fBottom + rad: t.m_fTop - rad; //center at collision
+        e.m_vPos = Vector2(v.y == 0.0f? p.x: p.x - v.x*(p.y - wall)/v.y, wall); //position at TOI
+      } //else
+
+      const float sx = bHitX? -POOL_RESTITUTION: 1.0f; //velocity scale
+      const float sy = bHitY? -POOL_RESTITUTION: 1.0f; //velocity scale
+      e.m_fSpeed = Vector2(sx*v.x, sy*v.y).Length();
+      m_stdEvent.push_back(e);
+    } //for
+
+    XMStoreFloat4(&m_stdX[k], XMVectorSelect(x, xr, hitx));
+    XMStoreFloat4(&m_stdY[k], XMVectorSelect(y, yr, hity));
+    XMStoreFloat4(&m_stdVelX[k], XMVectorSelect(vx, vxr, hitx));
+    XMStoreFloat4(&m_stdVelY[k], XMVectorSelect(vy, vyr, hity));
+  } //for
+} //RailCollide
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Reader functions.
+
+/// Reader function for the events from the last call to `Collide()`, pocket
+/// events first and then rail events, each in order of ball index.
+/// \return Reference to the events.
+
+const std::vector<CPoolEvent>& CBallBatch::GetEvents() const{
+  return m_stdEvent;
+} //GetEvents
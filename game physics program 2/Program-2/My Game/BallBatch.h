@@ -0,0 +1,50 @@
+/// \file BallBatch.h
+/// \brief Interface for the ball batch class CBallBatch.
+
+#ifndef __L4RC_GAME_BALLBATCH_H__
+#define __L4RC_GAME_BALLBATCH_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+#include "PoolSim.h"
+
+/// \brief Ball batch.
+///
+/// The positions, velocities, and radii of all balls in structure of arrays
+/// form, four balls to an `XMFLOAT4`, so that rail and pocket collisions can
+/// be done for four balls at a time with DirectXMath, which compiles to SSE
+/// or NEON. Rail reflection is branchless: a ball that has gone through a
+/// rail is mirrored back across it and its velocity is flipped and scaled by
+/// `POOL_RESTITUTION` by selecting between the reflected and unreflected
+/// lanes with a comparison mask. The pocket mouths are tested the same way.
+/// The only branches are one per four balls to skip the ones that hit
+/// nothing, which is nearly all of them, and the scalar code that records
+/// the rail-hit and pocketed events for the sounds and particles. The
+/// number of balls is padded to a multiple of four with balls that are
+/// in a pocket.
+
+class CBallBatch{
+  private:
+    std::vector<XMFLOAT4> m_stdX; ///< Position x coordinates.
+    std::vector<XMFLOAT4> m_stdY; ///< Position y coordinates.
+    std::vector<XMFLOAT4> m_stdVelX; ///< Velocity x coordinates.
+    std::vector<XMFLOAT4> m_stdVelY; ///< Velocity y coordinates.
+    std::vector<XMFLOAT4> m_stdRadius; ///< Radii.
+    std::vector<XMFLOAT4> m_stdInPocket; ///< 1 if in a pocket, otherwise 0.
+
+    std::vector<CPoolEvent> m_stdEvent; ///< Events from the last collision.
+    UINT m_nBalls = 0; ///< Number of balls, not counting padding.
+
+    void PocketCollide(const CPoolTable&); ///< Collision response for balls with pockets.
+    void RailCollide(const CPoolTable&); ///< Collision response for balls with rails.
+
+  public:
+    void Load(const std::vector<CPoolBall>&); ///< Load balls.
+    void Store(std::vector<CPoolBall>&) const; ///< Store balls.
+    void Collide(const CPoolTable&); ///< Collision response for balls with pockets and rails.
+
+    const std::vector<CPoolEvent>& GetEvents() const; ///< Get the last collision's events.
+}; //CBallBatch
+
+#endif //__L4RC_GAME_BALLBATCH_H__
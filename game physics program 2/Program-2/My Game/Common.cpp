@@ -13,6 +13,8 @@ LParticleEngine2D* CCommon::m_pParticleEngine = nullptr;
 bool CCommon::m_bShowCollisions = false; //testing stuff
 bool CCommon::m_bStepMode = false;
 bool CCommon::m_bStep = false;
+bool CCommon::m_bFullRack = false;
+bool CCommon::m_bEventDriven = true;
 
 float CCommon::m_fXMargin = 78.0f;
 float CCommon::m_fYMargin = 64.0f;
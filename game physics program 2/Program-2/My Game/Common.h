@@ -30,6 +30,8 @@ class CCommon{
     static bool m_bShowCollisions; ///< Show ball positions at TOI.
     static bool m_bStepMode; ///< Is in step mode.
     static bool m_bStep; ///< Step flag.
+    static bool m_bFullRack; ///< Whether to play with a full rack instead of just the 8-ball.
+    static bool m_bEventDriven; ///< Whether to move balls with the event-driven simulator.
 
     static float m_fXMargin; ///< Horizontal margin.
     static float m_fYMargin; ///< Vertical margin.
@@ -0,0 +1,106 @@
+/// \file FrameSolver.cpp
+/// \brief Code for the frame solver class CFrameSolver.
+
+#include <algorithm>
+#include <cfloat>
+
+#include "FrameSolver.h"
+
+/// Move balls by a frame, resolving every event in the frame in order of
+/// time of impact, as long as there are no more than `SOLVER_MAXITERATIONS`
+/// of them. If there are more, the balls are left where they are at the
+/// last event resolved, with their real velocities at that time, and the
+/// rest of the frame is left to the caller.
+/// \param table Table.
+/// \param balls [in, out] Balls.
+/// \param dt Frame time in seconds.
+/// \return Time left in the frame in seconds, 0 unless it ran out of iterations.
+
+float CFrameSolver::Solve(const CPoolTable& table, std::vector<CPoolBall>& balls, float dt){
+  m_stdEvent.clear();
+  m_nIterations = 0;
+
+  const UINT n = (UINT)balls.size(); //number of balls
+  const float tend = CPoolSim::GetPathTime(dt); //path time at end of frame
+  float t = 0.0f; //path time
+  bool done = false; //whether there are no more events in the frame
+
+  while(!done && m_nIterations < SOLVER_MAXITERATIONS){
+    const float speed = 1.0f - POOL_FRICTION*t/POOL_SCALE; //speed factor
+    const float vmin = POOL_MINCLOSING/speed; //minimum closing speed in path time
+
+    float tmin = FLT_MAX; //time until earliest event
+    ePoolEvent type = ePoolEvent::Stop; //earliest event type
+    UINT bi = 0, bj = 0; //earliest event ball and other ball, rail, or pocket
+
+    auto earliest = [&](float s, ePoolEvent e, UINT i, UINT j){ //keep if earliest
+      if(s < tmin){
+        tmin = s;
+        type = e;
+        bi = i;
+        bj = j;
+      } //if
+    }; //earliest
+
+    for(UINT i=0; i<n; i++){
+      const CPoolBall& b = balls[i]; //shorthand
+      if(b.m_bInPocket)continue;
+
+      if(b.m_vVel != Vector2::Zero){
+        UINT rail = 0, pocket = 0; //rail hit and pocket gone into
+        const float trail = CPoolSim::GetRailTime(b, table, rail); //time until rail
+        const float tpocket = CPoolSim::GetPocketTime(b, table, pocket); //time until pocket
+
+        earliest(trail, ePoolEvent::Rail, i, rail);
+        earliest(tpocket, ePoolEvent::Pocket, i, pocket);
+
+        const float tstop = CPoolSim::GetPathTime(CPoolSim::GetStopTime(b.m_vVel.Length())); //path time of stop
+        earliest(std::max(tstop - t, 0.0f), ePoolEvent::Stop, i, 0);
+      } //if
+
+      for(UINT j=i + 1; j<n; j++)
+        earliest(CPoolSim::GetPairTime(b, balls[j], vmin), ePoolEvent::Ball, i, j);
+    } //for
+
+    done = t + tmin > tend; //earliest event is after the end of the frame
+
+    if(!done){
+      for(CPoolBall& b: balls)
+        b.m_vPos += tmin*b.m_vVel;
+
+      t += tmin;
+      m_stdEvent.push_back(CPoolSim::Collide(balls, table, type, bi, bj,
+        1.0f - POOL_FRICTION*t/POOL_SCALE));
+      m_nIterations++;
+    } //if
+  } //while
+
+  if(done) //move to end of frame
+    for(CPoolBall& b: balls)
+      b.m_vPos += (tend - t)*b.m_vVel;
+
+  const float s = done? expf(-POOL_FRICTION*dt): 1.0f - POOL_FRICTION*t/POOL_SCALE; //speed factor
+
+  for(CPoolBall& b: balls)
+    b.m_vVel *= s; //real velocity
+
+  return done? 0.0f: std::max(dt - CPoolSim::GetRealTime(t), 0.0f);
+} //Solve
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Reader functions.
+
+/// Reader function for the number of events resolved in the last frame.
+/// \return Number of events, at most SOLVER_MAXITERATIONS.
+
+const UINT CFrameSolver::GetIterations() const{
+  return m_nIterations;
+} //GetIterations
+
+/// Reader function for the events from the last frame, in the order that
+/// they happened.
+/// \return Reference to the events.
+
+const std::vector<CPoolEvent>& CFrameSolver::GetEvents() const{
+  return m_stdEvent;
+} //GetEvents
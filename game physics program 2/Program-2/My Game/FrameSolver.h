@@ -0,0 +1,38 @@
+/// \file FrameSolver.h
+/// \brief Interface for the frame solver class CFrameSolver.
+
+#ifndef __L4RC_GAME_FRAMESOLVER_H__
+#define __L4RC_GAME_FRAMESOLVER_H__
+
+#include <vector>
+
+#include "PoolSim.h"
+
+const UINT SOLVER_MAXITERATIONS = 128; ///< Maximum number of events resolved per frame.
+
+/// \brief Frame solver.
+///
+/// Moves the balls a frame at a time, resolving the collisions within the
+/// frame in the order that they happen. Each iteration finds the earliest
+/// time of impact among all ball-ball, ball-rail, and ball-pocket events and
+/// balls stopping in what is left of the frame, moves every ball to it,
+/// resolves it, and goes again until the frame is used up. Unlike `CPoolSim`,
+/// nothing is kept from one frame to the next, so every iteration costs a
+/// pass over all pairs of balls, and the number of iterations per frame is
+/// capped at `SOLVER_MAXITERATIONS`. The times of impact and the collision
+/// response are the ones in `CPoolSim`, in path time with velocities scaled
+/// to the start of the frame, so friction doesn't bend the paths.
+
+class CFrameSolver{
+  private:
+    std::vector<CPoolEvent> m_stdEvent; ///< Events from the last frame.
+    UINT m_nIterations = 0; ///< Number of events resolved in the last frame.
+
+  public:
+    float Solve(const CPoolTable&, std::vector<CPoolBall>&, float); ///< Move balls by a frame.
+
+    const UINT GetIterations() const; ///< Get number of events resolved in the last frame.
+    const std::vector<CPoolEvent>& GetEvents() const; ///< Get the last frame's events.
+}; //CFrameSolver
+
+#endif //__L4RC_GAME_FRAMESOLVER_H__
@@ -64,15 +64,19 @@ void CGame::Release(){
   SAFE_DELETE(m_pRenderer); 
 } //Release
 
-/// Ask the object manager to create the game objects. This game has only two
-/// objects, the 8-ball and the cue-ball.  This function creates them and sets
-/// the impulse vector to point from the cue-ball to the 8-ball.
+/// Ask the object manager to create the game objects. The end game has only
+/// two objects, the 8-ball and the cue-ball, and a full rack has 15 object
+/// balls with the 8-ball among them. This function creates them and sets
+/// the impulse vector to point from the cue-ball to the nearest object ball.
 
 void CGame::CreateObjects(){
   const float mid = m_nWinHeight/2.0f; //half window height
 
-  Vector2 v = Vector2(732.0f, mid); //initial 8-ball position
-  m_pObjectManager->create(eSprite::Eightball, v); //create 8-ball
+  Vector2 v = Vector2(732.0f, mid); //initial 8-ball position, or apex of rack
+
+  if(m_bFullRack)
+    m_pObjectManager->CreateRack(v); //create 15 balls
+  else m_pObjectManager->create(eSprite::Eightball, v); //create 8-ball
 
   v = Vector2(295.0f, mid); //initial cue-ball position
   m_pObjectManager->create(eSprite::Cueball, v); //create cue-ball
@@ -114,6 +118,7 @@ void CGame::KeyboardHandler(){
     m_bStepMode = !m_bStepMode; 
     m_bStep = false; //note: if not in step mode, this doesn't matter
     m_pParticleEngine->clear(); 
+    m_pObjectManager->ClearTrajectories();
     if(m_bStepMode)m_bShowCollisions = false;
   } //if
 
@@ -122,6 +127,15 @@ void CGame::KeyboardHandler(){
     if(m_bShowCollisions)m_bStepMode = false;
   } //if
 
+  if(m_pKeyboard->TriggerDown(VK_F5)){ //toggle full rack and restart
+    m_bFullRack = !m_bFullRack;
+    m_pParticleEngine->clear(); 
+    BeginGame();
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F6)) //toggle event-driven simulation
+    m_bEventDriven = !m_bEventDriven;
+
   switch(m_eGameState){
     case eGameState::Initial:  //initial state, can move cue-ball on base line
       if(m_pKeyboard->Down(VK_UP)){  
@@ -154,6 +168,12 @@ void CGame::KeyboardHandler(){
         m_eGameState = eGameState::InMotion; //change state
         m_bStep = true; //in case we are in Step Mode
       } //if
+
+      else if(m_pKeyboard->TriggerDown(VK_F8)){ //let the computer shoot
+        m_pObjectManager->AutoShoot(); //choose shot and deliver impulse to ball
+        m_eGameState = eGameState::InMotion; //change state
+        m_bStep = true; //in case we are in Step Mode
+      } //else if
     break;
 
     case eGameState::Won:
@@ -165,6 +185,9 @@ void CGame::KeyboardHandler(){
     case eGameState::InMotion: //we might be in Step Mode, so...
       if(m_pKeyboard->TriggerDown(VK_SPACE))
         m_bStep = true;
+
+      if(m_pKeyboard->TriggerDown(VK_F7)) //skip to end of shot
+        m_pObjectManager->FastForward();
     break;
   } //switch
 } //KeyboardHandler
@@ -210,10 +233,11 @@ void CGame::ProcessState(){
       else if(m_pObjectManager->AllStopped()){ //all balls have stopped
         m_pParticleEngine->clear(1.0f); 
 
-        if(m_pObjectManager->BallDown()){ //if a ball went down, it must be the 8-ball 
-          m_eGameState = eGameState::Won; //player has won
+        if(m_pObjectManager->EightBallDown()){ //8-ball is down
+          const bool won = m_pObjectManager->BallsLeft() == 0; //it has to be the last
+          m_eGameState = won? eGameState::Won: eGameState::Lost; 
           m_fGameStateTime = m_pTimer->GetTime(); //set state timer
-          m_pAudio->play(eSound::Win); //applause
+          m_pAudio->play(won? eSound::Win: eSound::Lose); //applause or boo
         } //if
 
         else{       
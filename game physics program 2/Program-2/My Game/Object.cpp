@@ -4,6 +4,7 @@
 #include "Object.h"
 #include "ComponentIncludes.h"
 #include "ParticleEngine.h"
+#include "PoolSim.h"
 
 /// Create an object, given its sprite type and initial position.
 /// \param t Type of ball.
@@ -17,9 +18,11 @@ CObject::CObject(eSprite t, const Vector2& pos):
   m_fRadius = m_pRenderer->GetWidth(m_nSpriteIndex)/2.0f;
 } //constructor
 
-/// Move using Euler Integration, applying a constant amount of friction. Stop
-/// if the velocity is sufficiently small. Exactly what constitutes
-/// "sufficiently small" is hard-coded.
+/// Move with friction that slows the ball by the same factor every second,
+/// using the closed form for its position and velocity instead of Euler
+/// integration so that the result doesn't depend on the frame time. Stop
+/// exactly when the velocity becomes sufficiently small. The constants and
+/// formulas are shared with `CPoolSim` so that both ways of moving balls agree.
 
 void CObject::move(){ 
   if(m_bInPocket){ //in pocket, so draw smaller and darker
@@ -29,17 +32,14 @@ void CObject::move(){
 
   else{ //in play on table
     const float t = m_bStepMode? (m_bStep? 1/30.0f: 0): m_pTimer->GetFrameTime();
-    const float SCALE = 50.0f; //to scale up motion
-    const float FRICTION = 0.6f; //coefficient of friction
+    const float tstop = CPoolSim::GetStopTime(m_vVel.Length()); //time until it stops
 
     m_vOldPos = m_vPos; //current position is now the old one
-    m_vPos += m_vVel*t*SCALE; //new current position
-    m_vVel *= 1.0f - t*FRICTION; //apply friction
+    m_vPos += m_vVel*CPoolSim::GetPathTime(std::min(t, tstop)); //new current position
 
-    const float MINSPEEDSQ = 0.5f; //minimum speed squared
-
-    if(m_vVel.LengthSquared() < MINSPEEDSQ) //if moving too slowly
-      m_vVel = Vector2::Zero; //stop
+    if(t < tstop) //still moving at end of frame
+      m_vVel *= expf(-t*POOL_FRICTION); //apply friction
+    else m_vVel = Vector2::Zero; //stop
   } //else
 } //move
 
@@ -54,17 +54,6 @@ void CObject::draw(){
   m_pRenderer->Draw(this);
 } //draw
 
-/// Drop a particle using the back particle engine provided the object has
-/// actually moved in the last frame. This is intended to be used in Step Mode.
-
-void CObject::DropParticle(LParticleDesc2D* p){
-  if(m_vPos != m_vOldPos){ //don't drop two particles in the same place
-    p->m_vPos = m_vOldPos; 
-    m_pParticleEngine->create(*p);
-    m_vOldPos = m_vPos; //this ball is forbidden from drawing another particle here
-  } //if
-} //DropParticle
-
 /// React to an impulse of a given angle and magnitude. The velocity vector is
 /// instantaneously changed; no need to faff about with forces applied over time.
 /// \param a Impulse angle.
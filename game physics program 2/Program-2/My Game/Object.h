@@ -38,7 +38,6 @@ class CObject:
     void move(); ///< Move object.
     void draw(); ///< Draw object.
 
-    void DropParticle(LParticleDesc2D*); ///< Drop a particle.
     void DeliverImpulse(float, float); ///< Deliver an impulse.
 }; //CObject
 
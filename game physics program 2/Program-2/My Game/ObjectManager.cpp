@@ -1,63 +1,106 @@
 /// \file ObjectManager.cpp
 /// \brief Code for the object manager class CObjectManager.
 
+#include <cfloat>
+
 #include "ObjectManager.h"
 
 #include "ComponentIncludes.h"
 #include "ParticleEngine.h"
 
 CObjectManager::CObjectManager(){
-  m_cPDesc0.m_nSpriteIndex = (int)eSprite::Circle;
-  m_cPDesc0.m_fLifeSpan = 15.0f;
-  m_cPDesc0.m_fFadeOutFrac = 0.2f;
-
-  m_cPDesc1.m_nSpriteIndex = (int)eSprite::Thickcircle;
-  m_cPDesc1.m_f4Tint = (XMFLOAT4)Colors::Yellow;
-  m_cPDesc1.m_fLifeSpan = 15.0f;
-  m_cPDesc1.m_fFadeOutFrac = 0.2f;
-  
   m_cPDesc2.m_nSpriteIndex = (int)eSprite::Thickcircle;
   m_cPDesc2.m_f4Tint = (XMFLOAT4)Colors::Yellow; 
   m_cPDesc2.m_fLifeSpan = 2.0f;
   m_cPDesc2.m_fScaleOutFrac = 0.1f;
-
-  m_cPDesc3.m_nSpriteIndex = (int)eSprite::Circle;
-  m_cPDesc3.m_fLifeSpan = 0.02f;
 } //constructor
 
 CObjectManager::~CObjectManager(){
-  delete m_pCueBall; //delete the cue ball
-  delete m_p8Ball; //delete the 8 ball
+  clear(); //delete the balls
 } //destructor
 
-/// Create an object and put a pointer to it on the object list.
+/// Create an object and put a pointer to it on the ball list.
 /// \param t Sprite type.
 /// \param v Initial position.
+/// \return Pointer to the object created.
 
-void CObjectManager::create(eSprite t, const Vector2& v){
-  const float r = m_pRenderer->GetWidth((int)t)/2.0f; //ball radius
+CObject* CObjectManager::create(eSprite t, const Vector2& v){
   CObject* b = new CObject(t, v); //conjure a ball
+  m_stdBalls.push_back(b);
 
-  if(t == eSprite::Cueball) 
+  if(t == eSprite::Cueball && m_pCueBall == nullptr) 
     m_pCueBall = b; //save cue-ball pointer
 
   else if(t == eSprite::Eightball)
     m_p8Ball = b; //save 8-ball pointer  
+
+  m_bSimLoaded = false; //simulator needs the new ball
+  m_cShotPredictor.Invalidate(); //and so does the shot predictor
+  return b;
 } //create
 
+/// Create a triangular rack of 15 object balls, pointing left, with the 8-ball
+/// in the middle of the third row. The other balls are the cue-ball sprite
+/// tinted in the colors of the solids and stripes. They are spaced a pixel
+/// apart so that none of them start out touching. Since `create()` takes the
+/// first cue-ball sprite to be the cue-ball, the cue-ball pointer is cleared
+/// afterwards, and the cue-ball must be created after the rack.
+/// \param v Position of the ball at the apex.
+
+void CObjectManager::CreateRack(const Vector2& v){
+  const XMVECTORF32 color[7] = {
+    Colors::Gold, Colors::Blue, Colors::Red, Colors::Purple,
+    Colors::Orange, Colors::Green, Colors::Maroon
+  }; //colors of the balls other than the 8-ball
+
+  const float r = m_pRenderer->GetWidth(eSprite::Cueball)/2.0f; //ball radius
+  const float dy = 2.0f*r + 1.0f; //distance between balls in a row
+  const float dx = dy*sqrtf(3.0f)/2.0f; //distance between rows
+  UINT n = 0; //number of balls other than the 8-ball created so far
+
+  for(UINT row=0; row<5; row++)
+    for(UINT i=0; i<=row; i++){
+      const Vector2 pos = v + Vector2(row*dx, (i - row/2.0f)*dy); //ball position
+
+      if(row == 2 && i == 1)
+        create(eSprite::Eightball, pos);
+
+      else{
+        CObject* b = create(eSprite::Cueball, pos);
+        b->m_f4Tint = XMFLOAT4(color[n++%7]);
+      } //else
+    } //for
+
+  m_pCueBall = nullptr; //none of these is the cue-ball
+} //CreateRack
+
 /// Delete all of the objects in the game. 
 
 void CObjectManager::clear(){
-  delete m_pCueBall; //delete the cue ball
-  delete m_p8Ball; //delete the 8 ball
+  for(CObject* b: m_stdBalls)
+    delete b;
+
+  m_stdBalls.clear();
+  m_pCueBall = m_p8Ball = nullptr;
+  m_bSimLoaded = false;
+  m_cShotPredictor.Invalidate();
+  m_cTrajectory.Clear(0);
 } //clear
 
-/// Draw all of the objects in the game, two balls, the directional arrow, and
-/// the step mode indicator if necessary.
+/// Throw away the trajectories recorded in step mode.
+
+void CObjectManager::ClearTrajectories(){
+  m_cTrajectory.Clear((UINT)m_stdBalls.size());
+} //ClearTrajectories
+
+/// Draw all of the objects in the game, the balls, the directional arrow, the
+/// predicted shot, and the step mode indicator and trajectories if necessary.
 
 void CObjectManager::Draw(){
-  if(m_bStepMode) //draw step mode indicator
-    m_pRenderer->Draw(eSprite::Stepmode, Vector2(120.0f, 120.0f));
+  if(m_bStepMode){ 
+    m_pRenderer->Draw(eSprite::Stepmode, Vector2(120.0f, 120.0f)); //draw step mode indicator
+    DrawTrajectories();
+  } //if
   
   if(m_bShowCollisions){
     LSpriteDesc2D desc;
@@ -73,42 +116,57 @@ void CObjectManager::Draw(){
     m_pRenderer->Draw(eSprite::Arrow, m_pCueBall->m_vPos + dv, m_fCueAngle);
   } //if
 
-  // this is probably where to put the new code
-  if (m_bDrawCircle) {
-      float vol = 0.0;
-      MimicBallCollide(m_p8Ball, m_pCueBall, vol);
-  }
+  if(m_bDrawCircle)
+    DrawPrediction(); //draw predicted paths of cue ball and object ball
 
-  m_pCueBall->draw(); //draw cue-ball
-  m_p8Ball->draw(); //draw 8-ball
+  for(CObject* b: m_stdBalls)
+    b->draw(); //draw ball
 } //Draw
 
-/// Move all of the objects in the object list and perform broad phase 
-/// collision detection and response. If in Step Mode, drop a particle.
+/// Move all of the objects in the object list, either with the event-driven
+/// simulator or one frame at a time with the frame solver. If in Step Mode,
+/// record where the balls that moved have got to.
 
 void CObjectManager::move(){
-  m_p8Ball->move(); //move 8-ball
-  m_pCueBall->move(); //move cue-ball
+  if(m_bEventDriven)
+    PoolSimMove(); //move balls from event to event
 
-  BroadPhase(); //broad phase collision detection and response
+  else{
+    m_bSimLoaded = false; //simulator will need reloading if switched back on
+    FrameSolverMove(); //move balls a frame at a time
+  } //else
   
-  if(m_bStepMode){
-    m_cPDesc0.m_f4Tint = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
-    m_p8Ball->DropParticle(&m_cPDesc0);
+  if(m_bStepMode && m_bStep)
+    for(UINT i=0; i<m_stdBalls.size(); i++){
+      const CObject* b = m_stdBalls[i]; //shorthand
 
-    m_cPDesc0.m_f4Tint = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0);
-    m_pCueBall->DropParticle(&m_cPDesc0);
-  } //if
+      if(!b->m_bInPocket && b->m_vPos != b->m_vOldPos)
+        m_cTrajectory.Add(i, b->m_vPos);
+    } //for
 } //move
 
-/// Make the impulse vector point from the center of the cue-ball  to the center
-/// of the 8-ball and set it as visible so it gets drawn (assuming that the only
-/// reason to reset the impulse vector is because it needs to be drawn).
+/// Make the impulse vector point from the center of the cue-ball to the center
+/// of the nearest object ball that is still on the table and set it as visible
+/// so it gets drawn (assuming that the only reason to reset the impulse vector
+/// is because it needs to be drawn).
 
 void CObjectManager::ResetImpulseVector(){
   m_bDrawImpulseVector = true;
   m_bDrawCircle = true;
-  const Vector2 v = m_p8Ball->m_vPos - m_pCueBall->m_vPos; //difference in positions
+
+  Vector2 v = m_p8Ball->m_vPos - m_pCueBall->m_vPos; //difference in positions
+  float dsq = FLT_MAX; //distance squared to nearest ball
+
+  for(CObject* b: m_stdBalls)
+    if(b != m_pCueBall && !b->m_bInPocket){
+      const Vector2 u = b->m_vPos - m_pCueBall->m_vPos; //difference in positions
+
+      if(u.LengthSquared() < dsq){
+        v = u;
+        dsq = u.LengthSquared();
+      } //if
+    } //if
+
   m_fCueAngle = atan2f(v.y, v.x);
 } //ResetImpulseVector
 
@@ -131,20 +189,44 @@ void CObjectManager::AdjustCueBall(float d){
     float& y = m_pCueBall->m_vPos.y; //shorthand
     y += d; //move it vertically  
     y = (std::max)((std::min)(y, m_nWinHeight - r), r); //clamp between top and bottom of the table
+    m_bSimLoaded = false; //simulator needs the new position
   } //if
 } //AdjustCueBall
 
-/// Shoot the cue-ball by giving it a fixed impulse. Disable the drawing of the
+/// Shoot the cue-ball by giving it an impulse. Disable the drawing of the
 /// impulse vector and play a sound that is panned left or right depending on
 /// where the cue-ball is on the table.
+/// \param m Impulse magnitude.
 
-void CObjectManager::Shoot(){
-  m_pCueBall->DeliverImpulse(m_fCueAngle, 30.0f); //deliver impulse to cue-ball
+void CObjectManager::Shoot(float m){
+  m_pCueBall->DeliverImpulse(m_fCueAngle, m); //deliver impulse to cue-ball
   m_pAudio->play(eSound::Cue, m_pCueBall->m_vPos); //play sound of cue hitting ball
   m_bDrawImpulseVector = false; //turn off the impulse vector arrow
   m_bDrawCircle = false; //turn off target circle
+  m_bSimLoaded = false; //simulator needs the new velocity
+  m_cShotPredictor.Invalidate(); //balls are going to move
+
+  if(m_bStepMode) //start a new polyline for each ball on the table
+    for(UINT i=0; i<m_stdBalls.size(); i++)
+      if(!m_stdBalls[i]->m_bInPocket)
+        m_cTrajectory.Add(i, m_stdBalls[i]->m_vPos, TRAJECTORY_BREAK);
 } //Shoot
 
+/// Let the computer player search for a shot, turn the cue to it, and shoot.
+/// The search tries random shots on all cores for at most `SEARCH_DEADLINE`
+/// seconds and takes the best one. Each search starts its random numbers
+/// where the last one's could have ended, so that it tries different shots.
+
+void CObjectManager::AutoShoot(){
+  GetPoolBalls();
+  m_cShotSearch.Search(GetPoolTable(), m_stdPoolBalls, GetIndex(m_pCueBall), GetIndex(m_p8Ball), 
+    SEARCH_SHOTS, SEARCH_DEADLINE, 0, SEARCH_SHOTS*m_nAutoShots++);
+
+  const CShotCandidate& c = m_cShotSearch.GetBest(); //shorthand
+  m_fCueAngle = c.m_fAngle;
+  Shoot(c.m_fImpulse);
+} //AutoShoot
+
 /// Check whether the cue-ball or the 8-ball is in a pocket.
 /// \return true If one of the balls is in a pocket.
 
@@ -159,14 +241,43 @@ bool CObjectManager::CueBallDown(){
   return m_pCueBall->m_bInPocket;
 } //CueBallDown
 
-/// Check whether both the cue-ball and the 8-ball have stopped moving. Notice
-/// that we can set the velocity vector to the zero vector and expect it to
-/// succeed because CObject::move zeros out the velocity of slow-moving objects.
-/// \return true If both balls have stopped moving.
+/// Check whether the 8-ball is down a pocket.
+/// \return true If the 8-ball is in a pocket.
+
+bool CObjectManager::EightBallDown(){
+  return m_p8Ball->m_bInPocket;
+} //EightBallDown
+
+/// Count the object balls other than the 8-ball that are still on the table.
+/// The 8-ball must be the last of these to go down.
+/// \return Number of balls other than the cue-ball and 8-ball not in a pocket.
+
+UINT CObjectManager::BallsLeft(){
+  UINT n = 0; //number of balls
+
+  for(CObject* b: m_stdBalls)
+    if(b != m_pCueBall && b != m_p8Ball && !b->m_bInPocket)
+      n++;
+
+  return n;
+} //BallsLeft
+
+/// Check whether all balls have stopped moving. The event-driven simulator
+/// keeps count of the balls moving, so ask it if it has the current balls.
+/// Otherwise, notice that we can compare the velocity vector to the zero
+/// vector and expect it to succeed because CObject::move zeros out the
+/// velocity of slow-moving objects.
+/// \return true If all balls have stopped moving.
 
 bool CObjectManager::AllStopped(){
-  return m_p8Ball->m_vVel == Vector2::Zero &&
-       m_pCueBall->m_vVel == Vector2::Zero;
+  if(m_bEventDriven && m_bSimLoaded)
+    return m_cPoolSim.IsStopped();
+
+  for(CObject* b: m_stdBalls)
+    if(b->m_vVel != Vector2::Zero)
+      return false;
+
+  return true;
 } //AllStopped
 
 /// Begin by computing velocities relative to b1. Calculate the relative
@@ -204,11 +315,6 @@ bool CObjectManager::BallCollide(CObject* p0, CObject* p1, float& s){
   const Vector2 c = b0Pos - b1Pos; //vector from b1 to b0
   const float cdotvhat = c.Dot(vhat); //relative distance along normal to tangent
 
-  // draw circle at dot product of vhat every frame and see what happens (cdotvhat * vhat)
-  //Vector2 temp = vhat.Dot(cdotvhat);
-  //m_cPDesc0.m_vPos = c;
-  //m_pParticleEngine->create(m_cPDesc0);
-
   //step 3
   float d; //distance moved back by b1 to position at TOI
   const float delta = cdotvhat*cdotvhat - c.LengthSquared() + r*r; //discriminant
@@ -224,33 +330,10 @@ bool CObjectManager::BallCollide(CObject* p0, CObject* p1, float& s){
   b0Pos -= tdelta*b0Vel; 
   b1Pos -= tdelta*b1Vel; 
 
-  //drop particles at TOI when in step mode
+  //mark positions at TOI when in step mode or collision mode
 
-  if(m_bStepMode){
-    m_cPDesc1.m_vPos = b0Pos; 
-    m_pParticleEngine->create(m_cPDesc1); //first ball
-
-    m_cPDesc1.m_vPos = b1Pos; 
-    m_pParticleEngine->create(m_cPDesc1); //second ball
-  } //if
-
-  // this looks usefull
-  else if(m_bShowCollisions){       
-    m_cPDesc2.m_vPos = b0Pos; 
-    m_pParticleEngine->create(m_cPDesc2); 
-
-    m_cPDesc2.m_vPos = b1Pos; 
-    m_pParticleEngine->create(m_cPDesc2); 
-  } //if
-
-  // FIX ME this is supposed to only draw the circle where the balls will collide, but instead it does it after they collide
-  /*if (!m_bDrawCircle) {
-      m_cPDesc0.m_vPos = b0Pos;
-      m_pParticleEngine->create(m_cPDesc0);
-
-      m_cPDesc0.m_vPos = b1Pos;
-      m_pParticleEngine->create(m_cPDesc0);
-  }*/
+  DropMarker(GetIndex(p0), b0Pos); //first ball
+  DropMarker(GetIndex(p1), b1Pos); //second ball
 
   //compute new velocities after impact
 
@@ -271,262 +354,314 @@ bool CObjectManager::BallCollide(CObject* p0, CObject* p1, float& s){
   return true;
 } //BallCollide
 
-bool CObjectManager::MimicBallCollide(CObject* p0, CObject* p1, float& s) {
-    Vector2& b0Pos = p0->m_vPos;
-    Vector2& b0Vel = p0->m_vVel;
-
-    Vector2& b1Pos = p1->m_vPos;
-    Vector2& b1Vel = 30.0f * Vector2(cosf(m_fCueAngle), sinf(m_fCueAngle));
-
-    const float r = p0->m_fRadius + p1->m_fRadius + 1.0f;
-
-    const Vector2 v = b1Vel - b0Vel; //relative velocity
-    const float speed = v.Length(); //relative speed
-    if (speed == 0.0f)return false; //bail
-
-    //step 2
-    Vector2 vhat; //normalized version of v
-    v.Normalize(vhat); //normalize v into vhat
-
-    //calculate relative displacement and distance along normal to common tangent
-
-    //step 1
-    const Vector2 c = b0Pos - b1Pos; //vector from b1 to b0
-    const float cdotvhat = c.Dot(vhat); //relative distance along normal to tangent
-
-    // draw circle at dot product of vhat every frame and see what happens (cdotvhat * vhat)
-    //Vector2 temp = c.Dot(vhat);
-    //m_cPDesc0.m_vPos = (vhat * cdotvhat);
-    //m_pParticleEngine->create(m_cPDesc0);
-
-    /*m_cPDesc0.m_vPos = b1Pos;
-    m_pParticleEngine->create(m_cPDesc0);*/
-
-    //step 3
-    float d; //distance moved back by b1 to position at TOI
-    const float delta = cdotvhat * cdotvhat - c.LengthSquared() + r * r; //discriminant
-    if (delta >= 0.0f) //guard against taking the square root of a negative number
-        d = -cdotvhat + sqrtf(delta); //collision really did occur
-    else return false; //fail, no collision, function should not have been called
-
-    //step 4
-    const float tdelta = d / speed; //time elapsed since time of impact
-
-    //move balls back to position at TOI 
-    Vector2 targetPos = b1Pos;
-
-    /*b0Pos -= tdelta * b0Vel;
-    b1Pos -= tdelta * b1Vel;*/
-    targetPos -= tdelta * b1Vel;
-
-    //drop particles at TOI when in step mode
-
-
-    if (m_bDrawCircle) {
-        /*m_cPDesc0.m_vPos = b0Pos;
-        m_pParticleEngine->create(m_cPDesc0);*/
-
-        m_cPDesc3.m_vPos = targetPos;
-        m_pParticleEngine->create(m_cPDesc3);
-    } //if
-
-    return true;
-} //MimicBallCollide
-
-/// Collision detection and response for ball hitting any rail. Check for a
-/// collision and do the necessary housework for reflecting the ball if it hits
-/// a rail. If there is a collision, a sound is played at a volume proportional
-/// to the speed of collision and panned to the left or right according to
-/// where the collision occurred.
-/// \param b Pointer to a ball object to collide with rails.
-
-void CObjectManager::RailCollide(CObject* b){ 
-  if(b->m_bInPocket)return;
-
-  const float r = b->m_fRadius; //ball radius
-  
-  //ball center at rail collision for each of the 4 rails
-  const float TOP = m_nWinHeight - m_fYMargin - r;
-  const float BOTTOM = m_fYMargin + r;
-  const float LEFT = m_fXMargin + r;
-  const float RIGHT = m_nWinWidth - m_fXMargin - r;
-
-  Vector2& p = b->m_vPos; //ball position
-  Vector2& v = b->m_vVel; //ball velocity
-
-  const bool bHitY = p.y > TOP || p.y < BOTTOM; //hit a horizontal rail
-  const bool bHitX = p.x < LEFT || p.x > RIGHT; //hit a vertical rail
-  const bool bHit = bHitY || bHitX; //hit a rail
-
-  Vector2 POI = Vector2::Zero; //point of impact
+/// Collision response for all balls against each other and the rails and the
+/// pockets by looking for overlaps, for when the frame solver has run out of
+/// iterations. The rails and pockets are done for all balls at once by the ball
+/// batch, pockets first to remove balls from the subsequent calculations, and
+/// then the sounds and particles for what happened are dealt with.
 
-  //correct ball position
+void CObjectManager::BroadPhase(){
+  //ball to pocket and ball to rail collision
+  GetPoolBalls();
+  m_cBallBatch.Load(m_stdPoolBalls);
+  m_cBallBatch.Collide(GetPoolTable());
+  m_cBallBatch.Store(m_stdPoolBalls);
+  SetPoolBalls();
+  ProcessPoolEvents(m_cBallBatch.GetEvents());
+
+  //ball to ball collision for every pair of balls
+  const size_t n = m_stdBalls.size(); //number of balls
+
+  for(size_t i=0; i<n; i++)
+    for(size_t j=i + 1; j<n; j++){
+      CObject* b0 = m_stdBalls[i]; //shorthand
+      CObject* b1 = m_stdBalls[j]; //shorthand
+
+      if(!b0->m_bInPocket && !b1->m_bInPocket){
+        Vector2 v = b0->m_vPos - b1->m_vPos; //position difference
+        const float d = b0->m_fRadius + b1->m_fRadius; //separation distance
+        if(v.LengthSquared() < d*d) //if close enough, then they collide
+          NarrowPhase(b0, b1);
+      } //if
+    } //for
+} //BroadPhase
 
-  if(p.x < LEFT){ //left rail
-    m_cPDesc1.m_vPos = Vector2(LEFT, p.y - v.y*(p.x - LEFT)/v.x); //position at time of impact
-    POI = m_cPDesc1.m_vPos - Vector2(r, 0.0f); //point of impact
-    p.x = 2.0f*LEFT - p.x; //position after bounce
-  } //if
+/// Perform collision detection and response for a pair of objects.
+/// Play impact sound if they collide.
+/// \param p0 Pointer to the first object.
+/// \param p1 Pointer to the second object.
 
-  else if(p.x > RIGHT){ //right rail
-    m_cPDesc1.m_vPos = Vector2(RIGHT, p.y - v.y*(p.x - RIGHT)/v.x); //position at TOI  
-    POI = m_cPDesc1.m_vPos + Vector2(r, 0.0f); //point of impact
-    p.x = 2.0f*RIGHT - p.x; //position after bounce
-  } //else if
+void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
+  float vol; //impact sound volume
+  const bool hit = BallCollide(p0, p1, vol);
+  vol = std::min(vol/50.0f, 1.0f);
 
-  else if(p.y > TOP){ //top rail
-    m_cPDesc1.m_vPos = Vector2(p.x - v.x*(p.y - TOP)/v.y, TOP); //position at TOI
-    POI = m_cPDesc1.m_vPos + Vector2(0.0f, r); //point of impact
-    p.y = 2.0f*TOP - p.y; //position after bounce
-  } //else if
- 
-  else if(p.y < BOTTOM){ //bottom rail
-    m_cPDesc1.m_vPos = Vector2(p.x - v.x*(p.y - BOTTOM)/v.y, BOTTOM); //position at TOI
-    POI = m_cPDesc1.m_vPos - Vector2(0.0f, r); //point of impact
-    p.y = 2.0f*BOTTOM - p.y; //position after bounce
+  if(hit) //if there was a collision
+    m_pAudio->play(eSound::Click, p0->m_vPos, vol); 
+} //NarrowPhase
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Event-driven simulation functions.
+
+/// Get the cushions and pockets for the event-driven simulator.
+/// \return The table.
+
+const CPoolTable CObjectManager::GetPoolTable() const{
+  CPoolTable t;
+  t.m_fLeft = m_fXMargin;
+  t.m_fRight = m_nWinWidth - m_fXMargin;
+  t.m_fBottom = m_fYMargin;
+  t.m_fTop = m_nWinHeight - m_fYMargin;
+
+  t.m_vPocket[0] = m_vTopLPocket;
+  t.m_vPocket[1] = m_vTopCPocket;
+  t.m_vPocket[2] = m_vTopRPocket;
+  t.m_vPocket[3] = m_vBotLPocket;
+  t.m_vPocket[4] = m_vBotCPocket;
+  t.m_vPocket[5] = m_vBotRPocket;
+
+  return t;
+} //GetPoolTable
+
+/// Copy the current positions and velocities of all balls into
+/// `m_stdPoolBalls`, in the same order as `m_stdBalls`.
+
+void CObjectManager::GetPoolBalls(){
+  m_stdPoolBalls.resize(m_stdBalls.size());
+
+  for(size_t i=0; i<m_stdBalls.size(); i++){
+    const CObject* b = m_stdBalls[i]; //shorthand
+    CPoolBall& ball = m_stdPoolBalls[i]; //shorthand
+
+    ball.m_vPos = b->m_vPos;
+    ball.m_vVel = b->m_vVel;
+    ball.m_fRadius = b->m_fRadius;
+    ball.m_bInPocket = b->m_bInPocket;
+  } //for
+} //GetPoolBalls
+
+/// Copy the positions and velocities of all balls, and whether they are in a
+/// pocket, back out of `m_stdPoolBalls`, which must be in the same order as
+/// `m_stdBalls`.
+
+void CObjectManager::SetPoolBalls(){
+  for(size_t i=0; i<m_stdBalls.size(); i++){
+    CObject* b = m_stdBalls[i]; //shorthand
+    const CPoolBall& ball = m_stdPoolBalls[i]; //shorthand
+
+    b->m_vPos = ball.m_vPos;
+    b->m_vVel = ball.m_vVel;
+    b->m_bInPocket = ball.m_bInPocket;
+
+    if(b->m_bInPocket)
+      b->move(); //only makes it look like it's in a pocket
+  } //for
+} //SetPoolBalls
+
+/// Load the table and the current positions and velocities of all balls
+/// into the event-driven simulator.
+
+void CObjectManager::LoadPoolSim(){
+  GetPoolBalls();
+  m_cPoolSim.SetTable(GetPoolTable());
+  m_cPoolSim.Begin(m_stdPoolBalls);
+  m_bSimLoaded = true;
+} //LoadPoolSim
+
+/// Advance the event-driven simulator by one frame, or by 1/30th of a second
+/// per step in Step Mode, copy the balls back out of it, and deal with
+/// anything that happened on the way.
+
+void CObjectManager::PoolSimMove(){
+  if(!m_bSimLoaded)
+    LoadPoolSim();
+
+  const float t = m_bStepMode? (m_bStep? 1/30.0f: 0): m_pTimer->GetFrameTime();
+  if(t == 0.0f)return; //nothing to do
+
+  m_cPoolSim.Advance(t);
+  ReadPoolSim();
+  ProcessPoolEvents(m_cPoolSim.GetEvents());
+} //PoolSimMove
+
+/// Copy the positions and velocities of all balls out of the event-driven
+/// simulator, and whether they are in a pocket.
+
+void CObjectManager::ReadPoolSim(){
+  for(UINT i=0; i<m_cPoolSim.GetNumBalls(); i++){
+    const CPoolBall ball = m_cPoolSim.GetBall(i);
+    CObject* b = m_stdBalls[i]; //shorthand
+
+    b->m_vOldPos = b->m_vPos; //current position is now the old one
+    b->m_vPos = ball.m_vPos;
+    b->m_vVel = ball.m_vVel;
+    b->m_bInPocket = ball.m_bInPocket;
+
+    if(b->m_bInPocket)
+      b->move(); //only makes it look like it's in a pocket
+  } //for
+} //ReadPoolSim
+
+/// Move all balls by one frame, or by 1/30th of a second per step in Step
+/// Mode, with the frame solver, which resolves the collisions in the frame in
+/// the order that they happen. If there are too many of them, the balls are
+/// moved the rest of the way as if there were nothing in their way, and then
+/// collisions are found the old way, by looking for overlaps.
+
+void CObjectManager::FrameSolverMove(){
+  const float t = m_bStepMode? (m_bStep? 1/30.0f: 0): m_pTimer->GetFrameTime();
+  if(t == 0.0f)return; //nothing to do
+
+  GetPoolBalls();
+  const float left = m_cFrameSolver.Solve(GetPoolTable(), m_stdPoolBalls, t); //time not solved
+
+  if(left > 0.0f) //ran out of iterations
+    for(CPoolBall& ball: m_stdPoolBalls)
+      ball = CPoolSim::Coast(ball, left);
+
+  for(CObject* b: m_stdBalls)
+    b->m_vOldPos = b->m_vPos; //current position is now the old one
+
+  SetPoolBalls();
+  ProcessPoolEvents(m_cFrameSolver.GetEvents());
+
+  if(left > 0.0f) //ran out of iterations
+    BroadPhase(); //broad phase collision detection and response
+} //FrameSolverMove
+
+/// Skip to the end of a shot by running the event-driven simulator until all
+/// balls stop, which takes time proportional to the number of collisions,
+/// not to the length of the shot. No sounds are played and no particles are
+/// dropped. This does nothing if the balls aren't moved by the simulator.
+
+void CObjectManager::FastForward(){
+  if(!m_bEventDriven)return;
+
+  if(!m_bSimLoaded)
+    LoadPoolSim();
+
+  m_cPoolSim.RunToRest();
+  ReadPoolSim();
+} //FastForward
+
+/// Mark where a ball was at a collision. In Step Mode this is recorded in
+/// the ball's trajectory, and in Collision Mode a particle is dropped there.
+/// \param i Ball index.
+/// \param pos Position of ball.
+
+void CObjectManager::DropMarker(UINT i, const Vector2& pos){
+  if(m_bStepMode)
+    m_cTrajectory.Add(i, pos, TRAJECTORY_MARKER);
+      
+  else if(m_bShowCollisions){       
+    m_cPDesc2.m_vPos = pos;
+    m_pParticleEngine->create(m_cPDesc2); 
   } //else if
-
-  //flip ball velocity and slow down
-  const float RESTITUTION = 0.8f; //how bouncy the rails are
-
-  if(bHitY) //horizontal rail
-    v.y = -RESTITUTION*v.y;
-
-  if(bHitX) //vertical rail
-    v.x = -RESTITUTION*v.x;
-
-  if(bHit){ //hit processing
-    const float vol = std::min(v.Length()/10.0f, 1.0f); //volume
-    m_pAudio->play(eSound::Thump, p, vol);
-    
-    if(m_bStepMode)
-      m_pParticleEngine->create(m_cPDesc1); //thick circle at position at TOI 
-
-    else if(m_bShowCollisions){       
-      m_cPDesc2.m_vPos = m_cPDesc1.m_vPos; 
-      m_pParticleEngine->create(m_cPDesc2); 
-    } //if
+} //DropMarker
+
+/// Play the sounds and drop the particles for some pool events, either the
+/// last frame's events from the event-driven simulator or the rail and pocket
+/// events from the ball batch. Ball events get the same sound as BallCollide.
+/// \param events Pool events.
+
+void CObjectManager::ProcessPoolEvents(const std::vector<CPoolEvent>& events){
+  for(const CPoolEvent& e: events){
+    switch(e.m_eType){
+      case ePoolEvent::Ball:
+        m_pAudio->play(eSound::Click, e.m_vPos, std::min(e.m_fSpeed/50.0f, 1.0f));
+        DropMarker(e.m_nBall, e.m_vPos);
+        DropMarker(e.m_nOther, e.m_vOtherPos);
+      break;
+
+      case ePoolEvent::Rail:
+        m_pAudio->play(eSound::Thump, e.m_vPos, std::min(e.m_fSpeed/10.0f, 1.0f));
+        DropMarker(e.m_nBall, e.m_vPos);
+      break;
+
+      case ePoolEvent::Pocket: {
+        const float vol = std::min(std::max(0.2f, e.m_fSpeed/20.0f), 1.0f); //volume
+        m_pAudio->play(eSound::Pocket, m_stdBalls[e.m_nBall]->m_vPos, vol);
+        DropMarker(e.m_nBall, e.m_vPos);
+      } //case
+      break;
+
+      default: break; //nothing to hear or see when a ball stops
+    } //switch
+  } //for
+} //ProcessPoolEvents
+
+/// Draw the predicted paths of the cue ball, in white, and the first object
+/// ball that it will hit, in yellow, with a circle where the cue ball will be
+/// when it hits. The shot predictor only recomputes the paths when the cue
+/// angle or the cue ball has moved.
+
+void CObjectManager::DrawPrediction(){
+  if(!m_cShotPredictor.IsCurrent(m_fCueAngle, m_pCueBall->m_vPos)){
+    const UINT cue = GetIndex(m_pCueBall); //index of cue ball
+
+    GetPoolBalls();
+    m_cShotPredictor.Predict(GetPoolTable(), m_stdPoolBalls, cue, m_fCueAngle);
   } //if
-} //RailCollide
-
-/// Collision and response for ball-in-pocket. Check for a collision and
-/// does the necessary housework for disabling a ball that is in a pocket.
-/// If there is a collision, a sound is played at a volume proportional to the
-/// speed of collision and panned to the left or right according to where the 
-/// pocket is on the table. 
-/// \param b Pointer to a ball object to collide with pockets.
-
-void CObjectManager::PocketCollide(CObject* b){ 
-  if(b->m_bInPocket)return; //ignore balls already in pockets
-
-  const float pw = 3.0f*b->m_fRadius; //pocket width 
-  const float hpw = pw/2.0f; //half of that
-
-  //ball center at rail collision for each of the 4 rails
-  const float TOP = m_nWinHeight - m_fYMargin - hpw;
-  const float BOTTOM = m_fYMargin + hpw;
-  const float LEFT = m_fXMargin + hpw;
-  const float RIGHT = m_nWinWidth - m_fXMargin - hpw;
-
-  Vector2& vVel = b->m_vVel;
-  bool& bInPocket = b->m_bInPocket;
 
-  //pocket collision calculation
+  const std::vector<Vector2>& cuepath = m_cShotPredictor.GetCuePath(); //shorthand
+  const std::vector<Vector2>& objpath = m_cShotPredictor.GetObjectPath(); //shorthand
 
-  const Vector2 pos = b->m_vPos; //save current position
-  float& x = b->m_vPos.x; //shorthand
-  float& y = b->m_vPos.y; //shorthand
+  for(size_t i=1; i<cuepath.size(); i++)
+    m_pRenderer->DrawLine(cuepath[i - 1], cuepath[i], Colors::White);
 
-  //top of table
+  for(size_t i=1; i<objpath.size(); i++)
+    m_pRenderer->DrawLine(objpath[i - 1], objpath[i], Colors::Yellow);
 
-  if(y > TOP){
-    if(x < LEFT){ //top left corner
-      bInPocket = true;
-      b->m_vPos = m_vTopLPocket;
-    } //if 
+  if(m_cShotPredictor.GetObject() != UINT_MAX)
+    m_pRenderer->Draw(eSprite::Circle, m_cShotPredictor.GetContact());
+} //DrawPrediction
 
-    else if(fabs(x - m_nWinWidth/2) < hpw/2.0f){ //top center corner
-      bInPocket = true;
-      b->m_vPos = m_vTopCPocket;
-    } //else if
+/// Draw the trajectories recorded in Step Mode as one polyline per ball for
+/// each shot, white for the cue ball and black for the others, and then a
+/// thick yellow circle where each ball was at each collision, so that the
+/// sprite batch only switches sprites once.
 
-    else if(x > RIGHT){ //top right corner
-      bInPocket = true;
-      b->m_vPos = m_vTopRPocket;
-    } //else if
-  } //if
-
-  //bottom of table
+void CObjectManager::DrawTrajectories(){
+  const UINT n = std::min(m_cTrajectory.GetNumBalls(), (UINT)m_stdBalls.size()); //number of balls
 
-  else if(y < BOTTOM){
-    if(x < LEFT){ //bottom left corner
-      bInPocket = true;
-      b->m_vPos = m_vBotLPocket;
-    } //if 
+  for(UINT i=0; i<n; i++){
+    const XMVECTORF32 c = m_stdBalls[i] == m_pCueBall? Colors::White: Colors::Black; //color
+    m_stdPolyline.clear();
 
-    else if(fabs(x - m_nWinWidth/2) < hpw/2.0f){ //bottom center corner
-      bInPocket = true;
-      b->m_vPos = m_vBotCPocket;
-    } //else if
-
-    else if(x > RIGHT){ //bottom right corner
-      bInPocket = true;
-      b->m_vPos = m_vBotRPocket;
-    } //else if
-  } //else if
+    for(UINT k=0; k<m_cTrajectory.GetCount(i); k++){
+      const CTrajectorySample& s = m_cTrajectory.GetSample(i, k); //shorthand
 
-  //respond to a collision with the pocket: 
-  //stop the ball, play a sound, drop a collision indicator particle
+      if(s.m_nFlags & TRAJECTORY_BREAK){ //start a new polyline
+        m_pRenderer->DrawPolyline(m_stdPolyline, c);
+        m_stdPolyline.clear();
+      } //if
 
-  if(bInPocket){ 
-    const float vol = std::min(std::max(0.2f, vVel.Length()/20.0f), 1.0f); //volume
-    m_pAudio->play(eSound::Pocket, b->m_vPos, vol);
-    vVel = Vector2::Zero; //stop the ball
+      m_stdPolyline.push_back(s.m_vPos);
+    } //for
 
-    if(m_bStepMode){
-      m_cPDesc1.m_vPos = pos; //draw at saved position
-      m_pParticleEngine->create(m_cPDesc1); 
-    } //if
-      
-    else if(m_bShowCollisions){       
-      m_cPDesc2.m_vPos = pos; //draw at saved position
-      m_pParticleEngine->create(m_cPDesc2); 
-    } //else if
-  } //if
-} //PocketCollide
+    m_pRenderer->DrawPolyline(m_stdPolyline, c);
+  } //for
 
-/// Collision response for all balls against each other and the rails and the
-/// pockets. We do pocket collision for all balls first to remove them from the
-/// subsequent calculations.
+  LSpriteDesc2D desc; //collision marker
+  desc.m_nSpriteIndex = (UINT)eSprite::Thickcircle;
+  desc.m_f4Tint = (XMFLOAT4)Colors::Yellow;
 
-void CObjectManager::BroadPhase(){
-  //ball to pocket collision
-  PocketCollide(m_p8Ball); 
-  PocketCollide(m_pCueBall); 
-
-  //ball to rail collision
-  RailCollide(m_p8Ball);
-  RailCollide(m_pCueBall); 
-
-  //ball to ball collision for just 2 balls
-  if(!m_p8Ball->m_bInPocket && !m_pCueBall->m_bInPocket){
-    Vector2 v = m_p8Ball->m_vPos - m_pCueBall->m_vPos; //position difference
-    const float d = m_p8Ball->m_fRadius + m_pCueBall->m_fRadius; //separation dist ance
-    if(v.LengthSquared() < d*d) //if close enough, then they collide
-      NarrowPhase(m_p8Ball, m_pCueBall);
-  } //if
-} //BroadPhase
+  for(UINT i=0; i<n; i++)
+    for(UINT k=0; k<m_cTrajectory.GetCount(i); k++){
+      const CTrajectorySample& s = m_cTrajectory.GetSample(i, k); //shorthand
 
-/// Perform collision detection and response for a pair of objects.
-/// Play impact sound if they collide.
-/// \param p0 Pointer to the first object.
-/// \param p1 Pointer to the second object.
+      if(s.m_nFlags & TRAJECTORY_MARKER){
+        desc.m_vPos = s.m_vPos;
+        m_pRenderer->Draw(&desc);
+      } //if
+    } //for
+} //DrawTrajectories
 
-void CObjectManager::NarrowPhase(CObject* p0, CObject* p1){
-  float vol; //impact sound volume
-  const bool hit = BallCollide(p0, p1, vol);
-  vol = std::min(vol/50.0f, 1.0f);
+/// Get the index of a ball in the ball list, which is also its index in the
+/// simulator, the shot predictor, the shot search, and the trajectories.
+/// \param p Pointer to a ball.
+/// \return Index of the ball.
 
-  if(hit) //if there was a collision
-    m_pAudio->play(eSound::Click, p0->m_vPos, vol); 
-} //NarrowPhase
\ No newline at end of file
+UINT CObjectManager::GetIndex(const CObject* p) const{
+  return UINT(std::find(m_stdBalls.begin(), m_stdBalls.end(), p) - m_stdBalls.begin());
+} //GetIndex
@@ -4,11 +4,19 @@
 #ifndef __L4RC_GAME_OBJECTMANAGER_H__
 #define __L4RC_GAME_OBJECTMANAGER_H__
 
+#include <vector>
+
 #include "GameDefines.h"
 
 #include "BaseObjectManager.h"
 #include "Object.h"
 #include "Common.h"
+#include "PoolSim.h"
+#include "BallBatch.h"
+#include "FrameSolver.h"
+#include "ShotPredictor.h"
+#include "ShotSearch.h"
+#include "Trajectory.h"
 
 /// \brief The object manager.
 ///
@@ -19,35 +27,59 @@ class CObjectManager:
   public CCommon
 {
   private:
-    LParticleDesc2D m_cPDesc0; ///< Particle descriptor for balls in step mode.
-    LParticleDesc2D m_cPDesc1; ///< Particle descriptor for collisions in step mode.
     LParticleDesc2D m_cPDesc2; ///< Particle descriptor for collisions in real-time mode.
-    LParticleDesc2D m_cPDesc3; ///< Particle descriptor for target ball
 
     CObject* m_pCueBall = nullptr; ///< Cue ball object pointer.
     CObject* m_p8Ball = nullptr; ///< 8 ball object pointer.
+    std::vector<CObject*> m_stdBalls; ///< All balls, including the cue ball and the 8 ball.
+
+    CPoolSim m_cPoolSim; ///< Event-driven simulator.
+    bool m_bSimLoaded = false; ///< Whether the simulator has the current balls.
+    std::vector<CPoolBall> m_stdPoolBalls; ///< Balls for the simulator, reused to save allocations.
+    CBallBatch m_cBallBatch; ///< Rail and pocket collisions for all balls at once.
+    CFrameSolver m_cFrameSolver; ///< Resolves collisions in order a frame at a time.
+
+    CShotPredictor m_cShotPredictor; ///< Predicts the shot for the aiming line.
+    CShotSearch m_cShotSearch; ///< Computer player.
+    UINT m_nAutoShots = 0; ///< Number of shots taken by the computer player.
+
+    CTrajectory m_cTrajectory; ///< Ball trajectories in step mode.
+    std::vector<Vector2> m_stdPolyline; ///< Polyline for drawing trajectories, reused to save allocations.
 
     float m_fCueAngle = 0; ///< Cue ball impulse angle.
     bool m_bDrawImpulseVector = true; ///< Whether to draw the impulse vector.
 
-    bool m_bDrawCircle = true; // new addition
+    bool m_bDrawCircle = true; ///< Whether to draw the predicted shot.
     
   private:
     void BroadPhase(); ///< Ball, rail, and pocket collision response for all balls.
     void NarrowPhase(CObject*, CObject*); ///< Ball collision response for two balls.
 
     bool BallCollide(CObject*, CObject*, float&); ///< Ball collision response for two balls.
-    bool MimicBallCollide(CObject*, CObject*, float&); ///< for predicting a collision
-    void RailCollide(CObject*); ///< Collision response for ball with rail.
-    void PocketCollide(CObject*); ///< Collision response for ball with pocket.
+
+    const CPoolTable GetPoolTable() const; ///< Get the table for the simulator.
+    void GetPoolBalls(); ///< Get the balls for the simulator.
+    void SetPoolBalls(); ///< Set the balls from the simulator.
+    void LoadPoolSim(); ///< Load the balls into the simulator.
+    void PoolSimMove(); ///< Move all balls using the simulator.
+    void ReadPoolSim(); ///< Copy the balls out of the simulator.
+    void FrameSolverMove(); ///< Move all balls using the frame solver.
+    void ProcessPoolEvents(const std::vector<CPoolEvent>&); ///< Sounds and particles for pool events.
+    void DropMarker(UINT, const Vector2&); ///< Mark a collision.
+    void DrawPrediction(); ///< Draw the predicted shot.
+    void DrawTrajectories(); ///< Draw the trajectories recorded in step mode.
+
+    UINT GetIndex(const CObject*) const; ///< Get index of a ball.
 
   public:
     CObjectManager(); ///< Constructor.
     ~CObjectManager(); ///< Destructor.
 
-    void create(eSprite, const Vector2&); ///< Create new object.
+    CObject* create(eSprite, const Vector2&); ///< Create new object.
+    void CreateRack(const Vector2&); ///< Create a rack of 15 object balls.
 
     void clear(); ///< Reset to initial conditions.
+    void ClearTrajectories(); ///< Clear the trajectories recorded in step mode.
     void move(); ///< Move all objects.
     
     void Draw(); ///< Draw all objects.
@@ -55,10 +87,14 @@ class CObjectManager:
     void ResetImpulseVector(); ///< Reset the Impulse Vector.
     void AdjustImpulseVector(float); ///< Adjust the Impulse Vector.
     void AdjustCueBall(float); ///< Move cue-ball up or down.
-    void Shoot(); ///< Shoot the cue ball.
+    void Shoot(float=POOL_IMPULSE); ///< Shoot the cue ball.
+    void AutoShoot(); ///< Let the computer choose a shot and shoot.
+    void FastForward(); ///< Move all balls to where they stop.
 
     bool BallDown(); ///< Is a ball down in a pocket?
     bool CueBallDown(); ///< Is the cue ball down in a pocket?
+    bool EightBallDown(); ///< Is the 8-ball down in a pocket?
+    UINT BallsLeft(); ///< Number of object balls other than the 8-ball on the table.
     bool AllStopped(); ///< Have all balls stopped moving?
 }; //CObjectManager
 
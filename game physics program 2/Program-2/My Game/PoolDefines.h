@@ -0,0 +1,71 @@
+/// \file PoolDefines.h
+/// \brief Defines for the engine-free pool physics.
+///
+/// The pool physics, `CPoolSim`, `CFrameSolver`, `CShotPredictor`, and
+/// `CShotSearch`, uses nothing from the LARC Engine but `UINT`, `XM_PI`,
+/// and `Vector2`. On Windows these come from the engine as usual. Anywhere
+/// else, this header defines them itself, with a `Vector2` that has just the
+/// parts of `DirectX::SimpleMath::Vector2` that the pool physics uses, so
+/// that it builds on its own, for instance for the pool benchmark on Linux.
+
+#ifndef __L4RC_GAME_POOLDEFINES_H__
+#define __L4RC_GAME_POOLDEFINES_H__
+
+#ifdef _WIN32
+  #include "GameDefines.h"
+
+#else
+  #include <cmath>
+
+  typedef unsigned int UINT; ///< Unsigned integer, as in Windows.
+
+  const float XM_PI = 3.141592654f; ///< Pi, as in DirectXMath.
+
+  /// \brief 2D vector.
+  ///
+  /// A stand-in for `DirectX::SimpleMath::Vector2` with the same names.
+
+  class Vector2{
+    public:
+      float x = 0.0f; ///< X coordinate.
+      float y = 0.0f; ///< Y coordinate.
+
+      static const Vector2 Zero; ///< Zero vector.
+
+      Vector2() = default; ///< Default constructor.
+      Vector2(float a, float b): x(a), y(b){} ///< Constructor.
+
+      bool operator==(const Vector2& v) const{return x == v.x && y == v.y;} ///< Equality.
+      bool operator!=(const Vector2& v) const{return x != v.x || y != v.y;} ///< Inequality.
+
+      Vector2& operator+=(const Vector2& v){x += v.x; y += v.y; return *this;} ///< Add.
+      Vector2& operator-=(const Vector2& v){x -= v.x; y -= v.y; return *this;} ///< Subtract.
+      Vector2& operator*=(float s){x *= s; y *= s; return *this;} ///< Scale.
+      Vector2& operator/=(float s){x /= s; y /= s; return *this;} ///< Divide.
+      Vector2 operator-() const{return Vector2(-x, -y);} ///< Negate.
+
+      float Dot(const Vector2& v) const{return x*v.x + y*v.y;} ///< Dot product.
+      float LengthSquared() const{return x*x + y*y;} ///< Length squared.
+      float Length() const{return sqrtf(LengthSquared());} ///< Length.
+
+      void Normalize(){ ///< Normalize.
+        const float len = Length();
+        if(len > 0.0f)*this /= len;
+      } //Normalize
+
+      void Normalize(Vector2& v) const{v = *this; v.Normalize();} ///< Normalize into another vector.
+
+      static float DistanceSquared(const Vector2& a, const Vector2& b){return (a - b).LengthSquared();} ///< Distance squared.
+      static float Distance(const Vector2& a, const Vector2& b){return (a - b).Length();} ///< Distance.
+
+      friend Vector2 operator+(Vector2 a, const Vector2& b){return a += b;} ///< Sum.
+      friend Vector2 operator-(Vector2 a, const Vector2& b){return a -= b;} ///< Difference.
+      friend Vector2 operator*(Vector2 a, float s){return a *= s;} ///< Scale.
+      friend Vector2 operator*(float s, Vector2 a){return a *= s;} ///< Scale.
+      friend Vector2 operator/(Vector2 a, float s){return a /= s;} ///< Divide.
+  }; //Vector2
+
+  inline const Vector2 Vector2::Zero(0.0f, 0.0f);
+#endif //_WIN32
+
+#endif //__L4RC_GAME_POOLDEFINES_H__
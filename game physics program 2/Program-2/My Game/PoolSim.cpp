@@ -0,0 +1,542 @@
+/// \file PoolSim.cpp
+/// \brief Code for the event-driven pool simulator class CPoolSim.
+
+#include <algorithm>
+#include <cfloat>
+
+#include "PoolSim.h"
+
+static const float FAR_AWAY = 1.0e6f; ///< Distance further than anything on the table.
+
+/// Compare predictions by time, for the priority queue.
+/// \param p Another prediction.
+/// \return true if this one is later.
+
+bool CPoolPrediction::operator>(const CPoolPrediction& p) const{
+  return m_fTime > p.m_fTime;
+} //operator>
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Prediction functions.
+
+/// Add a prediction to the queue, stamped with the number of events that
+/// its balls have been in so far.
+/// \param t Path time of event.
+/// \param e Event type.
+/// \param i Index of ball.
+/// \param j Index of the other ball, the rail, or the pocket.
+
+void CPoolSim::Push(float t, ePoolEvent e, UINT i, UINT j){
+  CPoolPrediction p;
+  p.m_fTime = t;
+  p.m_eType = e;
+  p.m_nBall = i;
+  p.m_nOther = j;
+  p.m_nCount = m_stdCount[i];
+  p.m_nOtherCount = e == ePoolEvent::Ball? m_stdCount[j]: 0;
+  m_stdQueue.push(p);
+} //Push
+
+/// Predict when two balls will collide, if ever, assuming that neither of
+/// them is in another event first. The minimum closing speed is
+/// `POOL_MINCLOSING` at the current speed factor.
+/// \param i Index of a ball.
+/// \param j Index of another ball.
+
+void CPoolSim::PredictPair(UINT i, UINT j){
+  const float t = GetPairTime(m_stdBall[i], m_stdBall[j], POOL_MINCLOSING/GetSpeed());
+
+  if(t < FLT_MAX)
+    Push(m_fTime + t, ePoolEvent::Ball, i, j);
+} //PredictPair
+
+/// Predict when a ball will hit a rail, assuming that it isn't in another
+/// event first.
+/// \param i Index of ball.
+
+void CPoolSim::PredictRail(UINT i){
+  UINT rail = 0; //rail hit
+  const float t = GetRailTime(m_stdBall[i], m_cTable, rail);
+
+  if(t < FLT_MAX)
+    Push(m_fTime + t, ePoolEvent::Rail, i, rail);
+} //PredictRail
+
+/// Predict when a ball will go into a pocket, assuming that it isn't in
+/// another event first.
+/// \param i Index of ball.
+
+void CPoolSim::PredictPocket(UINT i){
+  UINT pocket = 0; //pocket gone into
+  const float t = GetPocketTime(m_stdBall[i], m_cTable, pocket);
+
+  if(t < FLT_MAX)
+    Push(m_fTime + t, ePoolEvent::Pocket, i, pocket);
+} //PredictPocket
+
+/// Predict when a ball will slow down enough to stop, assuming that it isn't
+/// in another event first. Its speed is its path speed times the speed
+/// factor, which is linear in path time, so this is exact.
+/// \param i Index of ball.
+
+void CPoolSim::PredictStop(UINT i){
+  const float v = m_stdBall[i].m_vVel.Length(); //path speed
+  const float t = POOL_SCALE*(1.0f - sqrtf(POOL_MINSPEEDSQ)/v)/POOL_FRICTION; //path time of stop
+  Push(std::max(t, m_fTime), ePoolEvent::Stop, i, 0);
+} //PredictStop
+
+/// Predict the next events for a ball against the rails, the pockets, and
+/// every other ball, except for one that has already been predicted, and
+/// predict when it will stop. A ball that isn't moving can't hit a rail or
+/// go into a pocket, but it can still be hit.
+/// \param i Index of ball.
+/// \param skip Index of ball to skip.
+
+void CPoolSim::Predict(UINT i, UINT skip){
+  const CPoolBall& b = m_stdBall[i]; //shorthand
+  if(b.m_bInPocket)return;
+
+  if(b.m_vVel != Vector2::Zero){
+    PredictRail(i);
+    PredictPocket(i);
+    PredictStop(i);
+  } //if
+
+  for(UINT j=0; j<(UINT)m_stdBall.size(); j++)
+    if(j != i && j != skip)
+      PredictPair(i, j);
+} //Predict
+
+/// Check whether a prediction is up to date, that is, whether none of the
+/// balls in it have been in an event since it was made.
+/// \param p A prediction.
+/// \return true if it is up to date.
+
+bool CPoolSim::IsValid(const CPoolPrediction& p) const{
+  return p.m_nCount == m_stdCount[p.m_nBall] && (p.m_eType != ePoolEvent::Ball ||
+    p.m_nOtherCount == m_stdCount[p.m_nOther]);
+} //IsValid
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Time of impact functions.
+
+/// Get the path time until two balls collide, if ever, assuming that neither
+/// of them is in another event first. They collide when the distance between
+/// their centers shrinks to the sum of their radii, which is the smaller root
+/// of a quadratic in time. Balls that are already touching and closing
+/// collide straight away. Balls that are closing slower than a minimum speed
+/// don't collide, otherwise balls touching in a rack can collide over and over
+/// with a change in velocity too small to be represented.
+/// \param b0 A ball.
+/// \param b1 Another ball.
+/// \param vmin Minimum closing speed in path time.
+/// \return Path time until impact, or `FLT_MAX` if they don't collide.
+
+float CPoolSim::GetPairTime(const CPoolBall& b0, const CPoolBall& b1, float vmin){
+  if(b0.m_bInPocket || b1.m_bInPocket)return FLT_MAX;
+
+  const Vector2 d = b1.m_vPos - b0.m_vPos; //relative position
+  const Vector2 w = b1.m_vVel - b0.m_vVel; //relative velocity
+  const float b = d.Dot(w); //negative if closing
+  if(b >= 0.0f || b*b < vmin*vmin*d.LengthSquared())return FLT_MAX; //not closing fast enough
+
+  const float r = b0.m_fRadius + b1.m_fRadius; //distance between centers at impact
+  const float a = w.LengthSquared(); //quadratic coefficient
+  const float c = d.LengthSquared() - r*r; //negative if overlapping
+  const float disc = b*b - a*c; //discriminant
+  if(disc < 0.0f)return FLT_MAX; //they miss
+
+  return c <= 0.0f? 0.0f: (-b - sqrtf(disc))/a;
+} //GetPairTime
+
+/// Get the path time until a ball hits a rail, assuming that it isn't in
+/// another event first. Only the rail that it hits first counts. Rails are
+/// numbered left, right, bottom, top.
+/// \param b A ball.
+/// \param table Table.
+/// \param rail [out] Rail hit.
+/// \return Path time until impact, or `FLT_MAX` if it isn't moving.
+
+float CPoolSim::GetRailTime(const CPoolBall& b, const CPoolTable& table, UINT& rail){
+  const float r = b.m_fRadius; //shorthand
+  const Vector2& p = b.m_vPos; //shorthand
+  const Vector2& v = b.m_vVel; //shorthand
+
+  float t = FAR_AWAY; //time until impact
+  rail = 0;
+
+  if(v.x < 0.0f){ //left
+    t = (table.m_fLeft + r - p.x)/v.x;
+    rail = 0;
+  } //if
+
+  else if(v.x > 0.0f){ //right
+    t = (table.m_fRight - r - p.x)/v.x;
+    rail = 1;
+  } //else if
+
+  float ty = FAR_AWAY; //time until impact with horizontal rail
+
+  if(v.y < 0.0f) //bottom
+    ty = (table.m_fBottom + r - p.y)/v.y;
+
+  else if(v.y > 0.0f) //top
+    ty = (table.m_fTop - r - p.y)/v.y;
+
+  if(ty < t){
+    t = ty;
+    rail = v.y < 0.0f? 2: 3;
+  } //if
+
+  return t < FAR_AWAY? std::max(t, 0.0f): FLT_MAX;
+} //GetRailTime
+
+/// Get the path time until a ball goes into a pocket, assuming that it isn't
+/// in another event first. The region that the ball's center has to be in to
+/// go into each pocket is a box, open on the cushion side, and the time
+/// that it gets into the box is found by clipping its path against the box.
+/// Only the pocket that it gets into first counts.
+/// \param b A ball.
+/// \param table Table.
+/// \param pocket [out] Pocket gone into.
+/// \return Path time until it goes in, or `FLT_MAX` if it doesn't.
+
+float CPoolSim::GetPocketTime(const CPoolBall& b, const CPoolTable& table, UINT& pocket){
+  const float r = b.m_fRadius; //shorthand
+  const float cx = (table.m_fLeft + table.m_fRight)/2.0f; //center of long cushions
+
+  const float xlo[3] = {-FAR_AWAY, cx - 0.75f*r, table.m_fRight - 1.5f*r}; //box left sides
+  const float xhi[3] = {table.m_fLeft + 1.5f*r, cx + 0.75f*r, FAR_AWAY}; //box right sides
+  const float ylo[2] = {table.m_fTop - 1.5f*r, -FAR_AWAY}; //box bottoms
+  const float yhi[2] = {FAR_AWAY, table.m_fBottom + 1.5f*r}; //box tops
+
+  float tbest = FAR_AWAY; //time until it gets into first pocket
+  pocket = 0;
+
+  for(UINT n=0; n<6; n++){
+    const float lo[2] = {xlo[n%3], ylo[n/3]}; //box bottom left
+    const float hi[2] = {xhi[n%3], yhi[n/3]}; //box top right
+    const float p[2] = {b.m_vPos.x, b.m_vPos.y}; //position
+    const float v[2] = {b.m_vVel.x, b.m_vVel.y}; //velocity
+
+    float tin = -FAR_AWAY; //time of entry
+    float tout = FAR_AWAY; //time of exit
+
+    for(UINT k=0; k<2 && tin<tout; k++)
+      if(v[k] == 0.0f){
+        if(p[k] <= lo[k] || p[k] >= hi[k])
+          tout = -FAR_AWAY; //never in box
+      } //if
+
+      else{
+        const float t0 = (lo[k] - p[k])/v[k]; //time of crossing low side
+        const float t1 = (hi[k] - p[k])/v[k]; //time of crossing high side
+        tin = std::max(tin, std::min(t0, t1));
+        tout = std::min(tout, std::max(t0, t1));
+      } //else
+
+    if(tin < tout && tout > 0.0f && tin < tbest){
+      tbest = std::max(tin, 0.0f);
+      pocket = n;
+    } //if
+  } //for
+
+  return tbest < FAR_AWAY? tbest: FLT_MAX;
+} //GetPocketTime
+
+/// Resolve an event that happens to some balls now. Ball-ball collisions are
+/// elastic, as in `CObjectManager::BallCollide()`, and rails reflect the
+/// velocity with `POOL_RESTITUTION` as in `CBallBatch::RailCollide()`. All of
+/// this is linear in the velocities, so they can be in path time.
+/// \param balls Balls.
+/// \param table Table.
+/// \param type Event type.
+/// \param i Index of ball.
+/// \param j Index of the other ball, the rail, or the pocket.
+/// \param speed Speed factor that converts the velocities to real ones.
+/// \return The event, with real speeds.
+
+const CPoolEvent CPoolSim::Collide(std::vector<CPoolBall>& balls, const CPoolTable& table,
+  ePoolEvent type, UINT i, UINT j, float speed)
+{
+  CPoolBall& b = balls[i]; //shorthand
+
+  CPoolEvent e;
+  e.m_eType = type;
+  e.m_nBall = i;
+  e.m_nOther = j;
+  e.m_vPos = b.m_vPos;
+
+  switch(type){
+    case ePoolEvent::Ball: {
+      CPoolBall& b1 = balls[j]; //shorthand
+
+      Vector2 nhat = b.m_vPos - b1.m_vPos; //normal to tangent
+      nhat.Normalize();
+
+      const float s = (b1.m_vVel - b.m_vVel).Dot(nhat); //closing speed
+      b.m_vVel += s*nhat; //what one ball gains
+      b1.m_vVel -= s*nhat; //the other one loses
+
+      e.m_vOtherPos = b1.m_vPos;
+      e.m_fSpeed = s*speed;
+    } //case
+    break;
+
+    case ePoolEvent::Rail:
+      if(j < 2){ //vertical rail
+        b.m_vPos.x = j == 0? table.m_fLeft + b.m_fRadius: table.m_fRight - b.m_fRadius;
+        b.m_vVel.x = -POOL_RESTITUTION*b.m_vVel.x;
+      } //if
+
+      else{ //horizontal rail
+        b.m_vPos.y = j == 2? table.m_fBottom + b.m_fRadius: table.m_fTop - b.m_fRadius;
+        b.m_vVel.y = -POOL_RESTITUTION*b.m_vVel.y;
+      } //else
+
+      e.m_vPos = b.m_vPos;
+      e.m_fSpeed = b.m_vVel.Length()*speed;
+    break;
+
+    case ePoolEvent::Pocket:
+      e.m_fSpeed = b.m_vVel.Length()*speed;
+      b.m_vPos = table.m_vPocket[j];
+      b.m_vVel = Vector2::Zero;
+      b.m_bInPocket = true;
+    break;
+
+    case ePoolEvent::Stop:
+      b.m_vVel = Vector2::Zero;
+    break;
+
+    default: break;
+  } //switch
+
+  return e;
+} //Collide
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Simulation functions.
+
+/// Set the table.
+/// \param t Table.
+
+void CPoolSim::SetTable(const CPoolTable& t){
+  m_cTable = t;
+} //SetTable
+
+/// Start simulating some balls, throwing away everything from before
+/// and predicting the first events for every ball.
+/// \param balls Balls.
+
+void CPoolSim::Begin(const std::vector<CPoolBall>& balls){
+  m_stdBall = balls;
+  m_stdCount.assign(balls.size(), 0);
+  m_stdEvent.clear();
+  m_stdQueue = decltype(m_stdQueue)();
+
+  m_fTime = 0.0f;
+  m_nMoving = 0;
+
+  for(UINT i=0; i<(UINT)m_stdBall.size(); i++){
+    if(!m_stdBall[i].m_bInPocket && m_stdBall[i].m_vVel != Vector2::Zero)
+      m_nMoving++;
+
+    Predict(i, UINT_MAX);
+  } //for
+} //Begin
+
+/// Move all balls that are moving to a path time. Times in the past are
+/// ignored, which can only happen if a frame ran out of events.
+/// \param t Path time.
+
+void CPoolSim::MoveTo(float t){
+  if(t <= m_fTime)return;
+
+  for(CPoolBall& b: m_stdBall)
+    b.m_vPos += (t - m_fTime)*b.m_vVel;
+
+  m_fTime = t;
+} //MoveTo
+
+/// Resolve an event at the current time, record it, and predict new events
+/// for the balls in it. The number of balls moving is kept up to date.
+/// \param p Prediction of event.
+
+void CPoolSim::Resolve(const CPoolPrediction& p){
+  const UINT i = p.m_nBall; //shorthand
+  const UINT j = p.m_nOther; //shorthand
+  const bool pair = p.m_eType == ePoolEvent::Ball; //whether there are two balls
+
+  auto moving = [&](){ //number of balls in event that are moving
+    return UINT(m_stdBall[i].m_vVel != Vector2::Zero) +
+      UINT(pair && m_stdBall[j].m_vVel != Vector2::Zero);
+  }; //moving
+
+  m_nMoving -= moving();
+  m_stdEvent.push_back(Collide(m_stdBall, m_cTable, p.m_eType, i, j, GetSpeed()));
+  m_nMoving += moving();
+
+  m_stdCount[i]++;
+
+  if(pair){
+    m_stdCount[j]++;
+    Predict(i, j);
+    Predict(j);
+  } //if
+
+  else Predict(i);
+} //Resolve
+
+/// Advance by a frame. Events are resolved in order up to the end of the
+/// frame, including balls stopping, and then all balls are moved to the end
+/// of the frame. The result doesn't depend on the frame time.
+/// \param dt Frame time in seconds.
+
+void CPoolSim::Advance(float dt){
+  m_stdEvent.clear();
+
+  const float tend = POOL_SCALE*(1.0f - GetSpeed()*expf(-POOL_FRICTION*dt))/POOL_FRICTION; //path time at end of frame
+  UINT n = 0; //number of events resolved
+
+  while(!m_stdQueue.empty() && m_stdQueue.top().m_fTime <= tend && n < POOL_MAXEVENTS){
+    const CPoolPrediction p = m_stdQueue.top();
+    m_stdQueue.pop();
+
+    if(IsValid(p)){
+      MoveTo(p.m_fTime);
+      Resolve(p);
+      n++;
+    } //if
+  } //while
+
+  MoveTo(tend);
+} //Advance
+
+/// Advance to the next event and resolve it, whenever it is. The event is
+/// added to the end of the events, which are not cleared first.
+/// \return true if there was an event, false if all balls have stopped.
+
+bool CPoolSim::Step(){
+  while(!m_stdQueue.empty()){
+    const CPoolPrediction p = m_stdQueue.top();
+    m_stdQueue.pop();
+
+    if(IsValid(p)){
+      MoveTo(p.m_fTime);
+      Resolve(p);
+      return true;
+    } //if
+  } //while
+
+  return false;
+} //Step
+
+/// Advance until all balls have stopped, without stopping at frames. Every
+/// ball that is moving has a stop predicted, so this ends when there are no
+/// more predictions, or after `POOL_MAXRESTEVENTS` events.
+/// \return Time taken for all balls to stop, in seconds.
+
+float CPoolSim::RunToRest(){
+  m_stdEvent.clear();
+
+  const float t0 = m_fTime; //path time at start
+  UINT n = 0; //number of events resolved
+
+  while(n < POOL_MAXRESTEVENTS && Step())
+    n++;
+
+  return GetRealTime(m_fTime) - GetRealTime(t0);
+} //RunToRest
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Motion functions.
+
+/// Get the path time after some seconds, that is, the distance that a ball
+/// with unit velocity goes in that time if nothing gets in its way and it
+/// doesn't stop.
+/// \param t Time in seconds.
+/// \return Path time.
+
+float CPoolSim::GetPathTime(float t){
+  return POOL_SCALE*(1.0f - expf(-POOL_FRICTION*t))/POOL_FRICTION;
+} //GetPathTime
+
+/// Get the number of seconds until a path time, the inverse of GetPathTime.
+/// \param t Path time.
+/// \return Time in seconds, or `FLT_MAX` if the path time is never reached.
+
+float CPoolSim::GetRealTime(float t){
+  const float f = 1.0f - POOL_FRICTION*t/POOL_SCALE; //speed factor
+  return f > 0.0f? -logf(f)/POOL_FRICTION: FLT_MAX;
+} //GetRealTime
+
+/// Get the number of seconds until a ball slows down enough to stop, if
+/// nothing gets in its way.
+/// \param v Speed of ball.
+/// \return Time in seconds.
+
+float CPoolSim::GetStopTime(float v){
+  return v*v < POOL_MINSPEEDSQ? 0.0f: logf(v/sqrtf(POOL_MINSPEEDSQ))/POOL_FRICTION;
+} //GetStopTime
+
+/// Move a ball for some seconds as if there were nothing else on the table.
+/// \param b A ball.
+/// \param t Time in seconds.
+/// \return The ball after that time.
+
+const CPoolBall CPoolSim::Coast(const CPoolBall& b, float t){
+  CPoolBall c = b;
+  if(c.m_bInPocket)return c;
+
+  const float tstop = GetStopTime(c.m_vVel.Length()); //time until it stops
+  c.m_vPos += GetPathTime(std::min(t, tstop))*c.m_vVel;
+
+  if(t < tstop)
+    c.m_vVel *= expf(-POOL_FRICTION*t);
+  else c.m_vVel = Vector2::Zero;
+
+  return c;
+} //Coast
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Reader functions.
+
+/// Get the speed factor, which converts velocities in path time to real
+/// velocities. It starts at 1 and falls linearly with path time.
+/// \return Speed factor.
+
+const float CPoolSim::GetSpeed() const{
+  return 1.0f - POOL_FRICTION*m_fTime/POOL_SCALE;
+} //GetSpeed
+
+/// Check whether all balls have stopped, in constant time.
+/// \return true if no balls are moving.
+
+const bool CPoolSim::IsStopped() const{
+  return m_nMoving == 0;
+} //IsStopped
+
+/// Reader function for the number of balls.
+/// \return Number of balls.
+
+const UINT CPoolSim::GetNumBalls() const{
+  return (UINT)m_stdBall.size();
+} //GetNumBalls
+
+/// Get a ball, with its velocity converted from path time to real time.
+/// \param i Index of ball.
+/// \return The ball.
+
+const CPoolBall CPoolSim::GetBall(UINT i) const{
+  CPoolBall b = m_stdBall[i];
+  b.m_vVel *= GetSpeed();
+  return b;
+} //GetBall
+
+/// Reader function for the events from the last frame.
+/// \return Events in the order that they happened.
+
+const std::vector<CPoolEvent>& CPoolSim::GetEvents() const{
+  return m_stdEvent;
+} //GetEvents
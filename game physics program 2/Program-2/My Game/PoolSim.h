@@ -0,0 +1,166 @@
+/// \file PoolSim.h
+/// \brief Interface for the pool simulator records and the event-driven pool simulator class CPoolSim.
+
+#ifndef __L4RC_GAME_POOLSIM_H__
+#define __L4RC_GAME_POOLSIM_H__
+
+#include <climits>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "PoolDefines.h"
+
+const float POOL_SCALE = 50.0f; ///< Distance moved per second per unit of velocity.
+const float POOL_FRICTION = 0.6f; ///< Coefficient of friction.
+const float POOL_MINSPEEDSQ = 0.5f; ///< Balls moving slower than the square root of this stop.
+const float POOL_RESTITUTION = 0.8f; ///< How bouncy the rails are.
+const float POOL_MINCLOSING = 1.0e-3f; ///< Balls closing slower than this don't collide.
+const UINT POOL_MAXEVENTS = 1024; ///< Maximum number of events resolved per frame.
+const UINT POOL_MAXRESTEVENTS = 65536; ///< Maximum number of events resolved running to rest.
+const float POOL_IMPULSE = 30.0f; ///< Magnitude of the impulse that the cue gives the cue ball.
+
+/// \brief Pool event type.
+///
+/// An enumerated type for the things that can happen to a ball.
+/// `Size` must be last.
+
+enum class ePoolEvent{
+  Ball, Rail, Pocket, Stop,
+  Size //MUST be last
+}; //ePoolEvent
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Pool ball.
+///
+/// The state of a ball, without any of the sprite stuff.
+
+class CPoolBall{
+  public:
+    Vector2 m_vPos; ///< Position.
+    Vector2 m_vVel; ///< Velocity.
+    float m_fRadius = 0.0f; ///< Radius.
+    bool m_bInPocket = false; ///< Whether it is in a pocket.
+}; //CPoolBall
+
+/// \brief Pool table.
+///
+/// The cushions and pockets. A ball goes into a pocket when its center comes
+/// within one and a half radii of a cushion near a corner, or within three
+/// quarters of a radius of the middle of a long cushion, as in
+/// `CBallBatch::PocketCollide()`.
+
+class CPoolTable{
+  public:
+    float m_fLeft = 0.0f; ///< Left cushion.
+    float m_fRight = 0.0f; ///< Right cushion.
+    float m_fBottom = 0.0f; ///< Bottom cushion.
+    float m_fTop = 0.0f; ///< Top cushion.
+    Vector2 m_vPocket[6]; ///< Where balls in the top left, center, and right, and bottom left, center, and right pockets go.
+}; //CPoolTable
+
+/// \brief Pool event.
+///
+/// Something that happened to a ball, for the sounds and particles.
+
+class CPoolEvent{
+  public:
+    ePoolEvent m_eType = ePoolEvent::Ball; ///< Event type.
+    UINT m_nBall = 0; ///< Index of ball.
+    UINT m_nOther = 0; ///< Index of the other ball, the rail, or the pocket.
+    Vector2 m_vPos; ///< Position of ball at time of impact.
+    Vector2 m_vOtherPos; ///< Position of the other ball at time of impact.
+    float m_fSpeed = 0.0f; ///< Closing speed for balls, speed after bouncing for rails, speed going in for pockets.
+}; //CPoolEvent
+
+/// \brief Pool prediction.
+///
+/// An event predicted to happen at some time, along with the number of events
+/// that each ball had been in when it was predicted. If either ball has been
+/// in an event since then, the prediction is out of date.
+
+class CPoolPrediction{
+  public:
+    float m_fTime = 0.0f; ///< Path time of event.
+    ePoolEvent m_eType = ePoolEvent::Ball; ///< Event type.
+    UINT m_nBall = 0; ///< Index of ball.
+    UINT m_nOther = 0; ///< Index of the other ball, the rail, or the pocket.
+    UINT m_nCount = 0; ///< Number of events the ball had been in.
+    UINT m_nOtherCount = 0; ///< Number of events the other ball had been in.
+
+    bool operator>(const CPoolPrediction&) const; ///< Later than.
+}; //CPoolPrediction
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Event-driven pool simulator.
+///
+/// Instead of moving every ball a frame at a time and then looking for
+/// collisions, this keeps a priority queue of predicted ball-ball, ball-rail,
+/// and ball-pocket events, moves the balls straight to the next one, resolves
+/// it, and predicts new events only for the balls that it changed. Collisions
+/// are resolved in the exact order that they happen, however many there are
+/// in a frame, and a frame in which nothing happens costs nothing but moving
+/// the balls.
+///
+/// Friction slows every ball by the same factor \f$e^{-kt}\f$ after \f$t\f$
+/// seconds, where \f$k\f$ is `POOL_FRICTION`, so instead of real time the balls
+/// move in path time, which runs at the current speed factor and is
+/// \f$s(1 - e^{-kt})/k\f$ after \f$t\f$ seconds, where \f$s\f$ is `POOL_SCALE`.
+/// Each ball has a fixed velocity in path time between events, so predictions
+/// stay good for as long as no ball in them is in an event, even though every
+/// ball slows down all the time. The speed factor is linear in path time, so
+/// the time that a ball slows down enough to stop can be predicted exactly
+/// like any other event. Nothing depends on the frame time, so a shot can
+/// be run to rest in one call, in time proportional to its number of events.
+
+class CPoolSim{
+  private:
+    CPoolTable m_cTable; ///< Table.
+    std::vector<CPoolBall> m_stdBall; ///< Balls, with velocities in path time.
+    std::vector<UINT> m_stdCount; ///< Number of events each ball has been in.
+    std::vector<CPoolEvent> m_stdEvent; ///< Events from the last frame.
+
+    std::priority_queue<CPoolPrediction, std::vector<CPoolPrediction>,
+      std::greater<CPoolPrediction>> m_stdQueue; ///< Predicted events, soonest first.
+
+    float m_fTime = 0.0f; ///< Path time.
+    UINT m_nMoving = 0; ///< Number of balls moving.
+
+    void MoveTo(float); ///< Move all balls to a path time.
+    void Push(float, ePoolEvent, UINT, UINT); ///< Add a prediction.
+    void Predict(UINT, UINT=UINT_MAX); ///< Predict events for a ball.
+    void PredictPair(UINT, UINT); ///< Predict a ball-ball event.
+    void PredictRail(UINT); ///< Predict a ball-rail event.
+    void PredictPocket(UINT); ///< Predict a ball-pocket event.
+    void PredictStop(UINT); ///< Predict when a ball stops.
+    bool IsValid(const CPoolPrediction&) const; ///< Whether a prediction is up to date.
+    void Resolve(const CPoolPrediction&); ///< Resolve an event.
+
+  public:
+    void SetTable(const CPoolTable&); ///< Set the table.
+    void Begin(const std::vector<CPoolBall>&); ///< Start simulating some balls.
+    void Advance(float); ///< Advance by a frame.
+    bool Step(); ///< Advance to the next event.
+    float RunToRest(); ///< Advance until all balls stop.
+
+    static float GetPathTime(float); ///< Get path time after some seconds.
+    static float GetRealTime(float); ///< Get seconds until a path time.
+    static float GetStopTime(float); ///< Get seconds until a ball stops.
+    static const CPoolBall Coast(const CPoolBall&, float); ///< Move a ball without collisions.
+
+    static float GetPairTime(const CPoolBall&, const CPoolBall&, float); ///< Get path time until two balls collide.
+    static float GetRailTime(const CPoolBall&, const CPoolTable&, UINT&); ///< Get path time until a ball hits a rail.
+    static float GetPocketTime(const CPoolBall&, const CPoolTable&, UINT&); ///< Get path time until a ball goes into a pocket.
+    static const CPoolEvent Collide(std::vector<CPoolBall>&, const CPoolTable&,
+      ePoolEvent, UINT, UINT, float); ///< Resolve an event.
+
+    const float GetSpeed() const; ///< Get speed factor.
+    const bool IsStopped() const; ///< Whether all balls have stopped.
+    const UINT GetNumBalls() const; ///< Get number of balls.
+    const CPoolBall GetBall(UINT) const; ///< Get a ball.
+    const std::vector<CPoolEvent>& GetEvents() const; ///< Get the last frame's events.
+}; //CPoolSim
+
+#endif //__L4RC_GAME_POOLSIM_H__
@@ -77,3 +77,26 @@ void CRenderer::DrawLine(const Vector2& p0, const Vector2& p1, XMVECTORF32 c){
     d.m_vPos += delta; //advance along line
   } //for
 } //DrawLine
+
+/// Draw a polyline by rendering one copy of the line sprite per segment in
+/// batched mode, stretched to the length of the segment. Unlike `DrawLine()`,
+/// the number of sprites drawn doesn't depend on how long the segments are,
+/// which suits polylines with many short segments.
+/// \param p Vertices of the polyline. Nothing is drawn if there are fewer than two.
+/// \param c Line color, such as Colors::Aqua.
+
+void CRenderer::DrawPolyline(const std::vector<Vector2>& p, XMVECTORF32 c){
+  LSpriteDesc2D d; //sprite descriptor for line sprite
+  d.m_nSpriteIndex = (UINT)eSprite::Line; //line sprite index
+  d.m_f4Tint = XMFLOAT4(c);
+
+  const float w = GetWidth((UINT)eSprite::Line); //width of line sprite
+
+  for(size_t i=1; i<p.size(); i++){
+    const Vector2 dv = p[i] - p[i - 1]; //segment
+    d.m_vPos = 0.5f*(p[i - 1] + p[i]); //center of segment
+    d.m_fRoll = atan2f(dv.y, dv.x); //orientation angle
+    d.m_fXScale = dv.Length()/w; //stretch to length of segment
+    Draw(&d);
+  } //for
+} //DrawPolyline
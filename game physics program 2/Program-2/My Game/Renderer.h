@@ -4,6 +4,8 @@
 #ifndef __L4RC_GAME_RENDERER_H__
 #define __L4RC_GAME_RENDERER_H__
 
+#include <vector>
+
 #include "GameDefines.h"
 #include "SpriteRenderer.h"
 
@@ -20,6 +22,7 @@ class CRenderer: public LSpriteRenderer{
     void DrawMessage(eGameState); ///< Draw win/lose text message to screen.
     
     void DrawLine(const Vector2& p0, const Vector2& p1, XMVECTORF32 c); ///< Draw colored line.
+    void DrawPolyline(const std::vector<Vector2>&, XMVECTORF32); ///< Draw colored polyline.
 }; //CRenderer
 
 #endif //__L4RC_GAME_RENDERER_H__
@@ -0,0 +1,147 @@
+/// \file ShotPredictor.cpp
+/// \brief Code for the shot predictor class CShotPredictor.
+
+#include "ShotPredictor.h"
+
+/// Get the position of a ball in an event, if it is in it.
+/// \param e An event.
+/// \param i Index of ball.
+/// \param p [OUT] Position of ball at the event.
+/// \return true if the ball is in the event.
+
+static bool GetPos(const CPoolEvent& e, UINT i, Vector2& p){
+  if(e.m_nBall == i)
+    p = e.m_vPos;
+
+  else if(e.m_eType == ePoolEvent::Ball && e.m_nOther == i)
+    p = e.m_vOtherPos;
+
+  else return false;
+
+  return true;
+} //GetPos
+
+/// Check whether an event ends the path of a ball, which it does if the
+/// ball stops or goes into a pocket.
+/// \param e An event.
+/// \param i Index of ball.
+/// \return true if it ends the path of the ball.
+
+static bool IsEnd(const CPoolEvent& e, UINT i){
+  return e.m_nBall == i &&
+    (e.m_eType == ePoolEvent::Stop || e.m_eType == ePoolEvent::Pocket);
+} //IsEnd
+
+/// Add a point to the end of a path. If it is very close to the last point,
+/// which happens when balls in a rack jostle each other, the last point is
+/// moved instead so that the path doesn't fill up with tiny segments.
+/// \param path A path.
+/// \param p A point.
+
+static void AddPoint(std::vector<Vector2>& path, const Vector2& p){
+  if(path.size() > 1 && (p - path.back()).LengthSquared() < PREDICT_MINLENGTH*PREDICT_MINLENGTH)
+    path.back() = p;
+  else path.push_back(p);
+} //AddPoint
+
+///////////////////////////////////////////////////////////////////////////////////////
+
+/// Throw away the paths so that the next prediction is made from scratch.
+/// This must be called whenever any ball other than the cue ball has moved.
+
+void CShotPredictor::Invalidate(){
+  m_bValid = false;
+} //Invalidate
+
+/// Check whether the paths are up to date, that is, whether they are for
+/// this cue angle and cue ball position and haven't been invalidated since.
+/// \param a Cue angle.
+/// \param pos Cue ball position.
+/// \return true if the paths are up to date.
+
+const bool CShotPredictor::IsCurrent(float a, const Vector2& pos) const{
+  return m_bValid && a == m_fAngle && pos == m_vCuePos;
+} //IsCurrent
+
+/// Predict the paths of the cue ball and the first object ball that it hits.
+/// The cue ball is given the velocity that `CObject::DeliverImpulse()` would
+/// give it with `POOL_IMPULSE`, and the shot is simulated an event at a time
+/// until both paths are finished.
+/// \param t Table.
+/// \param balls Balls, all of which must have stopped.
+/// \param cue Index of cue ball.
+/// \param a Cue angle.
+
+void CShotPredictor::Predict(const CPoolTable& t, const std::vector<CPoolBall>& balls,
+  UINT cue, float a)
+{
+  m_bValid = true;
+  m_fAngle = a;
+  m_vCuePos = balls[cue].m_vPos;
+
+  m_stdCuePath.clear();
+  m_stdObjectPath.clear();
+  m_nObject = UINT_MAX;
+
+  m_stdBall = balls;
+  m_stdBall[cue].m_vVel = POOL_IMPULSE*Vector2(cosf(a), sinf(a));
+  m_stdCuePath.push_back(m_vCuePos);
+
+  m_cSim.SetTable(t);
+  m_cSim.Begin(m_stdBall);
+
+  bool cuedone = false; //whether the cue ball path is finished
+  bool objdone = false; //whether the object ball path is finished
+
+  for(UINT n=0; n<PREDICT_MAXEVENTS && (!cuedone || (m_nObject != UINT_MAX && !objdone)) &&
+    m_cSim.Step(); n++)
+  {
+    const CPoolEvent& e = m_cSim.GetEvents().back(); //latest event
+    Vector2 p; //position of a ball in it
+
+    if(m_nObject == UINT_MAX && e.m_eType == ePoolEvent::Ball && GetPos(e, cue, p)){ //first impact
+      m_nObject = e.m_nBall == cue? e.m_nOther: e.m_nBall;
+      m_vContact = p;
+    } //if
+
+    if(!cuedone && GetPos(e, cue, p)){
+      AddPoint(m_stdCuePath, p);
+      cuedone = m_stdCuePath.size() >= PREDICT_MAXPOINTS || IsEnd(e, cue);
+    } //if
+
+    if(!objdone && m_nObject != UINT_MAX && GetPos(e, m_nObject, p)){
+      AddPoint(m_stdObjectPath, p);
+      objdone = m_stdObjectPath.size() >= PREDICT_MAXPOINTS || IsEnd(e, m_nObject);
+    } //if
+  } //for
+} //Predict
+
+/// Reader function for the cue ball path.
+/// \return Positions of the cue ball at the start of the shot and at each event.
+
+const std::vector<Vector2>& CShotPredictor::GetCuePath() const{
+  return m_stdCuePath;
+} //GetCuePath
+
+/// Reader function for the object ball path.
+/// \return Positions of the first object ball hit at the impact and at each
+/// event after that, empty if the cue ball doesn't hit a ball.
+
+const std::vector<Vector2>& CShotPredictor::GetObjectPath() const{
+  return m_stdObjectPath;
+} //GetObjectPath
+
+/// Reader function for the index of the first object ball hit.
+/// \return Index of ball, `UINT_MAX` if none.
+
+const UINT CShotPredictor::GetObject() const{
+  return m_nObject;
+} //GetObject
+
+/// Reader function for the position of the cue ball at the first impact,
+/// which is only meaningful if it hits a ball.
+/// \return Position of cue ball.
+
+const Vector2& CShotPredictor::GetContact() const{
+  return m_vContact;
+} //GetContact
@@ -0,0 +1,50 @@
+/// \file ShotPredictor.h
+/// \brief Interface for the shot predictor class CShotPredictor.
+
+#ifndef __L4RC_GAME_SHOTPREDICTOR_H__
+#define __L4RC_GAME_SHOTPREDICTOR_H__
+
+#include "PoolSim.h"
+
+const UINT PREDICT_MAXPOINTS = 5; ///< Maximum number of points in a predicted path.
+const UINT PREDICT_MAXEVENTS = 256; ///< Maximum number of events simulated per prediction.
+const float PREDICT_MINLENGTH = 4.0f; ///< Segments shorter than this are merged into the one before.
+
+/// \brief Shot predictor.
+///
+/// Predicts where the cue ball and the first object ball that it hits will go
+/// for a given cue angle, by running the shot in a copy of the event-driven
+/// simulator one event at a time and keeping the positions of those two balls
+/// at each event that they are in. Each path is a polyline that starts where
+/// the ball starts moving and ends where it stops, goes into a pocket, or
+/// reaches `PREDICT_MAXPOINTS` points, so it goes through the first ball-ball
+/// impact and several rail bounces. The paths are kept until the cue angle or
+/// the cue ball moves or the predictor is told that the other balls have moved,
+/// so aiming costs nothing while the player isn't touching anything.
+
+class CShotPredictor{
+  private:
+    CPoolSim m_cSim; ///< Simulator, kept so that its memory gets reused.
+    std::vector<CPoolBall> m_stdBall; ///< Balls at the start of the shot.
+
+    std::vector<Vector2> m_stdCuePath; ///< Path of cue ball.
+    std::vector<Vector2> m_stdObjectPath; ///< Path of first object ball hit.
+    UINT m_nObject = UINT_MAX; ///< Index of first object ball hit, `UINT_MAX` if none.
+    Vector2 m_vContact; ///< Position of cue ball at first impact.
+
+    bool m_bValid = false; ///< Whether the paths are up to date.
+    float m_fAngle = 0.0f; ///< Cue angle that the paths are for.
+    Vector2 m_vCuePos; ///< Cue ball position that the paths are for.
+
+  public:
+    void Invalidate(); ///< Throw away the paths.
+    const bool IsCurrent(float, const Vector2&) const; ///< Whether the paths are up to date.
+    void Predict(const CPoolTable&, const std::vector<CPoolBall>&, UINT, float); ///< Predict a shot.
+
+    const std::vector<Vector2>& GetCuePath() const; ///< Get cue ball path.
+    const std::vector<Vector2>& GetObjectPath() const; ///< Get object ball path.
+    const UINT GetObject() const; ///< Get index of first object ball hit.
+    const Vector2& GetContact() const; ///< Get cue ball position at first impact.
+}; //CShotPredictor
+
+#endif //__L4RC_GAME_SHOTPREDICTOR_H__
@@ -0,0 +1,161 @@
+/// \file ShotSearch.cpp
+/// \brief Code for the shot search class CShotSearch.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "ShotSearch.h"
+
+/// Hash two numbers to a pseudo-random number in \f$[0, 1)\f$. This is the
+/// finalizer from SplitMix64, which is cheap enough to use once per random
+/// number and good enough that nearby seeds give unrelated numbers.
+/// \param seed Random number seed.
+/// \param k Which random number for this seed.
+/// \return Pseudo-random number.
+
+static float Random(UINT seed, UINT k){
+  uint64_t z = ((uint64_t)seed << 32 | k) + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  return (z >> 40)/16777216.0f; //top 24 bits
+} //Random
+
+/// Play a shot to rest and score it, giving up as soon as the cue ball goes
+/// down. The rules are the ones in `CGame::ProcessState()`.
+/// \param sim A simulator.
+/// \param balls Balls, with the shot's velocity on the cue ball.
+/// \param cue Index of cue ball.
+/// \param eight Index of 8-ball.
+/// \param t Table.
+/// \return Score.
+
+float CShotSearch::Evaluate(CPoolSim& sim, std::vector<CPoolBall>& balls, UINT cue, UINT eight,
+  const CPoolTable& t)
+{
+  sim.Begin(balls);
+
+  for(UINT n=0; n<POOL_MAXRESTEVENTS && sim.Step(); n++){
+    const CPoolEvent& e = sim.GetEvents().back(); //latest event
+
+    if(e.m_eType == ePoolEvent::Pocket && e.m_nBall == cue)
+      return SEARCH_LOSE; //scratch
+  } //for
+
+  UINT left = 0; //number of other object balls left on table
+  UINT down = 0; //number of other object balls sunk by this shot
+
+  for(UINT i=0; i<(UINT)balls.size(); i++)
+    if(i != cue && i != eight){
+      if(!sim.GetBall(i).m_bInPocket)
+        left++;
+      else if(!balls[i].m_bInPocket)
+        down++;
+    } //if
+
+  const CPoolBall b8 = sim.GetBall(eight); //8-ball at rest
+  
+  if(b8.m_bInPocket)
+    return left == 0? SEARCH_WIN: SEARCH_LOSE;
+
+  float d = FLT_MAX; //distance from 8-ball to nearest pocket
+
+  for(const Vector2& p: t.m_vPocket)
+    d = std::min(d, Vector2::Distance(b8.m_vPos, p));
+
+  return down*SEARCH_BALLDOWN - d/10.0f;
+} //Evaluate
+
+/// Search for the best shot on a pool of threads. The balls must all have
+/// stopped. 
+/// \param t Table.
+/// \param balls Balls.
+/// \param cue Index of cue ball.
+/// \param eight Index of 8-ball.
+/// \param n Maximum number of shots to try.
+/// \param deadline Time limit in seconds.
+/// \param nThreads Number of threads, zero for one per core.
+/// \param seed Random number seed for the first shot.
+
+void CShotSearch::Search(const CPoolTable& t, const std::vector<CPoolBall>& balls,
+  UINT cue, UINT eight, UINT n, float deadline, UINT nThreads, UINT seed)
+{
+  const auto t0 = std::chrono::steady_clock::now(); //start time
+  const auto tEnd = t0 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    std::chrono::duration<float>(deadline)); //time limit
+
+  if(nThreads == 0)
+    nThreads = std::max(1U, std::thread::hardware_concurrency());
+  nThreads = std::min(nThreads, std::max(1U, n));
+
+  std::atomic<UINT> next(0); //index of next shot
+  std::atomic<UINT> tried(0); //number of shots tried
+  std::atomic<bool> stop(false); //whether to stop early
+  std::vector<CShotCandidate> best(nThreads); //best shot found by each thread
+
+  auto work = [&](UINT id){
+    CPoolSim sim; //this thread's simulator
+    sim.SetTable(t);
+    std::vector<CPoolBall> mine = balls; //this thread's balls
+    CShotCandidate& b = best[id]; //this thread's best shot
+
+    for(UINT i=next++; i<n && !stop; i=next++){
+      CShotCandidate c;
+      c.m_nIndex = i;
+      c.m_fAngle = 2.0f*XM_PI*Random(seed + i, 0);
+      c.m_fImpulse = SEARCH_MINIMPULSE + (SEARCH_MAXIMPULSE - SEARCH_MINIMPULSE)*Random(seed + i, 1);
+
+      mine[cue].m_vVel = c.m_fImpulse*Vector2(cosf(c.m_fAngle), sinf(c.m_fAngle));
+      c.m_fScore = Evaluate(sim, mine, cue, eight, t);
+      tried++;
+
+      if(c.m_fScore > b.m_fScore || (c.m_fScore == b.m_fScore && c.m_nIndex < b.m_nIndex))
+        b = c;
+
+      if(c.m_fScore >= SEARCH_WIN || std::chrono::steady_clock::now() >= tEnd)
+        stop = true; //a winner, or out of time
+    } //for
+  }; //work
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+
+  for(UINT i=0; i<nThreads; i++)
+    threads.emplace_back(work, i);
+
+  for(auto& th: threads)
+    th.join();
+
+  m_cBest = CShotCandidate();
+
+  for(const CShotCandidate& c: best)
+    if(c.m_fScore > m_cBest.m_fScore || (c.m_fScore == m_cBest.m_fScore && c.m_nIndex < m_cBest.m_nIndex))
+      m_cBest = c;
+
+  m_nTried = tried;
+
+  const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - t0;
+  m_fElapsed = elapsed.count();
+} //Search
+
+/// Reader function for the best shot.
+/// \return Best shot found by the last search, with index `UINT_MAX` if none.
+
+const CShotCandidate& CShotSearch::GetBest() const{
+  return m_cBest;
+} //GetBest
+
+/// Reader function for the number of shots tried.
+/// \return Number of shots tried by the last search.
+
+const UINT CShotSearch::GetNumTried() const{
+  return m_nTried;
+} //GetNumTried
+
+/// Reader function for the elapsed time.
+/// \return Wall clock time taken by the last search in seconds.
+
+const float CShotSearch::GetElapsed() const{
+  return m_fElapsed;
+} //GetElapsed
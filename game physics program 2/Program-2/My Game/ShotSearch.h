@@ -0,0 +1,71 @@
+/// \file ShotSearch.h
+/// \brief Interface for the shot search class CShotSearch.
+
+#ifndef __L4RC_GAME_SHOTSEARCH_H__
+#define __L4RC_GAME_SHOTSEARCH_H__
+
+#include <cfloat>
+#include <cstdint>
+
+#include "PoolSim.h"
+
+const UINT SEARCH_SHOTS = 16384; ///< Default maximum number of shots tried.
+const float SEARCH_DEADLINE = 0.05f; ///< Default time limit in seconds.
+const float SEARCH_MINIMPULSE = 0.4f*POOL_IMPULSE; ///< Weakest shot tried.
+const float SEARCH_MAXIMPULSE = 1.6f*POOL_IMPULSE; ///< Strongest shot tried.
+
+const float SEARCH_WIN = 1000.0f; ///< Score for a shot that wins the game.
+const float SEARCH_LOSE = -1000.0f; ///< Score for a shot that loses the game.
+const float SEARCH_BALLDOWN = 100.0f; ///< Score for each other object ball sunk.
+
+/// \brief Candidate shot.
+///
+/// A shot, given by the angle and magnitude of the impulse on the cue ball,
+/// and how good it turned out to be.
+
+class CShotCandidate{
+  public:
+    float m_fAngle = 0.0f; ///< Impulse angle.
+    float m_fImpulse = POOL_IMPULSE; ///< Impulse magnitude.
+    float m_fScore = -FLT_MAX; ///< Score, higher is better.
+    UINT m_nIndex = UINT_MAX; ///< Index of shot in search, `UINT_MAX` if none.
+}; //CShotCandidate
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Shot search.
+///
+/// A computer player that chooses a shot by Monte Carlo search. Shots with
+/// random angles and magnitudes are each played to rest in an event-driven
+/// simulator and scored: sinking the 8-ball when it's the last object ball
+/// wins, sinking the cue ball or sinking the 8-ball too soon loses, and
+/// otherwise each other object ball sunk counts for a lot and the 8-ball
+/// ending up near a pocket for a little. A shot is abandoned as soon as the
+/// cue ball goes down.
+///
+/// The shots are spread over a pool of threads that take the next shot from
+/// a shared counter, each with its own copy of the simulator and the balls,
+/// and keep their own best shot until they are all done, so that the counter
+/// and a stop flag are the only things that the threads share. The search
+/// stops when all shots have been tried, when the time limit is up, or as soon
+/// as any thread finds a shot that wins. Shot `i` uses random number seed
+/// `seed + i`, so a shot's parameters don't depend on which thread tries it.
+
+class CShotSearch{
+  private:
+    CShotCandidate m_cBest; ///< Best shot found in last search.
+    UINT m_nTried = 0; ///< Number of shots tried in last search.
+    float m_fElapsed = 0.0f; ///< Wall clock time taken by last search in seconds.
+
+    static float Evaluate(CPoolSim&, std::vector<CPoolBall>&, UINT, UINT, const CPoolTable&); ///< Score a shot.
+
+  public:
+    void Search(const CPoolTable&, const std::vector<CPoolBall>&, UINT, UINT,
+      UINT=SEARCH_SHOTS, float=SEARCH_DEADLINE, UINT=0, UINT=0); ///< Search for a shot.
+
+    const CShotCandidate& GetBest() const; ///< Get best shot.
+    const UINT GetNumTried() const; ///< Get number of shots tried.
+    const float GetElapsed() const; ///< Get elapsed time.
+}; //CShotSearch
+
+#endif //__L4RC_GAME_SHOTSEARCH_H__
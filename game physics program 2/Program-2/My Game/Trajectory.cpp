@@ -0,0 +1,66 @@
+/// \file Trajectory.cpp
+/// \brief Code for the trajectory recorder class CTrajectory.
+
+#include "Trajectory.h"
+
+/// Throw away all samples and make room for a number of balls. Memory is
+/// only allocated if there are more balls than ever before.
+/// \param n Number of balls.
+
+void CTrajectory::Clear(UINT n){
+  m_stdSample.resize(n*TRAJECTORY_SIZE);
+  m_stdHead.assign(n, 0);
+  m_stdCount.assign(n, 0);
+} //Clear
+
+/// Add a sample to the end of a ball's trajectory, overwriting its oldest
+/// sample if its ring buffer is full. If the ball is new, make room for
+/// it and all balls before it, which is the only time this allocates.
+/// \param i Ball index.
+/// \param pos Position.
+/// \param flags Bitwise or of TRAJECTORY_MARKER and TRAJECTORY_BREAK.
+
+void CTrajectory::Add(UINT i, const Vector2& pos, UINT flags){
+  if(i >= m_stdCount.size()){ //new ball
+    m_stdSample.resize((i + 1)*TRAJECTORY_SIZE);
+    m_stdHead.resize(i + 1, 0);
+    m_stdCount.resize(i + 1, 0);
+  } //if
+
+  UINT& head = m_stdHead[i]; //shorthand
+  UINT& count = m_stdCount[i]; //shorthand
+
+  CTrajectorySample& s = m_stdSample[i*TRAJECTORY_SIZE + (head + count)%TRAJECTORY_SIZE];
+  s.m_vPos = pos;
+  s.m_nFlags = flags;
+
+  if(count < TRAJECTORY_SIZE)count++;
+  else head = (head + 1)%TRAJECTORY_SIZE; //overwrote the oldest
+} //Add
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Reader functions.
+
+/// Reader function for the number of balls.
+/// \return Number of balls.
+
+const UINT CTrajectory::GetNumBalls() const{
+  return (UINT)m_stdCount.size();
+} //GetNumBalls
+
+/// Reader function for the number of samples kept for a ball.
+/// \param i Ball index, must be less than the number of balls.
+/// \return Number of samples, at most TRAJECTORY_SIZE.
+
+const UINT CTrajectory::GetCount(UINT i) const{
+  return m_stdCount[i];
+} //GetCount
+
+/// Reader function for a sample, counting from the oldest one kept.
+/// \param i Ball index, must be less than the number of balls.
+/// \param k Sample index, must be less than the ball's number of samples.
+/// \return Reference to the sample.
+
+const CTrajectorySample& CTrajectory::GetSample(UINT i, UINT k) const{
+  return m_stdSample[i*TRAJECTORY_SIZE + (m_stdHead[i] + k)%TRAJECTORY_SIZE];
+} //GetSample
@@ -0,0 +1,53 @@
+/// \file Trajectory.h
+/// \brief Interface for the trajectory sample record and the trajectory recorder class CTrajectory.
+
+#ifndef __L4RC_GAME_TRAJECTORY_H__
+#define __L4RC_GAME_TRAJECTORY_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+
+const UINT TRAJECTORY_SIZE = 512; ///< Number of samples kept per ball, about 17 seconds of steps.
+const UINT TRAJECTORY_MARKER = 1; ///< Sample flag for the position of a ball at a collision.
+const UINT TRAJECTORY_BREAK = 2; ///< Sample flag for the start of a new polyline.
+
+/// \brief Trajectory sample.
+///
+/// Where a ball was, and whether it was in a collision there or a new
+/// polyline starts there.
+
+class CTrajectorySample{
+  public:
+    Vector2 m_vPos; ///< Position.
+    UINT m_nFlags = 0; ///< Bitwise or of TRAJECTORY_MARKER and TRAJECTORY_BREAK.
+}; //CTrajectorySample
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Trajectory recorder.
+///
+/// The positions of the balls in Step Mode, kept in one fixed-size ring
+/// buffer of `TRAJECTORY_SIZE` samples per ball, all in a single array that
+/// is allocated when the number of balls changes. When a ball's buffer is
+/// full, each new sample overwrites its oldest one, so the memory used and
+/// the cost of drawing the trajectories are bounded however long a shot
+/// takes. This replaces dropping a particle per ball per step, which could
+/// leave tens of thousands of live particles behind a long shot.
+
+class CTrajectory{
+  private:
+    std::vector<CTrajectorySample> m_stdSample; ///< Ring buffers, one after the other.
+    std::vector<UINT> m_stdHead; ///< Index of each ball's oldest sample in its ring buffer.
+    std::vector<UINT> m_stdCount; ///< Number of samples in each ball's ring buffer.
+
+  public:
+    void Clear(UINT); ///< Clear and set the number of balls.
+    void Add(UINT, const Vector2&, UINT=0); ///< Add a sample.
+
+    const UINT GetNumBalls() const; ///< Get number of balls.
+    const UINT GetCount(UINT) const; ///< Get number of samples for a ball.
+    const CTrajectorySample& GetSample(UINT, UINT) const; ///< Get a sample.
+}; //CTrajectory
+
+#endif //__L4RC_GAME_TRAJECTORY_H__
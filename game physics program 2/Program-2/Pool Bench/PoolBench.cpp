@@ -0,0 +1,286 @@
+/// \file PoolBench.cpp
+/// \brief A command line benchmark for the pool physics.
+///
+/// The pool physics uses only the standard library and `PoolDefines.h`, so
+/// this builds on any platform without the LARC Engine, for instance on Linux
+/// with
+///
+///     g++ -O2 -std=c++17 "-I../My Game" PoolBench.cpp "../My Game/PoolSim.cpp" "../My Game/FrameSolver.cpp" -o poolbench
+///
+/// and runs as `poolbench [shots] [seed]`, default 10000 shots with seed 1.
+/// It makes that many randomized break shots into a full rack and the same
+/// number of randomized cut shots of one object ball, on the game's table,
+/// and runs each of them to rest twice: with the event-driven simulator,
+/// `CPoolSim::RunToRest()`, which goes straight from event to event, and with
+/// the frame solver, `CFrameSolver`, one 60 fps frame at a time. For each kind
+/// of shot and each way of running it, it prints the number of shots run to
+/// rest per second of CPU time, and the number of events and the seconds of
+/// play per shot. It also prints how many of the shots come to rest with
+/// every ball within a pixel of where the other way put it.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "PoolSim.h"
+#include "FrameSolver.h"
+
+const float WIN_WIDTH = 1024.0f; ///< Window width, as in gamesettings.xml.
+const float WIN_HEIGHT = 531.0f; ///< Window height, as in gamesettings.xml.
+const float X_MARGIN = 78.0f; ///< Horizontal margin, as in Common.cpp.
+const float Y_MARGIN = 64.0f; ///< Vertical margin, as in Common.cpp.
+const float BALL_RADIUS = 16.0f; ///< Radius of cue-ball sprite.
+const float EIGHTBALL_RADIUS = 15.5f; ///< Radius of 8-ball sprite.
+const float FRAME_TIME = 1.0f/60.0f; ///< Frame time for the frame solver.
+const UINT MAX_FRAMES = 100000; ///< Give up on a shot after this many frames.
+
+/// \brief Shot result.
+///
+/// Totals over a batch of shots run to rest.
+
+class CShotResult{
+  public:
+    double m_fSeconds = 0; ///< CPU time taken in seconds.
+    double m_fPlay = 0; ///< Total time of play in seconds.
+    size_t m_nEvents = 0; ///< Total number of events.
+    std::vector<std::vector<CPoolBall>> m_stdRest; ///< Balls at rest after each shot.
+}; //CShotResult
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Get the table that the game uses, from the window size, margins, and
+/// pocket positions in the game settings and `Common.cpp`.
+/// \return The table.
+
+static const CPoolTable GetTable(){
+  CPoolTable t;
+  t.m_fLeft = X_MARGIN;
+  t.m_fRight = WIN_WIDTH - X_MARGIN;
+  t.m_fBottom = Y_MARGIN;
+  t.m_fTop = WIN_HEIGHT - Y_MARGIN;
+
+  t.m_vPocket[0] = Vector2(71, 478);
+  t.m_vPocket[1] = Vector2(514, 478);
+  t.m_vPocket[2] = Vector2(955, 478);
+  t.m_vPocket[3] = Vector2(71, 53);
+  t.m_vPocket[4] = Vector2(514, 48);
+  t.m_vPocket[5] = Vector2(955, 53);
+
+  return t;
+} //GetTable
+
+/// Make a ball at rest.
+/// \param pos Position.
+/// \param r Radius.
+/// \return The ball.
+
+static const CPoolBall MakeBall(const Vector2& pos, float r){
+  CPoolBall b;
+  b.m_vPos = pos;
+  b.m_fRadius = r;
+  return b;
+} //MakeBall
+
+/// Make a randomized break shot: a full rack laid out as in
+/// `CObjectManager::CreateRack()`, and the cue ball somewhere on the base
+/// line, shot at the apex ball give or take a little, with a random impulse.
+/// The cue ball is last.
+/// \param rng Random number generator.
+/// \return The balls.
+
+static const std::vector<CPoolBall> MakeBreak(std::mt19937& rng){
+  std::uniform_real_distribution<float> u(0.0f, 1.0f);
+  std::vector<CPoolBall> balls;
+
+  const float mid = WIN_HEIGHT/2.0f; //half window height
+  const Vector2 apex(732.0f, mid); //apex of rack
+  const float dy = 2.0f*BALL_RADIUS + 1.0f; //distance between balls in a row
+  const float dx = dy*sqrtf(3.0f)/2.0f; //distance between rows
+
+  for(UINT row=0; row<5; row++)
+    for(UINT i=0; i<=row; i++){
+      const float r = row == 2 && i == 1? EIGHTBALL_RADIUS: BALL_RADIUS; //radius
+      balls.push_back(MakeBall(apex + Vector2(row*dx, (i - row/2.0f)*dy), r));
+    } //for
+
+  CPoolBall cue = MakeBall(Vector2(295.0f, mid + 100.0f*(2.0f*u(rng) - 1.0f)), BALL_RADIUS);
+  const Vector2 d = apex - cue.m_vPos; //toward apex
+  const float a = atan2f(d.y, d.x) + 0.02f*(2.0f*u(rng) - 1.0f); //cue angle
+  cue.m_vVel = POOL_IMPULSE*(0.8f + 0.8f*u(rng))*Vector2(cosf(a), sinf(a));
+  balls.push_back(cue);
+
+  return balls;
+} //MakeBreak
+
+/// Make a randomized cut shot: an object ball and the cue ball anywhere on
+/// the table, at least four radii apart, with the cue ball aimed to hit the
+/// object ball off center by up to 90% of the sum of their radii, with a
+/// random impulse. The cue ball is last.
+/// \param rng Random number generator.
+/// \return The balls.
+
+static const std::vector<CPoolBall> MakeCut(std::mt19937& rng){
+  std::uniform_real_distribution<float> u(0.0f, 1.0f);
+  const CPoolTable t = GetTable();
+  const float r = BALL_RADIUS; //shorthand
+
+  auto onTable = [&](){ //random position on the table away from the pockets
+    return Vector2(t.m_fLeft + 2.0f*r + u(rng)*(t.m_fRight - t.m_fLeft - 4.0f*r),
+      t.m_fBottom + 2.0f*r + u(rng)*(t.m_fTop - t.m_fBottom - 4.0f*r));
+  }; //onTable
+
+  CPoolBall obj = MakeBall(onTable(), r);
+  CPoolBall cue = MakeBall(onTable(), r);
+
+  while(Vector2::Distance(obj.m_vPos, cue.m_vPos) < 4.0f*r)
+    cue.m_vPos = onTable();
+
+  Vector2 d = obj.m_vPos - cue.m_vPos; //toward object ball
+  d.Normalize();
+  const Vector2 aim = obj.m_vPos + 1.8f*r*(2.0f*u(rng) - 1.0f)*Vector2(-d.y, d.x); //point aimed at
+
+  Vector2 v = aim - cue.m_vPos; //cue direction
+  v.Normalize();
+  cue.m_vVel = POOL_IMPULSE*(0.4f + 1.2f*u(rng))*v;
+
+  return std::vector<CPoolBall>{obj, cue};
+} //MakeCut
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Run shots to rest with the event-driven simulator.
+/// \param table Table.
+/// \param shots Balls at the start of each shot.
+/// \return Results.
+
+static const CShotResult RunSim(const CPoolTable& table, const std::vector<std::vector<CPoolBall>>& shots){
+  CShotResult result;
+  result.m_stdRest.resize(shots.size());
+
+  CPoolSim sim;
+  sim.SetTable(table);
+  const auto t0 = std::chrono::steady_clock::now(); //start time
+
+  for(size_t k=0; k<shots.size(); k++){
+    sim.Begin(shots[k]);
+    result.m_fPlay += sim.RunToRest();
+    result.m_nEvents += sim.GetEvents().size();
+
+    std::vector<CPoolBall>& rest = result.m_stdRest[k]; //shorthand
+
+    for(UINT i=0; i<sim.GetNumBalls(); i++)
+      rest.push_back(sim.GetBall(i));
+  } //for
+
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  result.m_fSeconds = t.count();
+  return result;
+} //RunSim
+
+/// Run shots to rest with the frame solver, a frame at a time.
+/// \param table Table.
+/// \param shots Balls at the start of each shot.
+/// \return Results.
+
+static const CShotResult RunSolver(const CPoolTable& table, const std::vector<std::vector<CPoolBall>>& shots){
+  CShotResult result;
+  result.m_stdRest.resize(shots.size());
+
+  CFrameSolver solver;
+  const auto t0 = std::chrono::steady_clock::now(); //start time
+
+  for(size_t k=0; k<shots.size(); k++){
+    std::vector<CPoolBall>& balls = result.m_stdRest[k]; //shorthand
+    balls = shots[k];
+
+    auto moving = [&](){ //whether any ball is moving
+      return std::any_of(balls.begin(), balls.end(),
+        [](const CPoolBall& b){return b.m_vVel != Vector2::Zero;});
+    }; //moving
+
+    for(UINT frame=0; frame<MAX_FRAMES && moving(); frame++){
+      solver.Solve(table, balls, FRAME_TIME);
+      result.m_nEvents += solver.GetEvents().size();
+      result.m_fPlay += FRAME_TIME;
+    } //for
+  } //for
+
+  const std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  result.m_fSeconds = t.count();
+  return result;
+} //RunSolver
+
+/// Count the shots whose balls came to rest within a pixel of each other
+/// both ways, and in the same pockets.
+/// \param a Results one way.
+/// \param b Results the other way.
+/// \return Number of shots that agree.
+
+static size_t CountAgreed(const CShotResult& a, const CShotResult& b){
+  size_t n = 0; //number of shots that agree
+
+  for(size_t k=0; k<a.m_stdRest.size(); k++){
+    bool agree = true; //whether this shot agrees
+
+    for(size_t i=0; i<a.m_stdRest[k].size() && agree; i++){
+      const CPoolBall& p = a.m_stdRest[k][i]; //shorthand
+      const CPoolBall& q = b.m_stdRest[k][i]; //shorthand
+      agree = p.m_bInPocket == q.m_bInPocket && Vector2::Distance(p.m_vPos, q.m_vPos) < 1.0f;
+    } //for
+
+    if(agree)n++;
+  } //for
+
+  return n;
+} //CountAgreed
+
+/// Print a line of results.
+/// \param name What was run.
+/// \param r Results.
+/// \param n Number of shots.
+
+static void Print(const char* name, const CShotResult& r, size_t n){
+  printf("%-26s %9.0f shots/s  %6.2f us/shot  %5.1f events/shot  %5.2f s of play/shot\n",
+    name, n/r.m_fSeconds, 1.0e6*r.m_fSeconds/n, double(r.m_nEvents)/n, r.m_fPlay/n);
+} //Print
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Make the shots, run them to rest both ways, and print the results.
+/// \param argc Number of command line arguments.
+/// \param argv Command line arguments.
+/// \return 0 for success.
+
+int main(int argc, char* argv[]){
+  const size_t n = argc > 1? std::max(1, atoi(argv[1])): 10000; //number of shots of each kind
+  const unsigned seed = argc > 2? (unsigned)atoi(argv[2]): 1; //random number seed
+
+  std::mt19937 rng(seed);
+  const CPoolTable table = GetTable();
+
+  std::vector<std::vector<CPoolBall>> breaks(n), cuts(n); //initial balls for each shot
+
+  for(size_t k=0; k<n; k++){
+    breaks[k] = MakeBreak(rng);
+    cuts[k] = MakeCut(rng);
+  } //for
+
+  printf("%zu shots of each kind, seed %u\n", n, seed);
+
+  const CShotResult breaksim = RunSim(table, breaks);
+  const CShotResult breaksolver = RunSolver(table, breaks);
+  Print("break, event-driven", breaksim, n);
+  Print("break, frame solver", breaksolver, n);
+  printf("%-26s %zu of %zu\n", "break, agreed", CountAgreed(breaksim, breaksolver), n);
+
+  const CShotResult cutsim = RunSim(table, cuts);
+  const CShotResult cutsolver = RunSolver(table, cuts);
+  Print("cut, event-driven", cutsim, n);
+  Print("cut, frame solver", cutsolver, n);
+  printf("%-26s %zu of %zu\n", "cut, agreed", CountAgreed(cutsim, cutsolver), n);
+
+  return 0;
+} //main
@@ -0,0 +1,98 @@
+/// \file BatchRunner.cpp
+/// \brief Code for the batch runner class CBatchRunner.
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "BatchRunner.h"
+
+/// Play one ball in each of a batch of table worlds on a pool of threads.
+/// Each world takes the default time step and gravity when it is made.
+/// \param n Number of worlds.
+/// \param nThreads Number of threads, zero for one per core.
+/// \param seed Random number seed for the first world.
+/// \param tmax Time limit for each world in seconds.
+
+void CBatchRunner::Run(UINT n, UINT nThreads, UINT seed, float tmax){
+  m_stdResults.clear();
+  m_stdResults.resize(n);
+
+  if(nThreads == 0)
+    nThreads = std::max(1U, std::thread::hardware_concurrency());
+  nThreads = std::min(nThreads, std::max(1U, n));
+
+  std::atomic<UINT> next(0); //index of next world
+
+  auto work = [&](){
+    for(UINT i=next++; i<n; i=next++){
+      CTableWorld world(seed + i);
+      world.Run(tmax, m_stdResults[i]);
+    } //for
+  }; //work
+
+  const auto t0 = std::chrono::steady_clock::now(); //start time
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+
+  for(UINT i=0; i<nThreads; i++)
+    threads.emplace_back(work);
+
+  for(auto& t: threads)
+    t.join();
+
+  const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - t0;
+  m_fElapsed = elapsed.count();
+} //Run
+
+/// Save the results as comma-separated values, one line per world with its
+/// seed, score, whether it drained, the time, and then the number of scoring
+/// hits on each object.
+/// \param name File name.
+/// \return true if the file was saved.
+
+bool CBatchRunner::Save(const wchar_t* name) const{
+  std::string s = "seed,score,drained,time"; //file contents
+
+  const size_t nHits = m_stdResults.empty()? 0: m_stdResults[0].m_stdHits.size();
+
+  for(size_t i=0; i<nHits; i++)
+    s += ",hit" + std::to_string(i);
+
+  s += "\n";
+
+  for(auto const& r: m_stdResults){
+    s += std::to_string(r.m_nSeed) + "," + std::to_string(r.m_nScore) + "," + 
+      (r.m_bDrained? "1": "0") + "," + std::to_string(r.m_fDrainTime);
+
+    for(auto const& h: r.m_stdHits)
+      s += "," + std::to_string(h);
+
+    s += "\n";
+  } //for
+
+  HANDLE hFile = CreateFileW(name, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(hFile == INVALID_HANDLE_VALUE)return false;
+
+  DWORD written = 0; //number of bytes written
+  const BOOL ok = WriteFile(hFile, s.data(), (DWORD)s.size(), &written, nullptr);
+  CloseHandle(hFile);
+
+  return ok && written == s.size();
+} //Save
+
+/// Reader function for the results.
+/// \return Results of the last batch, one for each world.
+
+const std::vector<CWorldResult>& CBatchRunner::GetResults() const{
+  return m_stdResults;
+} //GetResults
+
+/// Reader function for the elapsed time.
+/// \return Wall clock time taken by the last batch in seconds.
+
+const float CBatchRunner::GetElapsed() const{
+  return m_fElapsed;
+} //GetElapsed
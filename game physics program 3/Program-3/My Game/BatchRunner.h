@@ -0,0 +1,34 @@
+/// \file BatchRunner.h
+/// \brief Interface for the batch runner class CBatchRunner.
+
+#ifndef __L4RC_GAME_BATCHRUNNER_H__
+#define __L4RC_GAME_BATCHRUNNER_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "TableWorld.h"
+
+/// \brief Batch runner.
+///
+/// Plays one ball in each of a batch of table worlds, for tuning the table.
+/// The worlds are spread over a pool of threads that take the next world
+/// from a shared counter, which is the only thing that the threads share,
+/// so the number of worlds simulated per second goes up with the number of
+/// cores. World `i` uses random number seed `seed + i`, so a batch gives the
+/// same results however many threads it is run on.
+
+class CBatchRunner: public CCommon{
+  private:
+    std::vector<CWorldResult> m_stdResults; ///< Result for each world.
+    float m_fElapsed = 0.0f; ///< Wall clock time taken by last batch in seconds.
+
+  public:
+    void Run(UINT, UINT, UINT, float); ///< Run a batch.
+    bool Save(const wchar_t*) const; ///< Save results.
+
+    const std::vector<CWorldResult>& GetResults() const; ///< Get results.
+    const float GetElapsed() const; ///< Get elapsed time.
+}; //CBatchRunner
+
+#endif //__L4RC_GAME_BATCHRUNNER_H__
@@ -0,0 +1,80 @@
+/// \file Bench.cpp
+/// \brief Code for the benchmark class CBench.
+
+#include <algorithm>
+#include <string>
+
+#include "Bench.h"
+#include "TableWorld.h"
+
+static const UINT BENCH_BALLS[] = {1, 8, 64, 256, 1024}; ///< Numbers of balls to run.
+
+/// Run the benchmark for each number of balls in turn, single-threaded
+/// so that the times aren't disturbed by other worlds.
+/// \param frames Number of frames per run.
+/// \param seed Random number seed.
+
+void CBench::Run(UINT frames, UINT seed){
+  m_stdResults.clear();
+  m_nFrames = frames;
+  m_nSeed = seed;
+
+  for(UINT n: BENCH_BALLS){
+    CBenchResult r;
+    r.m_nBalls = n;
+
+    CTableWorld world(seed);
+    world.AddBalls(n, seed);
+    world.SetProfile(&r.m_cProfile);
+
+    for(UINT i=0; i<frames; i++)
+      world.move();
+
+    world.SetProfile(nullptr);
+    m_stdResults.push_back(r);
+  } //for
+} //Run
+
+/// Save the results as JSON, with the time per frame spent in each part of
+/// `CObjectManager::move()` in nanoseconds and the number of shape pairs
+/// tested per frame, for each number of balls.
+/// \param name File name.
+/// \return true if the file was saved.
+
+bool CBench::Save(const wchar_t* name) const{
+  std::string s = "{\n  \"frames\": " + std::to_string(m_nFrames) + 
+    ",\n  \"seed\": " + std::to_string(m_nSeed) + ",\n  \"runs\": ["; //file contents
+
+  for(size_t i=0; i<m_stdResults.size(); i++){
+    const CMoveProfile& p = m_stdResults[i].m_cProfile; //shorthand
+    const UINT64 n = std::max(1U, p.m_nFrames); //number of frames
+    const UINT64 total = p.m_nMotion + p.m_nBroad + p.m_nNarrow + p.m_nUpdate; //total time
+
+    s += std::string(i == 0? "\n": ",\n") + 
+      "    {\"balls\": " + std::to_string(m_stdResults[i].m_nBalls) +
+      ", \"motion_ns\": " + std::to_string(p.m_nMotion/n) +
+      ", \"broad_ns\": " + std::to_string(p.m_nBroad/n) +
+      ", \"narrow_ns\": " + std::to_string(p.m_nNarrow/n) +
+      ", \"update_ns\": " + std::to_string(p.m_nUpdate/n) +
+      ", \"total_ns\": " + std::to_string(total/n) +
+      ", \"pairs\": " + std::to_string(p.m_nPairs/n) + "}";
+  } //for
+
+  s += "\n  ]\n}\n";
+
+  HANDLE hFile = CreateFileW(name, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(hFile == INVALID_HANDLE_VALUE)return false;
+
+  DWORD written = 0; //number of bytes written
+  const BOOL ok = WriteFile(hFile, s.data(), (DWORD)s.size(), &written, nullptr);
+  CloseHandle(hFile);
+
+  return ok && written == s.size();
+} //Save
+
+/// Reader function for the results.
+/// \return Results of the last run, one for each number of balls.
+
+const std::vector<CBenchResult>& CBench::GetResults() const{
+  return m_stdResults;
+} //GetResults
@@ -0,0 +1,43 @@
+/// \file Bench.h
+/// \brief Interface for the benchmark result class CBenchResult and the benchmark class CBench.
+
+#ifndef __L4RC_GAME_BENCH_H__
+#define __L4RC_GAME_BENCH_H__
+
+#include <vector>
+
+#include "Common.h"
+#include "Profile.h"
+
+/// \brief Benchmark result.
+///
+/// The move profile for one number of balls.
+
+class CBenchResult{
+  public:
+    UINT m_nBalls = 0; ///< Number of balls.
+    CMoveProfile m_cProfile; ///< Move profile.
+}; //CBenchResult
+
+/// \brief Benchmark.
+///
+/// Measures how `CObjectManager::move()` scales with the number of balls.
+/// For each of 1, 8, 64, 256, and 1024 balls it makes a fresh table world,
+/// adds that many balls at random, and moves it for a fixed number of frames
+/// with a move profile attached. The same seed gives the same balls, so runs
+/// on different builds can be compared.
+
+class CBench: public CCommon{
+  private:
+    std::vector<CBenchResult> m_stdResults; ///< Result for each number of balls.
+    UINT m_nFrames = 0; ///< Number of frames per run.
+    UINT m_nSeed = 0; ///< Random number seed.
+
+  public:
+    void Run(UINT, UINT); ///< Run the benchmark.
+    bool Save(const wchar_t*) const; ///< Save results.
+
+    const std::vector<CBenchResult>& GetResults() const; ///< Get results.
+}; //CBench
+
+#endif //__L4RC_GAME_BENCH_H__
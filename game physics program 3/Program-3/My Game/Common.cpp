@@ -15,6 +15,3 @@ UINT CCommon::m_nCIterations = 1;
 float CCommon::m_fFrequency = 60.0f*m_nMIterations; 
 
 eDrawMode CCommon::m_eDrawMode = eDrawMode::Background;
-
-bool CCommon::m_bBallInPlay = false; 
-UINT CCommon::m_nScore = 0; 
@@ -34,8 +34,6 @@ class CCommon: public CShapeCommon{
     static float m_fFrequency; ///< Frequency, number of physics iterations per second.
     
     static eDrawMode m_eDrawMode;  ///< Draw mode.
-    static bool m_bBallInPlay; ///< Is there a ball currently in play?
-    static UINT m_nScore; ///< Current score.
 }; //CCommon
 
 #endif //__L4RC_GAME_COMMON_H__
@@ -0,0 +1,257 @@
+/// \file DrawList.cpp
+/// \brief Code for the draw list class CDrawList.
+
+#include <algorithm>
+#include <fstream>
+#include <type_traits>
+
+#include "DrawList.h"
+
+static_assert(sizeof(CDrawHeader) == 20, "draw list header layout has changed");
+static_assert(sizeof(CDrawCommand) == 20, "draw command layout has changed");
+static_assert(std::is_trivially_copyable<CDrawCommand>::value, "draw commands must be trivially copyable");
+
+/// Compare draw commands by their bytes, which is all that sorting
+/// them to find identical ones needs.
+/// \param a A draw command.
+/// \param b Another draw command.
+/// \return true if a comes before b.
+
+static bool CommandLess(const CDrawCommand& a, const CDrawCommand& b){
+  return memcmp(&a, &b, sizeof(CDrawCommand)) < 0;
+} //CommandLess
+
+/// Get the sprite that a command draws with, counting the font as a sprite.
+/// \param c A draw command.
+/// \return Sprite number, or DRAWLIST_TEXT for text.
+
+static uint16_t CommandSprite(const CDrawCommand& c){
+  return c.m_nType == (uint8_t)eDrawCmd::Text? DRAWLIST_TEXT: c.m_nSprite;
+} //CommandSprite
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Recording functions.
+
+/// Throw away everything that has been recorded.
+
+void CDrawList::Clear(){
+  m_stdFrames.clear();
+  m_stdCommands.clear();
+  m_stdText.clear();
+} //Clear
+
+/// Start a new frame. Commands recorded after this belong to it.
+
+void CDrawList::BeginFrame(){
+  CDrawFrame f;
+  f.m_nFirst = (uint32_t)m_stdCommands.size();
+  f.m_nText = (uint32_t)m_stdText.size();
+  m_stdFrames.push_back(f);
+} //BeginFrame
+
+/// Add a command to the current frame, starting the first frame
+/// if it hasn't been started.
+/// \param t Command type.
+/// \param sprite Sprite number.
+/// \param x Position x coordinate.
+/// \param y Position y coordinate.
+/// \param a0 First argument.
+/// \param a1 Second argument.
+
+void CDrawList::Push(eDrawCmd t, uint16_t sprite, float x, float y, float a0, float a1){
+  if(m_stdFrames.empty())
+    BeginFrame();
+
+  CDrawCommand c;
+  c.m_nType = (uint8_t)t;
+  c.m_nPadding = 0;
+  c.m_nSprite = sprite;
+  c.m_fX = x;
+  c.m_fY = y;
+  c.m_fArg0 = a0;
+  c.m_fArg1 = a1;
+  m_stdCommands.push_back(c);
+} //Push
+
+/// Record a sprite being drawn.
+/// \param sprite Sprite number.
+/// \param x Position x coordinate.
+/// \param y Position y coordinate.
+/// \param roll Orientation.
+
+void CDrawList::Sprite(uint16_t sprite, float x, float y, float roll){
+  Push(eDrawCmd::Sprite, sprite, x, y, roll, 0.0f);
+} //Sprite
+
+/// Record a line being drawn.
+/// \param sprite Sprite number.
+/// \param x0 Start point x coordinate.
+/// \param y0 Start point y coordinate.
+/// \param x1 End point x coordinate.
+/// \param y1 End point y coordinate.
+
+void CDrawList::Line(uint16_t sprite, float x0, float y0, float x1, float y1){
+  Push(eDrawCmd::Line, sprite, x0, y0, x1, y1);
+} //Line
+
+/// Record text being drawn.
+/// \param text Null-terminated text.
+/// \param x Position x coordinate.
+/// \param y Position y coordinate.
+
+void CDrawList::Text(const char* text, float x, float y){
+  Push(eDrawCmd::Text, DRAWLIST_TEXT, x, y, 0.0f, 0.0f);
+  m_stdText.insert(m_stdText.end(), text, text + strlen(text) + 1);
+} //Text
+
+///////////////////////////////////////////////////////////////////////////////////////
+// File functions.
+
+/// Save to a draw list file.
+/// \param name File name.
+/// \return true if it was saved.
+
+bool CDrawList::Save(const char* name) const{
+  CDrawHeader h;
+  h.m_nMagic = DRAWLIST_MAGIC;
+  h.m_nVersion = DRAWLIST_VERSION;
+  h.m_nNumFrames = (uint32_t)m_stdFrames.size();
+  h.m_nNumCommands = (uint32_t)m_stdCommands.size();
+  h.m_nTextSize = (uint32_t)m_stdText.size();
+
+  std::ofstream f(name, std::ios::binary);
+  if(!f)return false;
+
+  f.write((const char*)&h, sizeof(h));
+  f.write((const char*)m_stdFrames.data(), h.m_nNumFrames*sizeof(CDrawFrame));
+  f.write((const char*)m_stdCommands.data(), h.m_nNumCommands*sizeof(CDrawCommand));
+  f.write(m_stdText.data(), h.m_nTextSize);
+  f.close();
+
+  return !f.fail();
+} //Save
+
+/// Load from a draw list file. Every frame is checked against its
+/// commands and text, so that playing it back can't run off the end.
+/// \param name File name.
+/// \return true if it was loaded, otherwise the draw list is left empty.
+
+bool CDrawList::Load(const char* name){
+  Clear();
+
+  std::ifstream f(name, std::ios::binary);
+  if(!f)return false;
+
+  CDrawHeader h = {};
+  f.read((char*)&h, sizeof(h));
+  bool ok = f && h.m_nMagic == DRAWLIST_MAGIC && h.m_nVersion == DRAWLIST_VERSION;
+
+  if(ok){
+    m_stdFrames.resize(h.m_nNumFrames);
+    m_stdCommands.resize(h.m_nNumCommands);
+    m_stdText.resize(h.m_nTextSize);
+
+    f.read((char*)m_stdFrames.data(), h.m_nNumFrames*sizeof(CDrawFrame));
+    f.read((char*)m_stdCommands.data(), h.m_nNumCommands*sizeof(CDrawCommand));
+    f.read(m_stdText.data(), h.m_nTextSize);
+    ok = !f.fail();
+  } //if
+
+  uint32_t text = 0; //offset of next string
+  uint32_t frame = 0; //next frame to start
+
+  for(uint32_t i=0; ok && i<=h.m_nNumCommands; i++){
+    while(ok && frame < h.m_nNumFrames && m_stdFrames[frame].m_nFirst == i)
+      ok = m_stdFrames[frame++].m_nText == text;
+
+    if(ok && i < h.m_nNumCommands){
+      const CDrawCommand& c = m_stdCommands[i]; //shorthand
+      ok = c.m_nType < (uint8_t)eDrawCmd::Size && frame > 0;
+
+      if(ok && c.m_nType == (uint8_t)eDrawCmd::Text){
+        const char* p = m_stdText.data() + text; //start of string
+        const void* end = memchr(p, 0, h.m_nTextSize - text); //end of string
+        ok = end != nullptr;
+        if(ok)text += uint32_t((const char*)end - p) + 1;
+      } //if
+    } //if
+  } //for
+
+  if(!ok || frame != h.m_nNumFrames || text != h.m_nTextSize){
+    Clear();
+    return false;
+  } //if
+
+  return true;
+} //Load
+
+///////////////////////////////////////////////////////////////////////////////////////
+// Reader functions.
+
+/// Reader function for the number of frames.
+/// \return Number of frames recorded.
+
+uint32_t CDrawList::GetNumFrames() const{
+  return (uint32_t)m_stdFrames.size();
+} //GetNumFrames
+
+/// Reader function for the number of commands.
+/// \return Number of commands recorded.
+
+size_t CDrawList::GetNumCommands() const{
+  return m_stdCommands.size();
+} //GetNumCommands
+
+/// Get the size of the recording in memory, which give or take
+/// the header is also its size on disk.
+/// \return Size in bytes.
+
+size_t CDrawList::GetSize() const{
+  return m_stdFrames.size()*sizeof(CDrawFrame) +
+    m_stdCommands.size()*sizeof(CDrawCommand) + m_stdText.size();
+} //GetSize
+
+/// Count the commands, sprite switches, and redundant draws over all
+/// frames. Redundant draws are found by sorting a copy of each frame's
+/// sprite and line commands and counting the ones equal to their
+/// predecessor, which is linear-logarithmic in the size of a frame.
+/// \return Statistics.
+
+const CDrawStats CDrawList::GetStats() const{
+  CDrawStats s;
+  s.m_nFrames = (uint32_t)m_stdFrames.size();
+  s.m_nCommands = m_stdCommands.size();
+
+  std::vector<CDrawCommand> sorted; //sorted copy of a frame's commands
+
+  for(uint32_t frame=0; frame<s.m_nFrames; frame++){
+    const uint32_t first = m_stdFrames[frame].m_nFirst; //first command
+    const uint32_t last = frame + 1 < s.m_nFrames?
+      m_stdFrames[frame + 1].m_nFirst: (uint32_t)m_stdCommands.size(); //one past last command
+
+    s.m_nMaxCommands = std::max(s.m_nMaxCommands, last - first);
+    sorted.clear();
+
+    for(uint32_t i=first; i<last; i++){
+      const CDrawCommand& c = m_stdCommands[i]; //shorthand
+
+      switch((eDrawCmd)c.m_nType){
+        case eDrawCmd::Sprite: s.m_nSprites++; sorted.push_back(c); break;
+        case eDrawCmd::Line: s.m_nLines++; sorted.push_back(c); break;
+        case eDrawCmd::Text: s.m_nTexts++; break;
+        default: break;
+      } //switch
+
+      if(i > first && CommandSprite(c) != CommandSprite(m_stdCommands[i - 1]))
+        s.m_nSwitches++;
+    } //for
+
+    std::sort(sorted.begin(), sorted.end(), CommandLess);
+
+    for(size_t i=1; i<sorted.size(); i++)
+      if(memcmp(&sorted[i], &sorted[i - 1], sizeof(CDrawCommand)) == 0)
+        s.m_nRedundant++;
+  } //for
+
+  return s;
+} //GetStats
@@ -0,0 +1,163 @@
+/// \file DrawList.h
+/// \brief Interface for the draw list records and the draw list class CDrawList.
+
+#ifndef __L4RC_GAME_DRAWLIST_H__
+#define __L4RC_GAME_DRAWLIST_H__
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+const char DRAWLIST_FILE[] = "drawlist.bin"; ///< Draw list file name.
+
+const uint32_t DRAWLIST_MAGIC = 0x4C574450; ///< Draw list file magic number, "PDWL" in little-endian.
+const uint32_t DRAWLIST_VERSION = 1; ///< Draw list file format version.
+const uint16_t DRAWLIST_TEXT = 0xFFFF; ///< Sprite number that stands for the font in text commands.
+
+/// \brief Draw command type.
+///
+/// An enumerated type for the renderer calls that a draw list records.
+/// `Size` must be last.
+
+enum class eDrawCmd: uint8_t{
+  Sprite, Line, Text,
+  Size //MUST be last
+}; //eDrawCmd
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Draw list file header.
+///
+/// A draw list file is this header followed by the frame records, then
+/// the command records, and then the text.
+
+class CDrawHeader{
+  public:
+    uint32_t m_nMagic; ///< Magic number, must be DRAWLIST_MAGIC.
+    uint32_t m_nVersion; ///< Format version, must be DRAWLIST_VERSION.
+    uint32_t m_nNumFrames; ///< Number of frame records.
+    uint32_t m_nNumCommands; ///< Number of command records.
+    uint32_t m_nTextSize; ///< Size of text in bytes.
+}; //CDrawHeader
+
+/// \brief Draw command.
+///
+/// One renderer call in 20 bytes. Only the sprite, position, and orientation
+/// are recorded, not the sprite descriptor's frame, scale, tint, or alpha,
+/// nor the color of text. The text for a text command isn't stored here, it
+/// is the next string in the frame's text.
+
+class CDrawCommand{
+  public:
+    uint8_t m_nType; ///< Command type, an eDrawCmd.
+    uint8_t m_nPadding; ///< Unused, zero.
+    uint16_t m_nSprite; ///< Sprite, an eSprite, or DRAWLIST_TEXT for text.
+    float m_fX; ///< Position, or start point of a line.
+    float m_fY; ///< Position, or start point of a line.
+    float m_fArg0; ///< Orientation of a sprite, or end point of a line.
+    float m_fArg1; ///< End point of a line, otherwise zero.
+}; //CDrawCommand
+
+/// \brief Draw list frame.
+///
+/// Where a frame's commands and text start.
+
+class CDrawFrame{
+  public:
+    uint32_t m_nFirst; ///< Index of first command.
+    uint32_t m_nText; ///< Offset of first string of text.
+}; //CDrawFrame
+
+/// \brief Draw list statistics.
+///
+/// Totals over all frames of a draw list. A sprite switch is a command
+/// whose sprite differs from the one before it in the same frame, which
+/// in batched mode can cost a batch. A redundant draw is a sprite or line
+/// command that is identical to an earlier one in the same frame, so it
+/// draws over itself to no effect.
+
+class CDrawStats{
+  public:
+    uint32_t m_nFrames = 0; ///< Number of frames.
+    uint64_t m_nCommands = 0; ///< Number of commands.
+    uint64_t m_nSprites = 0; ///< Number of sprite commands.
+    uint64_t m_nLines = 0; ///< Number of line commands.
+    uint64_t m_nTexts = 0; ///< Number of text commands.
+    uint64_t m_nSwitches = 0; ///< Number of sprite switches.
+    uint64_t m_nRedundant = 0; ///< Number of redundant draws.
+    uint32_t m_nMaxCommands = 0; ///< Largest number of commands in a frame.
+}; //CDrawStats
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Draw list.
+///
+/// A recording of the calls made to the renderer, frame by frame, as a flat
+/// array of fixed-size commands with the text kept separately. Recording a
+/// call costs a `push_back`, and once the arrays have grown to fit, nothing.
+/// This file uses only the standard library, not the LARC Engine or Windows,
+/// so that draw lists recorded by the game can be examined and played back
+/// on any platform.
+
+class CDrawList{
+  private:
+    std::vector<CDrawFrame> m_stdFrames; ///< Frame records.
+    std::vector<CDrawCommand> m_stdCommands; ///< Command records.
+    std::vector<char> m_stdText; ///< Text, as null-terminated strings.
+
+    void Push(eDrawCmd, uint16_t, float, float, float, float); ///< Add a command.
+
+  public:
+    void Clear(); ///< Clear.
+    void BeginFrame(); ///< Start a new frame.
+
+    void Sprite(uint16_t, float, float, float); ///< Record a sprite.
+    void Line(uint16_t, float, float, float, float); ///< Record a line.
+    void Text(const char*, float, float); ///< Record text.
+
+    bool Save(const char*) const; ///< Save to a draw list file.
+    bool Load(const char*); ///< Load from a draw list file.
+
+    template<class T> void Play(T&, uint32_t) const; ///< Play a frame.
+
+    uint32_t GetNumFrames() const; ///< Get number of frames.
+    size_t GetNumCommands() const; ///< Get number of commands.
+    size_t GetSize() const; ///< Get size in bytes.
+    const CDrawStats GetStats() const; ///< Get statistics.
+}; //CDrawList
+
+/// Play one frame of the draw list into a target, which needs the member
+/// functions `PlaySprite(sprite, x, y, roll)`, `PlayLine(sprite, x0, y0,
+/// x1, y1)`, and `PlayText(text, x, y)`.
+/// \param target Target to play into.
+/// \param frame Frame number, must be less than the number of frames.
+
+template<class T> void CDrawList::Play(T& target, uint32_t frame) const{
+  const uint32_t first = m_stdFrames[frame].m_nFirst; //first command
+  const uint32_t last = frame + 1 < m_stdFrames.size()?
+    m_stdFrames[frame + 1].m_nFirst: (uint32_t)m_stdCommands.size(); //one past last command
+  const char* text = m_stdText.data() + m_stdFrames[frame].m_nText; //next string
+
+  for(uint32_t i=first; i<last; i++){
+    const CDrawCommand& c = m_stdCommands[i]; //shorthand
+
+    switch((eDrawCmd)c.m_nType){
+      case eDrawCmd::Sprite:
+        target.PlaySprite(c.m_nSprite, c.m_fX, c.m_fY, c.m_fArg0);
+      break;
+
+      case eDrawCmd::Line:
+        target.PlayLine(c.m_nSprite, c.m_fX, c.m_fY, c.m_fArg0, c.m_fArg1);
+      break;
+
+      case eDrawCmd::Text:
+        target.PlayText(text, c.m_fX, c.m_fY);
+        text += strlen(text) + 1;
+      break;
+
+      default: break;
+    } //switch
+  } //for
+} //Play
+
+#endif //__L4RC_GAME_DRAWLIST_H__
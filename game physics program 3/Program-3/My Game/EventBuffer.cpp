@@ -0,0 +1,153 @@
+/// \file EventBuffer.cpp
+/// \brief Code for the event buffer class CEventBuffer.
+
+#include <cstdint>
+
+#include "EventBuffer.h"
+
+/// Make the ring buffer and a hash table with twice as many slots.
+
+CEventBuffer::CEventBuffer():
+  m_stdEvent(SIZE), m_stdSlotStamp(2*SIZE, 0), m_stdSlotEvent(2*SIZE, 0){
+} //constructor
+
+/// Hash an event's type, shape, and ball into a hash table slot.
+/// \param e An event.
+/// \return Hash table slot index.
+
+UINT CEventBuffer::Hash(const CCollisionEvent& e) const{
+  const uintptr_t a = (uintptr_t)e.m_pShape >> 4; //low bits are alignment
+  const uintptr_t b = (uintptr_t)e.m_pBall >> 4; //low bits are alignment
+
+  const UINT h = (UINT)(a*2654435761U) ^ (UINT)(b*40503U) ^ (UINT)e.m_eType;
+  return (h ^ (h >> 16)) & ((UINT)m_stdSlotStamp.size() - 1);
+} //Hash
+
+/// Find the hash table slot that refers to an event from this frame with the
+/// same type, shape, and ball as a given one, or if there isn't one, the
+/// slot that it should go into.
+/// \param e An event.
+/// \return Hash table slot index.
+
+UINT CEventBuffer::FindSlot(const CCollisionEvent& e) const{
+  const UINT mask = (UINT)m_stdSlotStamp.size() - 1; //for wrapping slot index
+  UINT slot = Hash(e); //hash table slot
+
+  while(m_stdSlotStamp[slot] == m_nStamp){ //slot used this frame
+    const CCollisionEvent& f = m_stdEvent[m_stdSlotEvent[slot]]; //event that it refers to
+
+    if(f.m_eType == e.m_eType && f.m_pShape == e.m_pShape && f.m_pBall == e.m_pBall)
+      return slot; //duplicate
+
+    slot = (slot + 1) & mask; //linear probe
+  } //while
+
+  return slot;
+} //FindSlot
+
+/// Double the size of the ring buffer and the hash table. The events are
+/// copied oldest first to the start of the new buffer, and the hash table
+/// is rebuilt to refer to them there.
+
+void CEventBuffer::Grow(){
+  const UINT n = (UINT)m_stdEvent.size(); //old size
+  std::vector<CCollisionEvent> events(2*n);
+
+  for(UINT i=0; i<m_nCount; i++)
+    events[i] = m_stdEvent[(m_nHead + i) & (n - 1)];
+
+  m_stdEvent.swap(events);
+  m_nHead = 0;
+
+  m_stdSlotStamp.assign(4*n, 0);
+  m_stdSlotEvent.assign(4*n, 0);
+
+  for(UINT i=0; i<m_nCount; i++){
+    const UINT slot = FindSlot(m_stdEvent[i]);
+
+    if(m_stdSlotStamp[slot] != m_nStamp){ //not already there
+      m_stdSlotStamp[slot] = m_nStamp;
+      m_stdSlotEvent[slot] = i;
+    } //if
+  } //for
+} //Grow
+
+/// Add an event, or if there is already one this frame with the same
+/// type, shape, and ball then keep only the faster of the two.
+/// \param t Event type.
+/// \param pShape Pointer to the shape that the ball hit.
+/// \param pBall Pointer to the ball.
+/// \param poi Point of impact.
+/// \param speed Collision speed.
+
+void CEventBuffer::Push(eEvent t, CShape* pShape, CShape* pBall, const Vector2& poi, float speed){
+  const CCollisionEvent e = {t, pShape, pBall, poi, speed};
+
+  UINT slot = FindSlot(e); //hash table slot
+
+  if(m_stdSlotStamp[slot] == m_nStamp){ //duplicate
+    CCollisionEvent& f = m_stdEvent[m_stdSlotEvent[slot]]; //event that it refers to
+
+    if(speed > f.m_fSpeed){
+      f.m_fSpeed = speed;
+      f.m_vPOI = poi;
+    } //if
+
+    return;
+  } //if
+
+  if(m_nCount == (UINT)m_stdEvent.size()){ //full
+    Grow();
+    slot = FindSlot(e); //hash table has changed
+  } //if
+
+  const UINT i = (m_nHead + m_nCount) & ((UINT)m_stdEvent.size() - 1); //index of new event
+  m_stdEvent[i] = e;
+  m_nCount++;
+
+  m_stdSlotStamp[slot] = m_nStamp;
+  m_stdSlotEvent[slot] = i;
+} //Push
+
+/// Remove the oldest event.
+/// \param e [out] The oldest event.
+/// \return true if there was an event to remove.
+
+bool CEventBuffer::Pop(CCollisionEvent& e){
+  if(m_nCount == 0)return false;
+
+  e = m_stdEvent[m_nHead];
+  m_nHead = (m_nHead + 1) & ((UINT)m_stdEvent.size() - 1);
+  m_nCount--;
+
+  return true;
+} //Pop
+
+/// Start a new frame, after which events are no longer merged with the ones
+/// from the previous frame. This should be called after the events have been
+/// drained, since a hash table slot might otherwise refer to an event that has
+/// been popped and overwritten. If the stamp wraps around to zero then the
+/// slots are cleared so that none of them look used in this frame.
+
+void CEventBuffer::NextFrame(){
+  if(++m_nStamp == 0){ //wrapped around
+    m_stdSlotStamp.assign(m_stdSlotStamp.size(), 0);
+
+    m_nStamp = 1;
+  } //if
+} //NextFrame
+
+/// Reader function for the number of events.
+/// \return Number of events in the buffer.
+
+UINT CEventBuffer::GetCount() const{
+  return m_nCount;
+} //GetCount
+
+/// Reader function for the number of events that fit in the buffer before
+/// it has to grow.
+/// \return Size of the ring buffer.
+
+UINT CEventBuffer::GetCapacity() const{
+  return (UINT)m_stdEvent.size();
+} //GetCapacity
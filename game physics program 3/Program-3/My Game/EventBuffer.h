@@ -0,0 +1,90 @@
+/// \file EventBuffer.h
+/// \brief Interface for the collision event class CCollisionEvent and the event buffer class CEventBuffer.
+
+#ifndef __L4RC_GAME_EVENTBUFFER_H__
+#define __L4RC_GAME_EVENTBUFFER_H__
+
+#include <vector>
+
+#include "Shape.h"
+
+/// \brief Collision event type.
+///
+/// An enumerated type for the things that can happen when a ball collides
+/// with something, or when a flipper reaches the end of its travel.
+/// `Size` must be last.
+
+enum class eEvent: UINT{
+  Hit, BallHit, GateOpen, GateBounce, GateHold, SensorEnter, SensorStay, SensorExit,
+  FlipUp, FlipDown,
+  Size //MUST be last
+}; //eEvent
+
+/// \brief Collision event.
+///
+/// A plain record of a collision, made in the narrow phase so that the
+/// sounds, score, and lights that it causes can be dealt with later.
+
+class CCollisionEvent{
+  public:
+    eEvent m_eType; ///< Event type.
+    CShape* m_pShape; ///< Pointer to the shape that the ball hit.
+    CShape* m_pBall; ///< Pointer to the ball.
+    Vector2 m_vPOI; ///< Point of impact.
+    float m_fSpeed; ///< Collision speed.
+}; //CCollisionEvent
+
+/// \brief Sensor contact.
+///
+/// A sensor and a ball that overlaps it, kept from frame to frame
+/// so that sensors can tell when a ball enters, stays, and exits.
+
+class CSensorContact{
+  public:
+    CShape* m_pSensor; ///< Pointer to sensor.
+    CShape* m_pBall; ///< Pointer to ball.
+    bool m_bSeen; ///< Whether they overlapped in the current frame.
+}; //CSensorContact
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Event buffer.
+///
+/// A ring buffer of collision events. Within a frame, events with the same
+/// type, shape, and ball are merged into one that keeps the highest speed, so
+/// that a collision that is detected in several substeps is dealt with once.
+/// Duplicates are found with an open-addressed hash table whose slots are
+/// stamped with the frame number, so starting a new frame doesn't need to
+/// clear it. If the buffer is full then it and the hash table are doubled in
+/// size, so no event is ever lost. This only happens when there are more
+/// balls than ever before, so once the buffer is big enough nothing more is
+/// allocated.
+
+class CEventBuffer{
+  private:
+    static const UINT SIZE = 256; ///< Initial number of events, must be a power of 2.
+
+    std::vector<CCollisionEvent> m_stdEvent; ///< Ring buffer of events, size a power of 2.
+    UINT m_nHead = 0; ///< Index of oldest event.
+    UINT m_nCount = 0; ///< Number of events in buffer.
+
+    std::vector<UINT> m_stdSlotStamp; ///< Frame stamp of each hash table slot.
+    std::vector<UINT> m_stdSlotEvent; ///< Event index in each hash table slot.
+    UINT m_nStamp = 1; ///< Frame stamp for current frame.
+
+    UINT Hash(const CCollisionEvent&) const; ///< Hash function.
+    UINT FindSlot(const CCollisionEvent&) const; ///< Find hash table slot.
+    void Grow(); ///< Double the size.
+
+  public:
+    CEventBuffer(); ///< Constructor.
+
+    void Push(eEvent, CShape*, CShape*, const Vector2&, float); ///< Add an event.
+    bool Pop(CCollisionEvent&); ///< Remove oldest event.
+    void NextFrame(); ///< Start a new frame.
+
+    UINT GetCount() const; ///< Get number of events.
+    UINT GetCapacity() const; ///< Get number of events that fit.
+}; //CEventBuffer
+
+#endif //__L4RC_GAME_EVENTBUFFER_H__
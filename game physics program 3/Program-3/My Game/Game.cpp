@@ -1,16 +1,21 @@
 /// \file Game.cpp
 /// \brief Code for the game class CGame.
 
+#include <chrono>
+
 #include "Game.h"
 
 #include "GameDefines.h"
 #include "Renderer.h"
 #include "ComponentIncludes.h"
 
+#include "BatchRunner.h"
+#include "Bench.h"
+#include "TableWorld.h"
+
 #include "shellapi.h"
 
 CGame::~CGame(){
-  delete m_pCurBallShape;
   delete m_pRenderer;
   delete m_pObjectManager;
 } //destructor
@@ -53,10 +58,213 @@ void CGame::Initialize(){
   m_pTimer->SetFixedTimeStep();
   m_pTimer->SetFrameTime(1/60.0f);
 
+  ParseCommandLine();
+
   //now start the game
   BeginGame();
+
+  if(m_nBatchSize > 0){ //batch mode
+    RunBatch();
+    PostQuitMessage(0);
+  } //if
+
+  else if(!m_strReplayName.empty()){ //replay mode
+    RunReplay();
+    PostQuitMessage(0);
+  } //else if
+
+  else if(m_nBenchFrames > 0){ //benchmark mode
+    RunBench();
+    PostQuitMessage(0);
+  } //else if
+
+  else if(m_nDrawFrames > 0){ //draw recording mode
+    RunDraw();
+    PostQuitMessage(0);
+  } //else if
 } //Initialize
 
+/// Parse the command line. The option `-export <file>` makes the table
+/// in code and saves it to a table file, which can then be copied to 
+/// `TABLE_FILE` to be loaded instead of making the table in code.
+/// The option `-batch <n>` plays one ball on each of `n` table worlds 
+/// and quits, with options `-threads <n>`, `-seed <n>`, `-seconds <t>`,
+/// and `-out <file>` for the number of threads, the first random number
+/// seed, the time limit for each ball, and the results file.
+/// The option `-replay <file>` plays a replay file headless and quits,
+/// with option `-frame <n>` for the frame to seek to before timing it.
+/// The option `-bench <n>` runs the multiball benchmark for `n` frames
+/// per run, using the seed from `-seed <n>`, and quits.
+/// The option `-draw <n>` records the draw calls for `n` frames headless,
+/// with option `-balls <n>` for the number of extra balls, and quits.
+
+void CGame::ParseCommandLine(){
+  int argc = 0; //number of arguments
+  LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc); //arguments
+  if(argv == nullptr)return;
+
+  for(int i=1; i+1<argc; i++){
+    if(wcscmp(argv[i], L"-export") == 0)
+      m_strExportName = argv[++i];
+
+    else if(wcscmp(argv[i], L"-batch") == 0)
+      m_nBatchSize = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-threads") == 0)
+      m_nBatchThreads = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-seed") == 0)
+      m_nBatchSeed = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-seconds") == 0)
+      m_fBatchTime = (float)_wtof(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-out") == 0)
+      m_strBatchName = argv[++i];
+
+    else if(wcscmp(argv[i], L"-replay") == 0)
+      m_strReplayName = argv[++i];
+
+    else if(wcscmp(argv[i], L"-frame") == 0)
+      m_nReplayFrame = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-bench") == 0)
+      m_nBenchFrames = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-draw") == 0)
+      m_nDrawFrames = (UINT)_wtoi(argv[++i]);
+
+    else if(wcscmp(argv[i], L"-balls") == 0)
+      m_nDrawBalls = (UINT)_wtoi(argv[++i]);
+  } //for
+
+  LocalFree(argv);
+} //ParseCommandLine
+
+/// Play one ball on each of a batch of table worlds, save the results, and
+/// report the throughput to the debugger.
+
+void CGame::RunBatch(){
+  CBatchRunner batch;
+  batch.Run(m_nBatchSize, m_nBatchThreads, m_nBatchSeed, m_fBatchTime);
+  batch.Save(m_strBatchName.c_str());
+
+  const float t = batch.GetElapsed(); //elapsed time
+  const std::string s = "Batch: " + std::to_string(m_nBatchSize) + " balls in " +
+    std::to_string(t) + " s, " + std::to_string(m_nBatchSize/std::max(t, 0.001f)) + " balls/s\n";
+  OutputDebugStringA(s.c_str());
+} //RunBatch
+
+/// Play a replay file on a table world as fast as possible, from the frame
+/// asked for on the command line to the end, and report the throughput and
+/// the slowest frame to the debugger. Playing a replay of a game in which
+/// a slow frame was seen will find that frame again.
+
+void CGame::RunReplay(){
+  CReplay replay;
+
+  if(!replay.Load(m_strReplayName.c_str())){
+    OutputDebugStringA("Replay: can't load replay file\n");
+    return;
+  } //if
+
+  CTableWorld world(0);
+  CReplayPlayer player(&replay);
+  player.Seek(&world, m_nReplayFrame);
+
+  const UINT start = player.GetFrame(); //first frame timed
+  UINT slowest = start; //slowest frame
+  float tslowest = 0.0f; //time taken by slowest frame
+
+  const auto t0 = std::chrono::steady_clock::now(); //start time
+  auto t1 = t0; //start time of frame
+  bool more = start < replay.GetNumFrames(); //whether there are frames left
+
+  while(more){
+    const UINT frame = player.GetFrame(); //current frame
+    more = player.Step(&world);
+
+    const auto t2 = std::chrono::steady_clock::now(); //end time of frame
+    const std::chrono::duration<float> dt = t2 - t1;
+    t1 = t2;
+
+    if(dt.count() > tslowest){
+      tslowest = dt.count();
+      slowest = frame;
+    } //if
+  } //while
+
+  const std::chrono::duration<float> elapsed = t1 - t0;
+  const float t = elapsed.count(); //elapsed time
+  const UINT n = player.GetFrame() - start; //number of frames played
+
+  const std::string s = "Replay: " + std::to_string(n) + " frames in " +
+    std::to_string(t) + " s, " + std::to_string(n/std::max(t, 0.001f)) +
+    " frames/s, slowest frame " + std::to_string(slowest) + " took " +
+    std::to_string(1000.0f*tslowest) + " ms, score " + std::to_string(world.GetScore()) + "\n";
+  OutputDebugStringA(s.c_str());
+} //RunReplay
+
+/// Run the multiball benchmark, save the results to `bench.json`,
+/// and report the total time per frame for each run to the debugger.
+
+void CGame::RunBench(){
+  CBench bench;
+  bench.Run(m_nBenchFrames, m_nBatchSeed);
+  bench.Save(L"bench.json");
+
+  for(auto const& r: bench.GetResults()){
+    const CMoveProfile& p = r.m_cProfile; //shorthand
+    const UINT64 total = p.m_nMotion + p.m_nBroad + p.m_nNarrow + p.m_nUpdate; //total time
+    
+    const std::string s = "Bench: " + std::to_string(r.m_nBalls) + " balls, " +
+      std::to_string(total/std::max(1U, p.m_nFrames)) + " ns/frame\n";
+    OutputDebugStringA(s.c_str());
+  } //for
+} //RunBench
+
+/// Move a table world with extra balls in it and record the draw calls that
+/// `CObjectManager::draw()` and `CObjectManager::DrawOutlines()` make for it
+/// into a draw list, with submission to the GPU turned off so that only the
+/// cost of making the calls is timed. The ball positions come from the seed
+/// given by `-seed <n>`.
+
+void CGame::RunDraw(){
+  CTableWorld world(m_nBatchSeed);
+  world.AddBalls(m_nDrawBalls, m_nBatchSeed);
+
+  CDrawList list;
+  std::chrono::steady_clock::duration elapsed(0); //time spent drawing
+  m_pRenderer->SetDrawList(&list, false);
+
+  for(UINT i=0; i<m_nDrawFrames; i++){
+    world.move();
+
+    const auto t0 = std::chrono::steady_clock::now(); //start time
+
+    m_pRenderer->BeginFrame();
+      world.draw();
+      world.DrawOutlines();
+    m_pRenderer->EndFrame();
+
+    elapsed += std::chrono::steady_clock::now() - t0;
+  } //for
+
+  m_pRenderer->SetDrawList(nullptr);
+  list.Save(DRAWLIST_FILE);
+
+  const std::chrono::duration<float> t = elapsed;
+  const CDrawStats s = list.GetStats();
+  const UINT n = std::max(1U, s.m_nFrames); //number of frames
+
+  const std::string str = "Draw: " + std::to_string(s.m_nFrames) + " frames, " +
+    std::to_string(UINT64(1e9f*t.count())/n) + " ns/frame, " +
+    std::to_string(s.m_nCommands/n) + " commands/frame, " +
+    std::to_string(s.m_nSwitches/n) + " sprite switches/frame, " +
+    std::to_string(s.m_nRedundant/n) + " redundant draws/frame\n";
+  OutputDebugStringA(str.c_str());
+} //RunDraw
+
 /// Initialize the audio player and load game sounds.
 
 void CGame::LoadSounds(){
@@ -82,57 +290,38 @@ void CGame::Release(){
   m_pRenderer = nullptr; //for safety
 } //Release
 
-/// Create the edges of the world and some shapes.
+/// Load the table from the table file if there is one, otherwise create
+/// the edges of the world and some shapes. If asked to on the command line,
+/// always create them and export them to a table file.
 
 void CGame::BeginGame(){   
-  m_pObjectManager->MakeWorldEdges(); //make world edges
-  m_pObjectManager->MakeShapes(); //make shapes
+  if(!m_strExportName.empty() || !m_pObjectManager->LoadTable(TABLE_FILE)){
+    m_pObjectManager->MakeWorldEdges(); //make world edges
+    m_pObjectManager->MakeShapes(); //make shapes
+    m_pObjectManager->MakeGrid(); //make spatial index
+  } //if
+
+  if(!m_strExportName.empty())
+    m_pObjectManager->SaveTable(m_strExportName.c_str());
 
-  m_nScore = 0;
+  m_cRecorder.Begin(&m_cReplay, GetTickCount()); //start recording a replay
 } //BeginGame
 
 /// If there is no ball, create one and place it in the chute ready for launch.
 /// Otherwise, assuming that this has been done and the ball is ready to launch,
 /// then apply a vertical impulse to it. Add a little bit of randomness to that
-/// impulse so that it behaves slightly differently each time.
+/// impulse so that it behaves slightly differently each time. The randomness
+/// comes from the replay recorder so that a replay can make it again.
 
 void CGame::Launch(){
-  static bool bReadyForLaunch = false;
-
-  const float r = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
-
-  if(m_bBallInPlay){ //ball in play, ready to be launched
-    const Vector2 pos = m_pCurBallShape->GetPos();
-
-    if(pos.x > m_nWinWidth - 2.0f*r && pos.y <= r + 1.0f){
-      const float speed = 1000.0f + 1000.0f*m_pRandom->randf(); 
-      m_pCurBallShape->SetVel(Vector2(0.0f, speed));
-      bReadyForLaunch = false;
-      const float volume = std::max(0.1f, speed/4500.0f);
-      m_pAudio->play(eSound::Launch, pos, volume); 
-    } //if
-  } //if
-
-  else{ //ball is not in play
-    const Vector2 pos = Vector2(m_nWinWidth - 1.5f*r, 48.0f);
-    CDynamicCircleDesc d; 
-
-    d.m_fElasticity = 0.9f;
-    d.m_vPos = pos;
-    d.m_fRadius = r;
-
-    const CObjDesc od(eSprite::Ball, eSprite::Ball, eSound::Ballclick);
-    delete m_pCurBallShape; //delete old ball
-    m_pCurBallShape = (CDynamicCircle*)m_pObjectManager->AddShape(&d, od);
-
-    bReadyForLaunch = true;
-    m_bBallInPlay = true;
-    m_pAudio->play(eSound::Load, pos); 
-  } //else
+  m_pObjectManager->Launch(1000.0f + 1000.0f*m_cRecorder.Random());
 } //Launch
 
 /// Poll the keyboard state and respond to the
 /// key presses that happened since the last frame.
+/// The flipper and launch input is recorded for the replay. Rolling back
+/// to a snapshot starts a new replay from there, with the flippers
+/// put back where the keys say they should be.
 
 void CGame::KeyboardHandler(){
   m_pKeyboard->GetState(); //get current keyboard state 
@@ -145,20 +334,61 @@ void CGame::KeyboardHandler(){
     if(m_eDrawMode == eDrawMode::Size)m_eDrawMode = eDrawMode(0);
   } //if
   
-  if(m_pKeyboard->TriggerDown(VK_SPACE)) //load and launch a ball
+  if(m_pKeyboard->TriggerDown(VK_F3)) //save snapshot
+    m_bSnapshot = m_pObjectManager->Snapshot(m_cSnapshot);
+
+  if(m_pKeyboard->TriggerDown(VK_F4) && m_bSnapshot){ //roll back to snapshot
+    m_pObjectManager->Rollback(m_cSnapshot);
+    m_cRecorder.Begin(&m_cReplay, GetTickCount());
+    m_pObjectManager->LeftFlip((m_nInput & INPUT_LEFT) != 0);
+    m_pObjectManager->RightFlip((m_nInput & INPUT_RIGHT) != 0);
+  } //if
+
+  if(m_pKeyboard->TriggerDown(VK_F5)) //save replay
+    m_cReplay.Save(REPLAY_FILE);
+
+  if(m_pKeyboard->TriggerDown(VK_F6)){ //start or stop recording draw calls
+    m_bDrawList = !m_bDrawList;
+
+    if(m_bDrawList){
+      m_cDrawList.Clear();
+      m_pRenderer->SetDrawList(&m_cDrawList);
+    } //if
+
+    else{
+      m_pRenderer->SetDrawList(nullptr);
+      m_cDrawList.Save(DRAWLIST_FILE);
+    } //else
+  } //if
+
+  BYTE launch = 0; //launch input flag
+  
+  if(m_pKeyboard->TriggerDown(VK_SPACE)){ //load and launch a ball
     Launch();
+    launch = INPUT_LAUNCH;
+  } //if
   
-  if(m_pKeyboard->TriggerDown(VK_LSHIFT)) //left flipper up
+  if(m_pKeyboard->TriggerDown(VK_LSHIFT)){ //left flipper up
     m_pObjectManager->LeftFlip(true);
+    m_nInput |= INPUT_LEFT;
+  } //if
 
-  if(m_pKeyboard->TriggerUp(VK_LSHIFT)) //left flipper down
+  if(m_pKeyboard->TriggerUp(VK_LSHIFT)){ //left flipper down
     m_pObjectManager->LeftFlip(false);
+    m_nInput &= ~INPUT_LEFT;
+  } //if
    
-  if(m_pKeyboard->TriggerDown(VK_RSHIFT)) //right flipper up
+  if(m_pKeyboard->TriggerDown(VK_RSHIFT)){ //right flipper up
     m_pObjectManager->RightFlip(true);
+    m_nInput |= INPUT_RIGHT;
+  } //if
   
-  if(m_pKeyboard->TriggerUp(VK_RSHIFT)) //right flipper down
+  if(m_pKeyboard->TriggerUp(VK_RSHIFT)){ //right flipper down
     m_pObjectManager->RightFlip(false);
+    m_nInput &= ~INPUT_RIGHT;
+  } //if
+
+  m_cRecorder.Record(m_nInput | launch);
 } //KeyboardHandler
 
 /// Ask object manager to draw the game objects. RenderWorld
@@ -173,7 +403,7 @@ void CGame::RenderFrame(){
       m_pRenderer->Draw(eSprite::Background, m_vWinCenter); //draw background
 
       //draw score
-      int n = m_nScore; //current score
+      int n = m_pObjectManager->GetScore(); //current score
 
       for(int i=NUMSCOREDIGITS-1; i>=0; i--){
         m_cScoreDesc[i].m_nCurrentFrame = n%10; //get least significant digit
@@ -206,6 +436,7 @@ void CGame::ProcessFrame(){
   m_pAudio->BeginFrame(); //notify audio player that frame has begun
 
   m_pTimer->Tick([&](){ 
+    m_cRecorder.Step(m_pObjectManager); //end of input for replay
     m_pObjectManager->move(); //move all objects
   });
 
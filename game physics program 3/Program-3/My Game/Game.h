@@ -4,9 +4,13 @@
 #ifndef __L4RC_GAME_GAME_H__
 #define __L4RC_GAME_GAME_H__
 
+#include <string>
+
 #include "Component.h"
 #include "Common.h"
+#include "DrawList.h"
 #include "ObjectManager.h"
+#include "Replay.h"
 #include "Settings.h"
 
 /// \brief The game class.
@@ -25,8 +29,36 @@ class CGame:
     LSpriteDesc2D m_cClipDesc1; ///< Sprite descriptor for clip 0.
     LSpriteDesc2D m_cScoreDesc[NUMSCOREDIGITS]; ///< Sprite descriptors for score digits.
     
-    CDynamicCircle* m_pCurBallShape = nullptr; ///< Pointer to current ball shape.
+    std::wstring m_strExportName; ///< Name of file to export the table to, if any.
+
+    UINT m_nBatchSize = 0; ///< Number of balls to play in batch mode, zero for none.
+    UINT m_nBatchThreads = 0; ///< Number of threads for batch mode, zero for one per core.
+    UINT m_nBatchSeed = 1; ///< Random number seed for the first ball in batch mode.
+    float m_fBatchTime = 120.0f; ///< Time limit for each ball in batch mode in seconds.
+    std::wstring m_strBatchName = L"batch.csv"; ///< Name of file to save batch results to.
+
+    UINT m_nBenchFrames = 0; ///< Number of frames per benchmark run, zero for none.
+
+    CDrawList m_cDrawList; ///< Draw list being recorded.
+    bool m_bDrawList = false; ///< Whether draw calls are being recorded.
+    UINT m_nDrawFrames = 0; ///< Number of frames to record headless, zero for none.
+    UINT m_nDrawBalls = 64; ///< Number of extra balls to record headless.
+
+    CSnapshot m_cSnapshot; ///< Snapshot for retrying a shot.
+    bool m_bSnapshot = false; ///< Whether m_cSnapshot has been saved.
+
+    CReplay m_cReplay; ///< Replay of the game so far.
+    CReplayRecorder m_cRecorder; ///< Replay recorder.
+    BYTE m_nInput = 0; ///< Flipper input flags.
+
+    std::wstring m_strReplayName; ///< Name of replay file to play headless, if any.
+    UINT m_nReplayFrame = 0; ///< Frame to seek to before timing the replay.
     
+    void ParseCommandLine(); ///< Parse the command line.
+    void RunBatch(); ///< Play a batch of balls and quit.
+    void RunReplay(); ///< Play a replay file and quit.
+    void RunBench(); ///< Run the benchmark and quit.
+    void RunDraw(); ///< Record draw calls headless and quit.
     void LoadSounds(); ///< Load sounds.
     void BeginGame(); ///< Begin playing the game.
     void KeyboardHandler(); ///< The keyboard handler.
@@ -7,6 +7,8 @@
 #include "Renderer.h"
 #include "ComponentIncludes.h"
 
+const float OUTLINE_SEGLEN = 8.0f; ///< Approximate length of line segments in curved outlines.
+
 ////////////////////////////////////////////////////////////////////////////////////
 // CObjDesc functions.
 
@@ -35,8 +37,9 @@ CObject::CObject(CShape* p, const CObjDesc& d):
 } //constructor
 
 /// Update object.
+/// \param t Current time in the object's world.
 
-void CObject::Update(){
+void CObject::Update(float t){
   if(m_pShape->GetMotionType() == eMotion::Dynamic){
     m_nSpriteIndex = (UINT)m_eUnlitSprite;
     m_vPos = m_pShape->GetPos();
@@ -53,57 +56,159 @@ void CObject::Update(){
     m_fRoll = a;
   } //else 
 
-  if(m_pTimer->GetTime() - m_fLastHitTime > 0.1f)
+  if(t - m_fLastHitTime > 0.1f)
     m_bRecentHit = false;
 } //Update
 
-/// Draw only the outline of the object's shape.
-/// This is reasonably cheap for line segments
-/// but hideously expensive for circles and arcs
-/// because it laboriously constructs the curve
-/// by drawing very short lines. Ideally
-/// I should put it into the pixel shader but I can't
-/// be bothered. This is good enough for now.
-
-void CObject::DrawOutline(){
-  const eSprite s = eSprite::BlackLine;
+/// Make the outline of the object's shape once, the first time that it is
+/// drawn, so that drawing it doesn't need any trig and objects that are never
+/// drawn in outline never allocate one. Line segments need only their end points.
+/// Circles and arcs are approximated by a polyline whose segments are roughly
+/// OUTLINE_SEGLEN pixels long, and arcs cover only their own angular range
+/// instead of the whole circle. Each segment is made into a line sprite, which
+/// static shapes keep for good. Shapes that move also keep a copy of the
+/// line sprites as they were made, to be moved from. The shape's current
+/// geometry is already rotated to its current orientation, so that
+/// orientation is recorded along with the outline.
+
+void CObject::MakeOutline(){
+  std::vector<Vector2> v; //outline vertices
+  m_vOutlinePos = m_pShape->GetPos();
 
   switch(m_pShape->GetShapeType()){
     case eShape::LineSeg: {
       Vector2 p0, p1;
       ((CLineSeg*)m_pShape)->GetEndPts(p0, p1);
-      m_pRenderer->DrawLine(s, p0, p1);
+      v.push_back(p0);
+      v.push_back(p1);
     } //case
     break;
       
-    case eShape::Circle: {
-      const float r = ((CCircle*)m_pShape)->GetRadius();
-      const float w = m_pRenderer->GetWidth(s);
-      const UINT count = (UINT)ceil(XM_2PI*r/w) + 1;
-
-      for(UINT i=0; i<count; i++){
-        const float a = XM_2PI*i/(float)count;
-        const Vector2 v2 = m_pShape->GetPos() + r*Vector2(cosf(a), sinf(a));
-        m_pRenderer->Draw(s, v2, XM_PI/2.0f + a);
-      } //for
-    } //case
+    case eShape::Circle: 
+      MakeCurveOutline(v, ((CCircle*)m_pShape)->GetRadius(), 0.0f, XM_2PI);
     break;
       
     case eShape::Arc: {
       CArc* pArc = (CArc*)m_pShape;
-      float r = pArc->GetRadius();
-      UINT count = (UINT)ceil(XM_2PI*r) + 1;
-
-      for(UINT i=0; i<count; i++){
-        const float a = XM_2PI*i/(float)count;
-        const Vector2 v2 = m_pShape->GetPos() + r*Vector2(cosf(a), sinf(a));
-        if(pArc->PtInSector(v2))
-          m_pRenderer->Draw(s, v2, XM_PI/2.0f + a);
+      float a0, a1;
+      pArc->GetAngles(a0, a1);
+      if(a1 < a0)a1 += XM_2PI; //arc wraps around through angle zero
+      MakeCurveOutline(v, pArc->GetRadius(), a0, a1);
+    } //case
+    break;
+  } //switch
+
+  m_stdCurOutline.resize(v.empty()? 0: v.size() - 1);
+
+  for(size_t i=0; i<m_stdCurOutline.size(); i++)
+    m_pRenderer->MakeLine(eSprite::BlackLine, v[i], v[i + 1], m_stdCurOutline[i]);
+
+  if(m_pShape->GetMotionType() != eMotion::Static)
+    m_stdOutline = m_stdCurOutline;
+
+  m_vCurOutlinePos = m_vOutlinePos;
+  m_fOutlineAngle = m_pShape->GetOrientation();
+  m_fCurOutlineAngle = m_fOutlineAngle;
+  m_bOutlineMade = true;
+} //MakeOutline
+
+/// Append to a list of outline vertices the vertices of a polyline
+/// approximating the portion of a circle centered at the shape's position
+/// that extends counterclockwise from one angle to another.
+/// \param v [in, out] Outline vertices.
+/// \param r Radius.
+/// \param a0 Start angle.
+/// \param a1 End angle, must be greater than a0.
+
+void CObject::MakeCurveOutline(std::vector<Vector2>& v, float r, float a0, float a1){
+  const float da = a1 - a0; //angle subtended
+  const UINT n = std::max(8U, (UINT)ceilf(da*r/OUTLINE_SEGLEN)); //number of segments
+
+  for(UINT i=0; i<=n; i++){
+    const float a = a0 + da*i/(float)n;
+    v.push_back(m_vOutlinePos + r*Vector2(cosf(a), sinf(a)));
+  } //for
+} //MakeCurveOutline
+
+/// Bring the current outline up to date if the shape has moved. Static
+/// shapes never do. Dynamic shapes only translate, so their line sprites
+/// are just offset. Kinematic shapes rotate about their center of rotation
+/// by the change in orientation since the outline was made, so the end
+/// points of their line sprites are rotated and the same change is added
+/// to their orientations. Neither changes the lengths. This needs only one
+/// sine and cosine per object and only when the orientation has changed
+/// since the last time.
+
+void CObject::UpdateOutline(){
+  switch(m_pShape->GetMotionType()){
+    case eMotion::Dynamic: {
+      const Vector2 p = m_pShape->GetPos();
+      if(p == m_vCurOutlinePos)return; //nothing to do
+
+      const Vector2 d = p - m_vOutlinePos; //displacement since construction
+
+      for(size_t i=0; i<m_stdOutline.size(); i++){
+        const CLineSprite& l0 = m_stdOutline[i]; //line sprite when constructed
+        CLineSprite& l = m_stdCurOutline[i]; //current line sprite
+        l.m_vP0 = l0.m_vP0 + d;
+        l.m_vP1 = l0.m_vP1 + d;
+        l.m_cDesc.m_vPos = l0.m_cDesc.m_vPos + d;
       } //for
+
+      m_vCurOutlinePos = p;
     } //case
+    break;
+
+    case eMotion::Kinematic: {
+      const float a = m_pShape->GetOrientation();
+      if(a == m_fCurOutlineAngle)return; //nothing to do
+
+      const Vector2 c = m_pShape->GetRotCenter();
+      const float da = a - m_fOutlineAngle; //change in orientation since construction
+      const float sina = sinf(da);
+      const float cosa = cosf(da);
+
+      for(size_t i=0; i<m_stdOutline.size(); i++){
+        const CLineSprite& l0 = m_stdOutline[i]; //line sprite when constructed
+        CLineSprite& l = m_stdCurOutline[i]; //current line sprite
+
+        const Vector2 v0 = l0.m_vP0 - c;
+        const Vector2 v1 = l0.m_vP1 - c;
+        l.m_vP0 = c + Vector2(v0.x*cosa - v0.y*sina, v0.x*sina + v0.y*cosa);
+        l.m_vP1 = c + Vector2(v1.x*cosa - v1.y*sina, v1.x*sina + v1.y*cosa);
+
+        l.m_cDesc.m_vPos = 0.5f*(l.m_vP0 + l.m_vP1);
+        l.m_cDesc.m_fRoll = l0.m_cDesc.m_fRoll + da;
+      } //for
+
+      m_fCurOutlineAngle = a;
+    } //case
+    break;
   } //switch
+} //UpdateOutline
+
+/// Draw the outline of the object's shape, making it the first time and
+/// moving it if the shape has moved since the last time.
+
+void CObject::DrawOutline(){
+  if(!m_bOutlineMade)
+    MakeOutline();
+
+  UpdateOutline();
+  m_pRenderer->DrawLines(m_stdCurOutline);
 } //DrawOutline
 
+/// Get an object descriptor that would make an object like this one.
+/// \return Object descriptor.
+
+CObjDesc CObject::GetObjDesc() const{
+  CObjDesc d(m_eUnlitSprite, m_eLitSprite, m_eSound);
+  d.m_vSpriteOffset = m_vSpriteOffset;
+  d.m_nScore = m_nScore;
+
+  return d;
+} //GetObjDesc
+
 /// Reader function for the object's AABB.
 /// It gets this by querying the oblect's shape's AABB.
 /// \return The object's AABB.
@@ -119,6 +224,13 @@ CShape* CObject::GetShape() const{
   return m_pShape;
 } //GetShape
 
+/// Reader function for the number of hits.
+/// \return Number of times the object was hit hard enough to score.
+
+UINT CObject::GetHits() const{
+  return m_nHits;
+} //GetHits
+
 /// Reader function for the object's motion type.
 /// It gets this by querying the object's shape's motion type.
 /// \return The object's motion type.
@@ -4,11 +4,14 @@
 #ifndef __L4RC_GAME_OBJECT_H__
 #define __L4RC_GAME_OBJECT_H__
 
+#include <vector>
+
 #include "GameDefines.h"
 #include "Component.h"
 #include "Common.h"
 #include "Shape.h"
 #include "SpriteDesc.h"
+#include "Renderer.h"
 
 /// \brief Object descriptor.
 ///
@@ -49,16 +52,31 @@ class CObject:
     float m_fLastHitTime = 0; ///< Time of last hit.
 
     UINT m_nScore = 0; ///< Score for collision.
+    UINT m_nHits = 0; ///< Number of times hit hard enough to score.
     eSound m_eSound = eSound::Size; ///< Collision sound.
 
+    std::vector<CLineSprite> m_stdOutline; ///< Outline when constructed, kept only for moving shapes.
+    std::vector<CLineSprite> m_stdCurOutline; ///< Current outline.
+    Vector2 m_vOutlinePos; ///< Shape position when outline was constructed.
+    Vector2 m_vCurOutlinePos; ///< Shape position for current outline.
+    float m_fOutlineAngle = 0.0f; ///< Shape orientation when outline was constructed.
+    float m_fCurOutlineAngle = 0.0f; ///< Shape orientation for current outline.
+    bool m_bOutlineMade = false; ///< Whether the outline has been made yet.
+
+    void MakeOutline(); ///< Make outline.
+    void MakeCurveOutline(std::vector<Vector2>&, float, float, float); ///< Make outline vertices for a curve.
+    void UpdateOutline(); ///< Update outline for moving shapes.
+
   public:
     CObject(CShape*, const CObjDesc&); ///< Constructor.
 
-    void Update(); ///< Update object.
+    void Update(float); ///< Update object.
     void DrawOutline(); ///< Draw outline.
+    CObjDesc GetObjDesc() const; ///< Get object descriptor.
 
     const CAabb2D& GetAABB() const; ///< Get AABB.
     CShape* GetShape() const; ///< Get pointer to shape.
+    UINT GetHits() const; ///< Get number of hits.
     const eMotion GetMotionType() const; ///< Get motion type.
 }; //CObject
 
@@ -1,6 +1,11 @@
 /// \file ObjectManager.cpp
 /// \brief Code for the object manager class CObjectManager.
 
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <random>
+
 #include "ObjectManager.h"
 #include "Parts.h"
 #include "Renderer.h"
@@ -8,17 +13,21 @@
 #include "ComponentIncludes.h"
 
 const float TOP_MARGIN = 60.0f; ///< Height of top margin.
+const float GRID_CELLSIZE = 32.0f; ///< Width and height of spatial index cells.
 
 /// The destructor clears the shape lists, which destructs
-/// all of the shapes in them.
+/// all of the shapes in them, and deletes the balls.
 
 CObjectManager::~CObjectManager(){
   for(eMotion m: {eMotion::Static, eMotion::Kinematic})
     for(auto const& p: m_stdShapes[(UINT)m])
-      delete p; 
+      DeleteShape(p); 
+
+  for(auto const& p: m_stdSensors)
+    DeleteShape(p); 
 
   for(auto const &p: m_stdObjects)
-    delete p; 
+    DeleteObject(p); 
 
   for(auto const &p: m_vBumperList)
     delete p; 
@@ -30,6 +39,13 @@ CObjectManager::~CObjectManager(){
 
   delete m_pLeftGate;
   delete m_pRightGate;
+
+  delete m_pBall;
+
+  for(auto const& p: m_stdExtraBalls)
+    delete p;
+
+  delete [] m_pArena;
 } //destructor
 
 /// Make the static shapes for the world boundaries. As with most physics code, this
@@ -106,9 +122,10 @@ void CObjectManager::MakeWorldEdges(){
   q1 += Vector2(-2.5f, 2.5f);
   lsDesc.SetEndPts(q1, pArc->ClosestPt(q1));
   lsDesc.m_fElasticity = 0.6f;
+  lsDesc.m_bOneWay = true;
   CObjDesc lsObjDesc2(eSprite::None, eSprite::None, eSound::Click);
   
-  CLineSeg* pShape = (CLineSeg*)MakeShape(&lsDesc, lsObjDesc2);
+  CLineSeg* pShape = (CLineSeg*)AddShape(&lsDesc, lsObjDesc2);
   m_pRightGate = new CGate(pShape);
   
   arcDesc.SetAngles(5.0f*XM_PI/6.0f, XM_PI);  
@@ -116,8 +133,9 @@ void CObjectManager::MakeWorldEdges(){
   q0 += Vector2(2.5f, 2.5f);
   lsDesc.SetEndPts(pArc->ClosestPt(q0), q0);
   
-  pShape = (CLineSeg*)MakeShape(&lsDesc, lsObjDesc2);
+  pShape = (CLineSeg*)AddShape(&lsDesc, lsObjDesc2);
   m_pLeftGate = new CGate(pShape);
+  lsDesc.m_bOneWay = false;
 
   //line segment to protect new ball
 
@@ -629,15 +647,46 @@ CShape* CObjectManager::MakeShape(CShapeDesc* sd, const CObjDesc& od){
   return p;
 } //MakeShape
 
+/// Delete a shape. Shapes loaded from a table file live in the arena, 
+/// so they are destructed but not deleted.
+/// \param p Pointer to a shape.
+
+void CObjectManager::DeleteShape(CShape* p){
+  if(InArena(p))p->~CShape();
+  else delete p;
+} //DeleteShape
+
+/// Delete an object. Objects loaded from a table file live in the arena, 
+/// so they are destructed but not deleted.
+/// \param p Pointer to an object.
+
+void CObjectManager::DeleteObject(CObject* p){
+  if(InArena(p))p->~CObject();
+  else delete p;
+} //DeleteObject
+
+/// Test whether memory is in the arena that holds the shapes and
+/// objects loaded from a table file.
+/// \param p Pointer to memory.
+/// \return true if it's in the arena.
+
+bool CObjectManager::InArena(const void* p) const{
+  return m_pArena != nullptr && (const BYTE*)p >= m_pArena && (const BYTE*)p < m_pArena + m_nArenaSize;
+} //InArena
+
 /// Creates a new shape and pushes a contact descriptor for that
-/// shape into the shape list.
+/// shape into the shape list, or the sensor list if it's a sensor.
 /// \param sd Pointer to a shape descriptor.
 /// \param od Object descriptor.
 /// \return Pointer to created shape.
 
 CShape* CObjectManager::AddShape(CShapeDesc* sd, const CObjDesc& od){
   CShape* p = MakeShape(sd, od); 
-  m_stdShapes[(UINT)p->GetMotionType()].push_back(p);
+
+  if(p->GetSensor())
+    m_stdSensors.push_back(p);
+  else m_stdShapes[(UINT)p->GetMotionType()].push_back(p);
+
   return p;
 } //AddShape
 
@@ -649,85 +698,149 @@ void CObjectManager::draw(){
       m_pRenderer->Draw((LSpriteDesc2D*)p); //draw it
 } //draw
 
-/// Draw the outlines of the shapes in all objects.
+/// Draw the outlines of the shapes in all objects. Each object keeps its
+/// outline as line sprites and moves them only if its shape has moved, so
+/// after the first frame this allocates nothing and needs no trig except
+/// for shapes that have rotated.
 
 void CObjectManager::DrawOutlines(){ 
   for(auto const& p: m_stdObjects) //for each object
-    p->DrawOutline(); //ask it to draw its outline
-} //draw
+    p->DrawOutline();
+} //DrawOutlines
 
 /// Move all of the shapes in the dynamic and kinematic shape lists and perform collision response.
 
 void CObjectManager::move(){ 
+  m_fTime += m_nMIterations*m_fWorldTimeStep;
+
   for(UINT j=0; j<m_nMIterations; j++){
-    for(auto const &p: m_stdShapes[(UINT)eMotion::Kinematic])
-      p->move();
+    {
+      CProfileTimer timer(m_pProfile, &CMoveProfile::m_nMotion);
 
-    auto i=m_stdShapes[(UINT)eMotion::Dynamic].begin();
-    while(i!=m_stdShapes[(UINT)eMotion::Dynamic].end()){
-      (*i)->move(); //move it
+      for(auto const &p: m_stdShapes[(UINT)eMotion::Kinematic])
+        p->move(m_fWorldTimeStep, m_fWorldGravity);
 
-      //delete lost ball
+      auto i=m_stdShapes[(UINT)eMotion::Dynamic].begin();
+      while(i!=m_stdShapes[(UINT)eMotion::Dynamic].end()){
+        (*i)->move(m_fWorldTimeStep, m_fWorldGravity); //move it
 
-      if(!(m_cAABB && (*i)->GetAABB())){
-        CObject* pObj = (CObject*)((*i)->GetUserPtr()); //get object pointer from shape
+        //delete lost ball
 
-        for(auto j=m_stdObjects.begin(); j!=m_stdObjects.end(); j++)
-          if(*j == pObj){ //if it's the object corr. to the shape
-            delete *j; //delete the object
-            m_stdObjects.erase(j); //remove object pointer from object list
-            break;
-          } //if
+        if(!(m_cAABB && (*i)->GetAABB())){
+          CObject* pObj = (CObject*)((*i)->GetUserPtr()); //get object pointer from shape
 
-        i = m_stdShapes[(UINT)eMotion::Dynamic].erase(i); //remove shape pointer from shape list
-        m_pAudio->play(eSound::LostBall);
-        m_bBallInPlay = false;
-      } //if
+          for(auto j=m_stdObjects.begin(); j!=m_stdObjects.end(); j++)
+            if(*j == pObj){ //if it's the object corr. to the shape
+              m_stdLostObjects.push_back(*j); //delete the object after the events
+              m_stdObjects.erase(j); //remove object pointer from object list
+              break;
+            } //if
 
-      else ++i;
-    } //while
+          ExitSensors(*i); //it's no longer in any sensor
+          PlaySound(eSound::LostBall, (*i)->GetPos());
+          if(*i == m_pBall)m_bBallInPlay = false;
+          i = m_stdShapes[(UINT)eMotion::Dynamic].erase(i); //remove shape pointer from shape list
+        } //if
+
+        else ++i;
+      } //while
+    }
 
     for(UINT i=0; i<m_nCIterations; i++)
       BroadPhase(); //broadphase collision detection and response
+
+    CProfileTimer timer(m_pProfile, &CMoveProfile::m_nNarrow);
+    UpdateSensors(); //sensor overlap tests
   } //for
+
+  CProfileTimer timer(m_pProfile, &CMoveProfile::m_nUpdate);
+  if(m_pProfile)m_pProfile->m_nFrames++;
+
+  EndSensorFrame();
   
-  m_pLeftFlipper->EnforceBounds();
-  m_pRightFlipper->EnforceBounds();
+  m_pLeftFlipper->EnforceBounds(m_cEvents);
+  m_pRightFlipper->EnforceBounds(m_cEvents);
+
+  ProcessEvents(); //this is what marks the gates as occupied
 
   m_pLeftGate->CloseGate();
   m_pRightGate->CloseGate();
 
+  for(auto const& p: m_stdLostObjects)
+    DeleteObject(p);
+
+  m_stdLostObjects.clear();
+
   for(auto const& p: m_stdObjects)
-    p->Update();
+    p->Update(m_fTime);
 } //move
 
-/// Do collision detection for all dynamic shapes against all
-/// static and kinematic shapes, and against all dynamic shapes
-/// that appear after it in the dynamic shape list. 
+/// Gather the shape pairs, then do collision detection and response
+/// for them four times over.
 
 void CObjectManager::BroadPhase(){
-  const auto begin = m_stdShapes[(UINT)eMotion::Dynamic].begin();
-  const auto end = m_stdShapes[(UINT)eMotion::Dynamic].end();
+  {
+    CProfileTimer timer(m_pProfile, &CMoveProfile::m_nBroad);
+    GatherPairs();
+  }
+
+  CProfileTimer timer(m_pProfile, &CMoveProfile::m_nNarrow);
+  if(m_pProfile)m_pProfile->m_nPairs += 4*m_stdPairs.size();
 
   for(UINT k=0; k<4; k++)
-    for(auto i=begin; i!=end; i++){
-      const auto pCirc = (CDynamicCircle*)*i; //pointer to current dynamic shape
+    for(auto const& p: m_stdPairs)
+      if(p.m_pGate)p.m_pGate->NarrowPhase(p.m_pCirc, m_cEvents);
+      else NarrowPhase(p.m_pShape, p.m_pCirc);
+} //BroadPhase
 
-      m_pLeftGate->NarrowPhase(pCirc); //left gate   
-      m_pRightGate->NarrowPhase(pCirc);  //right gate
+/// Gather the pairs for each dynamic shape in turn. Each dynamic shape's AABB
+/// is grown by its radius to allow for it being pushed about in the narrow
+/// phase. The static shapes, including the gates, come from a spatial index
+/// query with the grown AABB. Kinematic shapes are all included, since they
+/// are tested over their whole rotation since the last substep. The dynamic
+/// shapes that appear after it in the dynamic shape list are included if
+/// their grown AABBs overlap.
 
-      for(auto const& pShape: m_stdShapes[(UINT)eMotion::Static]) //static shapes
-        NarrowPhase(pShape, pCirc);
-    
-      for(auto const& pShape: m_stdShapes[(UINT)eMotion::Kinematic]) //kinematic shapes
-        NarrowPhase(pShape, pCirc);
-     
-      for(auto j=next(i); j!=end; j++) //dynamic shapes, later numbered to avoid doubling up
-        NarrowPhase(*j, pCirc);
+void CObjectManager::GatherPairs(){
+  m_stdPairs.clear();
+  m_stdBallAABB.clear();
+  m_stdQuery.resize(m_cGrid.GetNumShapes()); //big enough for any query
+
+  const auto& balls = m_stdShapes[(UINT)eMotion::Dynamic]; //shorthand
+
+  for(auto const& p: balls){ //grown AABBs
+    const float r = ((CDynamicCircle*)p)->GetRadius(); //radius
+    const CAabb2D& b = p->GetAABB(); //AABB
+
+    m_stdBallAABB.push_back(CAabb2D(b.GetTopLeft() + Vector2(-r, r), 
+      b.GetBottomRt() + Vector2(r, -r)));
+  } //for
+
+  for(size_t i=0; i<balls.size(); i++){
+    const auto pCirc = (CDynamicCircle*)balls[i]; //pointer to current dynamic shape
+    const UINT n = m_cGrid.QueryAABB(m_stdBallAABB[i], m_stdQuery.data(), (UINT)m_stdQuery.size());
+
+    for(UINT k=0; k<n; k++){ //static shapes and gates nearby
+      CShape* pShape = m_stdQuery[k]; //shorthand
+
+      if(pShape->GetMotionType() == eMotion::Static && !pShape->GetSensor())
+        m_stdPairs.push_back({pShape, pCirc, pShape->GetOneWay()? GetGate(pShape): nullptr});
     } //for
-} //BroadPhase
+
+    for(auto const& pShape: m_stdShapes[(UINT)eMotion::Kinematic]) //kinematic shapes
+      m_stdPairs.push_back({pShape, pCirc, nullptr});
+     
+    for(size_t j=i+1; j<balls.size(); j++) //dynamic shapes, later numbered to avoid doubling up
+      if(m_stdBallAABB[i] && m_stdBallAABB[j])
+        m_stdPairs.push_back({balls[j], pCirc, nullptr});
+  } //for
+} //GatherPairs
 
 /// Check whether a pair of shapes collides and make appropriate response.
+/// The sound, score, and lighting that a collision causes are recorded as an
+/// event and dealt with once per frame by ProcessEvents, not here.
+/// Kinematic shapes are tested over their whole rotation since the last
+/// substep, so that a fast flipper can't swing right past a ball.
 /// \param pShape Pointer to a static or kinematic shape.
 /// \param pCirc Pointer to moving circle.
 /// \return true if there was a collision.
@@ -737,31 +850,19 @@ bool CObjectManager::NarrowPhase(CShape* pShape, CDynamicCircle* pCirc){
 
   CContactDesc cd(pShape, pCirc);
   
-  if(pShape->PreCollide(cd)){ //there's a collision
-    if(!pShape->GetSensor())
-      pCirc->PostCollide(cd);
-
-    bHit = true;
-    CObject* pObj0 = (CObject*)(pCirc->GetUserPtr());
-
-    if(pShape->GetMotionType() == eMotion::Dynamic){ //dynamic shape
-      if(pObj0 != nullptr)
-        m_pAudio->play(pObj0->m_eSound, cd.m_vPOI, cd.m_fSpeed/1000.0f);
+  const bool bSwept = pShape->GetMotionType() == eMotion::Kinematic;
+  float s = 1.0f; //fraction of kinematic shape's rotation at time of impact
+  
+  if(bSwept? pShape->SweptPreCollide(cd, s): pShape->PreCollide(cd)){ //there's a collision
+    if(!pShape->GetSensor()){
+      if(bSwept)pCirc->PostCollideSwept(cd, s);
+      else pCirc->PostCollide(cd);
     } //if
 
-    else{ //static or kinematic shape
-      CObject* pObj1 = (CObject*)(pShape->GetUserPtr());
-
-      if(cd.m_fSpeed > 10.0f){
-        m_pAudio->play(pObj1->m_eSound, cd.m_vPOI);  
-
-        if(!pObj1->m_bRecentHit)
-          m_nScore += pObj1->m_nScore;
-      } //if
+    bHit = true;
 
-      pObj1->m_bRecentHit = true;
-      pObj1->m_fLastHitTime = m_pTimer->GetTime();
-    } //else
+    const eEvent t = pShape->GetMotionType() == eMotion::Dynamic? eEvent::BallHit: eEvent::Hit;
+    m_cEvents.Push(t, pShape, pCirc, cd.m_vPOI, cd.m_fSpeed);
   } //if
   
   //****CSCE 5255 STUDENTS: YOUR CODE STARTS HERE
@@ -771,6 +872,442 @@ bool CObjectManager::NarrowPhase(CShape* pShape, CDynamicCircle* pCirc){
   return bHit;
 } //NarrowPhase
 
+/// Drain the event buffer once per frame after the physics is done, playing
+/// sounds, adding to the score, and lighting up the objects that were hit.
+/// Events have already been merged so that each shape and ball pair makes at
+/// most one of each kind per frame, with the highest speed of the merged ones.
+
+void CObjectManager::ProcessEvents(){
+  const float t = m_fTime; //current time
+  CCollisionEvent e; //current event
+
+  while(m_cEvents.Pop(e)){
+    switch(e.m_eType){
+      case eEvent::Hit: { //ball hit static or kinematic shape
+        CObject* pObj = (CObject*)(e.m_pShape->GetUserPtr());
+
+        if(e.m_fSpeed > 10.0f){
+          PlaySound(pObj->m_eSound, e.m_vPOI);  
+
+          if(!pObj->m_bRecentHit){
+            m_nScore += pObj->m_nScore;
+            pObj->m_nHits++;
+          } //if
+        } //if
+
+        pObj->m_bRecentHit = true;
+        pObj->m_fLastHitTime = t;
+      } //case
+      break;
+
+      case eEvent::BallHit: { //ball hit ball
+        CObject* pObj = (CObject*)(e.m_pBall->GetUserPtr());
+
+        if(pObj != nullptr)
+          PlaySound(pObj->m_eSound, e.m_vPOI, e.m_fSpeed/1000.0f);
+      } //case
+      break;
+
+      case eEvent::GateOpen:
+        GetGate(e.m_pShape)->Occupy();
+        if(e.m_fSpeed > 100.0f) 
+          PlaySound(eSound::Tink, e.m_vPOI);
+      break;
+
+      case eEvent::GateBounce:
+        GetGate(e.m_pShape)->Occupy();
+        if(e.m_fSpeed > 100.0f) 
+          PlaySound(eSound::Click, e.m_vPOI, e.m_fSpeed/1000.0f);
+      break;
+
+      case eEvent::GateHold: //ball in open gate
+        GetGate(e.m_pShape)->Occupy();
+      break;
+
+      case eEvent::SensorEnter: { //ball entered sensor, score once
+        CObject* pObj = (CObject*)(e.m_pShape->GetUserPtr());
+        PlaySound(pObj->m_eSound, e.m_vPOI);  
+        m_nScore += pObj->m_nScore;
+        pObj->m_nHits++;
+        pObj->m_bRecentHit = true;
+        pObj->m_fLastHitTime = t;
+      } //case
+      break;
+
+      case eEvent::SensorStay: { //ball still in sensor, stay lit
+        CObject* pObj = (CObject*)(e.m_pShape->GetUserPtr());
+        pObj->m_bRecentHit = true;
+        pObj->m_fLastHitTime = t;
+      } //case
+      break;
+
+      case eEvent::SensorExit: //ball left sensor, its light goes out by itself
+      break;
+
+      case eEvent::FlipUp:
+        PlaySound(eSound::FlipUp, e.m_vPOI);
+      break;
+
+      case eEvent::FlipDown:
+        PlaySound(eSound::FlipDown, e.m_vPOI);
+      break;
+
+      default: break;
+    } //switch
+  } //while
+
+  m_cEvents.NextFrame();
+} //ProcessEvents
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for sensors
+
+/// Test whether a ball overlaps a sensor. This is much cheaper than collision
+/// detection because there is no setback, normal, or speed to compute. Points
+/// and circles use squared distances, anything else uses AABBs.
+/// \param pSensor Pointer to a sensor.
+/// \param pCirc Pointer to a ball.
+/// \return true if they overlap.
+
+bool CObjectManager::Overlaps(CShape* pSensor, CDynamicCircle* pCirc){
+  const Vector2 d = pCirc->GetPos() - pSensor->GetPos(); //offset between centers
+  float r = pCirc->GetRadius(); //distance at which they touch
+
+  switch(pSensor->GetShapeType()){
+    case eShape::Point: 
+      return d.LengthSquared() <= r*r;
+
+    case eShape::Circle:
+      r += ((CCircle*)pSensor)->GetRadius();
+      return d.LengthSquared() <= r*r;
+
+    default:
+      return pSensor->GetAABB() && pCirc->GetAABB();
+  } //switch
+} //Overlaps
+
+/// Test every ball against every sensor once per substep. When a ball
+/// first overlaps a sensor a contact is recorded and a sensor enter event
+/// is made. Contacts that already exist are marked as seen in this frame.
+
+void CObjectManager::UpdateSensors(){
+  for(auto const& pBall: m_stdShapes[(UINT)eMotion::Dynamic]){
+    CDynamicCircle* pCirc = (CDynamicCircle*)pBall;
+
+    for(auto const& pSensor: m_stdSensors){
+      if(!pSensor->GetCanCollide() || !Overlaps(pSensor, pCirc))continue;
+
+      bool bFound = false; //whether there is already a contact
+
+      for(auto& c: m_stdSensorContacts)
+        if(c.m_pSensor == pSensor && c.m_pBall == pBall){
+          c.m_bSeen = true;
+          bFound = true;
+          break;
+        } //if
+
+      if(!bFound){ //new contact
+        const CSensorContact c = {pSensor, pBall, true};
+        m_stdSensorContacts.push_back(c);
+        m_cEvents.Push(eEvent::SensorEnter, pSensor, pBall, pSensor->GetPos(), 0.0f);
+      } //if
+    } //for
+  } //for
+} //UpdateSensors
+
+/// At the end of a frame, make a sensor stay event for every contact that was
+/// seen in this frame, and a sensor exit event for every contact that wasn't, 
+/// removing it. Then get ready for the next frame.
+
+void CObjectManager::EndSensorFrame(){
+  auto i = m_stdSensorContacts.begin();
+
+  while(i != m_stdSensorContacts.end()){
+    const eEvent t = i->m_bSeen? eEvent::SensorStay: eEvent::SensorExit;
+    m_cEvents.Push(t, i->m_pSensor, i->m_pBall, i->m_pSensor->GetPos(), 0.0f);
+
+    if(i->m_bSeen){
+      i->m_bSeen = false;
+      ++i;
+    } //if
+
+    else i = m_stdSensorContacts.erase(i);
+  } //while
+} //EndSensorFrame
+
+/// Make sensor exit events for a ball that has been lost and
+/// remove its contacts.
+/// \param pBall Pointer to a ball.
+
+void CObjectManager::ExitSensors(CShape* pBall){
+  auto i = m_stdSensorContacts.begin();
+
+  while(i != m_stdSensorContacts.end()){
+    if(i->m_pBall == pBall){
+      m_cEvents.Push(eEvent::SensorExit, i->m_pSensor, pBall, i->m_pSensor->GetPos(), 0.0f);
+      i = m_stdSensorContacts.erase(i);
+    } //if
+
+    else ++i;
+  } //while
+} //ExitSensors
+
+/// Remove a ball from all of the sensors that it is in without making sensor
+/// exit events, for when it is taken out of play or restored from a snapshot.
+/// \param pBall Pointer to a ball shape.
+
+void CObjectManager::RemoveContacts(CShape* pBall){
+  m_stdSensorContacts.erase(std::remove_if(
+    m_stdSensorContacts.begin(), m_stdSensorContacts.end(), 
+    [&](const CSensorContact& c){return c.m_pBall == pBall;}),
+    m_stdSensorContacts.end());
+} //RemoveContacts
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for table files
+
+/// Create the shapes, objects, parts, and spatial index from a table file
+/// instead of making them in code. The file is mapped into memory and its
+/// records are used in place. The shapes and objects are constructed in one
+/// arena, so that there is one allocation for all of them, and the spatial
+/// index uses the cell arrays in the file without copying them. Nothing is
+/// made unless the file is a valid table file.
+/// \param name File name.
+/// \return true if the table was loaded.
+
+bool CObjectManager::LoadTable(const wchar_t* name){
+  if(!m_cTableFile.Open(name))return false;
+
+  const UINT n = m_cTableFile.GetNumShapes(); //number of shapes
+  const size_t align = alignof(std::max_align_t); //alignment of arena blocks
+  const size_t objsize = (sizeof(CObject) + align - 1)/align*align; //object block size
+
+  m_nArenaSize = 0;
+
+  for(UINT i=0; i<n; i++)
+    m_nArenaSize += (m_cTableFile.GetShapeSize(i) + align - 1)/align*align + objsize;
+
+  m_pArena = new BYTE[m_nArenaSize];
+  BYTE* pNext = m_pArena; //next free block
+
+  std::vector<CShape*> gridshapes; //shapes in the spatial index
+  gridshapes.reserve(m_cTableFile.GetNumGridShapes());
+  m_stdObjects.reserve(n);
+
+  CCompoundShape* pLeft = new CCompoundShape; //left flipper shape
+  CCompoundShape* pRight = new CCompoundShape; //right flipper shape
+
+  for(UINT i=0; i<n; i++){
+    CShape* pShape = m_cTableFile.MakeShape(i, pNext);
+    pNext += (m_cTableFile.GetShapeSize(i) + align - 1)/align*align;
+
+    CObject* pObject = new(pNext) CObject(pShape, m_cTableFile.GetObjDesc(i));
+    pNext += objsize;
+
+    m_stdObjects.push_back(pObject);
+    pShape->SetUserPtr(pObject);
+
+    if(i < m_cTableFile.GetNumGridShapes())
+      gridshapes.push_back(pShape);
+
+    if(pShape->GetSensor())
+      m_stdSensors.push_back(pShape);
+    else m_stdShapes[(UINT)pShape->GetMotionType()].push_back(pShape);
+
+    switch(m_cTableFile.GetRole(i)){
+      case eRole::LeftGate:  m_pLeftGate  = new CGate((CLineSeg*)pShape); break;
+      case eRole::RightGate: m_pRightGate = new CGate((CLineSeg*)pShape); break;
+      case eRole::LeftFlipper:  pLeft->AddShape(pShape);  break;
+      case eRole::RightFlipper: pRight->AddShape(pShape); break;
+      case eRole::Bumper: m_vBumperList.push_back(new CPolygon(pShape)); break;
+    } //switch
+  } //for
+
+  m_pLeftFlipper = new CFlipper(pLeft, true);
+  m_pRightFlipper = new CFlipper(pRight, false);
+
+  m_cTableFile.LoadGrid(m_cGrid, gridshapes);
+  m_cAABB = CAabb2D(Vector2(0.0f, (float)m_nWinHeight), Vector2((float)m_nWinWidth, 0.0f));
+
+  return true;
+} //LoadTable
+
+/// Get the role of a shape, that is, which part it belongs to, if any.
+/// \param p Pointer to a shape.
+/// \return Role of the shape.
+
+eRole CObjectManager::GetRole(CShape* p){
+  if(p == m_pLeftGate->GetLineSeg())return eRole::LeftGate;
+  if(p == m_pRightGate->GetLineSeg())return eRole::RightGate;
+
+  for(auto const& q: m_pLeftFlipper->GetCompoundShape()->GetShapes())
+    if(p == q)return eRole::LeftFlipper;
+
+  for(auto const& q: m_pRightFlipper->GetCompoundShape()->GetShapes())
+    if(p == q)return eRole::RightFlipper;
+
+  for(auto const& q: m_vBumperList)
+    if(p == q->GetCenterPoint())return eRole::Bumper;
+
+  return eRole::None;
+} //GetRole
+
+/// Get the gate that a shape belongs to, if any.
+/// \param p Pointer to a shape.
+/// \return Pointer to the gate whose line segment it is, or nullptr if none.
+
+CGate* CObjectManager::GetGate(CShape* p) const{
+  if(p == m_pLeftGate->GetLineSeg())return m_pLeftGate;
+  if(p == m_pRightGate->GetLineSeg())return m_pRightGate;
+
+  return nullptr;
+} //GetGate
+
+/// Save the shapes, objects, parts, and spatial index to a table file that
+/// LoadTable can load. This must be called after the table has been made and
+/// before the first call to move(), since kinematic shapes are saved in their
+/// unrotated geometry. The shapes are saved in the order in which the spatial
+/// index numbers them.
+/// \param name File name.
+/// \return true if the file was saved.
+
+bool CObjectManager::SaveTable(const wchar_t* name){
+  MakeGrid(); //make sure the spatial index is up to date
+
+  std::vector<CShape*> shapes; //shapes in file order
+  GetGridShapes(shapes);
+
+  CTableWriter writer;
+
+  for(auto const& p: shapes)
+    writer.AddShape(p, ((CObject*)p->GetUserPtr())->GetObjDesc(), GetRole(p));
+
+  return writer.Save(name, m_cGrid);
+} //SaveTable
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for spatial queries
+
+/// Get the shapes that go in the spatial index, in the order in which it
+/// numbers them. These are the static shapes, the kinematic shapes, and
+/// the sensors, so that spatial queries can find sensors too.
+/// \param shapes [out] Shape list.
+
+void CObjectManager::GetGridShapes(std::vector<CShape*>& shapes){
+  shapes.clear();
+
+  for(eMotion m: {eMotion::Static, eMotion::Kinematic})
+    shapes.insert(shapes.end(), m_stdShapes[(UINT)m].begin(), m_stdShapes[(UINT)m].end());
+
+  shapes.insert(shapes.end(), m_stdSensors.begin(), m_stdSensors.end());
+} //GetGridShapes
+
+/// Build the spatial index over the static and kinematic shapes and sensors.
+/// This must be called after all of them have been made, and 
+/// after the flippers have had their centers of rotation set.
+
+void CObjectManager::MakeGrid(){
+  std::vector<CShape*> shapes;
+  GetGridShapes(shapes);
+  m_cGrid.Build(m_cAABB, GRID_CELLSIZE, shapes);
+} //MakeGrid
+
+/// Find the first shape hit by a ray. Static and kinematic shapes come from
+/// the spatial index, and there are few enough dynamic shapes to test them all.
+/// Shapes that the ray starts inside of don't count, so a ray cast from the
+/// center of a ball won't hit that ball.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param hit [out] The first hit.
+/// \return true if there was a hit.
+
+bool CObjectManager::RayCast(const Vector2& p0, const Vector2& p1, CRayHit& hit){
+  return RayCastAll(p0, p1, &hit, 1) > 0;
+} //RayCast
+
+/// Find all shapes hit by a ray, nearest first. If there are more hits than
+/// will fit in the buffer, then only the nearest ones are kept.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param buf Hit buffer provided by the caller.
+/// \param n Size of hit buffer.
+/// \return Number of hits in the buffer.
+
+UINT CObjectManager::RayCastAll(const Vector2& p0, const Vector2& p1, CRayHit* buf, UINT n){
+  UINT count = m_cGrid.RayCastAll(p0, p1, buf, n);
+  const Vector2 d = p1 - p0;
+
+  for(auto const& p: m_stdShapes[(UINT)eMotion::Dynamic]){ //dynamic shapes
+    CRayHit hit;
+
+    if(p->RayCast(p0, d, 0.0f, hit.m_fTime, hit.m_vNorm)){
+      hit.m_pShape = p;
+      hit.m_vPos = p0 + hit.m_fTime*d;
+      count = CGrid::InsertHit(buf, count, n, hit);
+    } //if
+  } //for
+
+  return count;
+} //RayCastAll
+
+/// Find the first shape hit by a circle swept along a ray, for example
+/// to predict where a ball will go.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param r Radius of circle.
+/// \param hit [out] The first hit.
+/// \return true if there was a hit.
+
+bool CObjectManager::CircleCast(const Vector2& p0, const Vector2& p1, float r, CRayHit& hit){
+  UINT count = m_cGrid.CircleCast(p0, p1, r, hit)? 1: 0;
+  const Vector2 d = p1 - p0;
+
+  for(auto const& p: m_stdShapes[(UINT)eMotion::Dynamic]){ //dynamic shapes
+    CRayHit h;
+
+    if(p->RayCast(p0, d, r, h.m_fTime, h.m_vNorm)){
+      h.m_pShape = p;
+      h.m_vPos = p0 + h.m_fTime*d;
+      count = CGrid::InsertHit(&hit, count, 1, h);
+    } //if
+  } //for
+
+  return count > 0;
+} //CircleCast
+
+/// Find the shapes that contain a point. Only circles have an inside,
+/// so this will find bollard ends, flipper ends, and balls.
+/// \param p A point.
+/// \param buf Shape buffer provided by the caller.
+/// \param n Size of shape buffer.
+/// \return Number of shapes in the buffer.
+
+UINT CObjectManager::QueryPoint(const Vector2& p, CShape** buf, UINT n){
+  UINT count = m_cGrid.QueryPoint(p, buf, n);
+
+  for(auto const& q: m_stdShapes[(UINT)eMotion::Dynamic]) //dynamic shapes
+    if(count < n && ((CDynamicCircle*)q)->PtInCircle(p))
+      buf[count++] = q;
+
+  return count;
+} //QueryPoint
+
+/// Find the shapes whose AABBs overlap an AABB, including sensors.
+/// \param b An AABB.
+/// \param buf Shape buffer provided by the caller.
+/// \param n Size of shape buffer.
+/// \return Number of shapes in the buffer.
+
+UINT CObjectManager::QueryAABB(const CAabb2D& b, CShape** buf, UINT n){
+  UINT count = m_cGrid.QueryAABB(b, buf, n);
+
+  for(auto const& p: m_stdShapes[(UINT)eMotion::Dynamic]) //dynamic shapes
+    if(count < n && (b && p->GetAABB()))
+      buf[count++] = p;
+
+  return count;
+} //QueryAABB
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Code for flippers
 
@@ -791,3 +1328,282 @@ void CObjectManager::LeftFlip(bool bUp){
 void CObjectManager::RightFlip(bool bUp){  
   m_pRightFlipper->Flip(bUp);
 } //RightFlip
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for the ball
+
+/// If there is no ball in play, make one and place it at the top of the
+/// chute, from where it will drop to the bottom ready for launch.
+
+void CObjectManager::LoadBall(){
+  if(m_bBallInPlay)return;
+
+  const float r = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
+  const Vector2 pos = Vector2(m_nWinWidth - 1.5f*r, 48.0f);
+
+  MakeBall(pos);
+  PlaySound(eSound::Load, pos); 
+} //LoadBall
+
+/// Make a ball at rest and put it into play, deleting the old ball, which
+/// must already have been taken out of play.
+/// \param pos Position.
+
+void CObjectManager::MakeBall(const Vector2& pos){
+  CDynamicCircleDesc d; 
+
+  d.m_fElasticity = 0.9f;
+  d.m_vPos = pos;
+  d.m_fRadius = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
+
+  const CObjDesc od(eSprite::Ball, eSprite::Ball, eSound::Ballclick);
+  delete m_pBall; //delete old ball
+  m_pBall = (CDynamicCircle*)AddShape(&d, od);
+
+  m_bBallInPlay = true;
+} //MakeBall
+
+/// Take the ball out of play straight away, without a sound. Its shape is 
+/// kept until the next ball is made, as it is when the ball is lost.
+
+void CObjectManager::RemoveBall(){
+  if(!m_bBallInPlay)return;
+
+  auto& balls = m_stdShapes[(UINT)eMotion::Dynamic]; //shorthand
+  balls.erase(std::remove(balls.begin(), balls.end(), m_pBall), balls.end());
+
+  CObject* pObj = (CObject*)m_pBall->GetUserPtr(); //ball's object
+  m_stdObjects.erase(std::remove(m_stdObjects.begin(), m_stdObjects.end(), pObj), m_stdObjects.end());
+  DeleteObject(pObj);
+  m_pBall->SetUserPtr(nullptr);
+
+  RemoveContacts(m_pBall); //extra balls keep theirs
+  m_bBallInPlay = false;
+} //RemoveBall
+
+/// If the ball is resting at the bottom of the chute, apply a vertical
+/// impulse to it.
+/// \param speed Launch speed.
+/// \return true if the ball was launched.
+
+bool CObjectManager::LaunchBall(float speed){
+  if(!m_bBallInPlay)return false;
+
+  const float r = m_pBall->GetRadius();
+  const Vector2 pos = m_pBall->GetPos();
+
+  if(pos.x > m_nWinWidth - 2.0f*r && pos.y <= r + 1.0f){
+    m_pBall->SetVel(Vector2(0.0f, speed));
+    PlaySound(eSound::Launch, pos, std::max(0.1f, speed/4500.0f)); 
+    return true;
+  } //if
+
+  return false;
+} //LaunchBall
+
+/// Press the launch button. If there is no ball, create one and place it in
+/// the chute ready for launch. Otherwise, assuming that this has been done and
+/// the ball is ready to launch, launch it.
+/// \param speed Launch speed.
+
+void CObjectManager::Launch(float speed){
+  if(m_bBallInPlay) //ball in play, ready to be launched
+    LaunchBall(speed);
+  else LoadBall(); //ball is not in play
+} //Launch
+
+/// Add balls for stress testing, at random positions between a third of the
+/// way up the table and the bottom of the arch at the top, moving at random
+/// speeds in random directions. They are in addition to the current ball, if
+/// any, and losing them doesn't take the current ball out of play.
+/// \param n Number of balls.
+/// \param seed Random number seed.
+
+void CObjectManager::AddBalls(UINT n, UINT seed){
+  std::mt19937 rng(seed); //random number generator
+  std::uniform_real_distribution<float> u(0.0f, 1.0f);
+
+  const float w = (float)m_nWinWidth; //shorthand
+  const float h = (float)m_nWinHeight; //shorthand
+  const CObjDesc od(eSprite::Ball, eSprite::Ball, eSound::Ballclick);
+
+  for(UINT i=0; i<n; i++){
+    CDynamicCircleDesc d; 
+
+    d.m_fElasticity = 0.9f;
+    d.m_fRadius = m_pRenderer->GetWidth(eSprite::Ball)/2.0f;
+    d.m_vPos = Vector2(4.0f*d.m_fRadius + u(rng)*(w - 8.0f*d.m_fRadius), 
+      h/3.0f + u(rng)*(2.0f*h/3.0f - w/2.0f - TOP_MARGIN - 2.0f*d.m_fRadius));
+
+    const float a = XM_2PI*u(rng); //direction
+    d.m_vVel = (200.0f + 400.0f*u(rng))*Vector2(cosf(a), sinf(a));
+
+    m_stdExtraBalls.push_back(AddShape(&d, od));
+  } //for
+} //AddBalls
+
+/// Set the time step and gravitational constant for this world, which
+/// start out as the defaults in CShapeCommon.
+/// \param dt Time step.
+/// \param g Gravitational constant.
+
+void CObjectManager::SetPhysics(float dt, float g){
+  m_fWorldTimeStep = dt;
+  m_fWorldGravity = g;
+} //SetPhysics
+
+/// Set the move profile that `move()` accumulates its times in.
+/// \param p Pointer to a move profile, or nullptr to stop profiling.
+
+void CObjectManager::SetProfile(CMoveProfile* p){
+  m_pProfile = p;
+} //SetProfile
+
+/// Play a sound. This is the only place that the object manager
+/// plays sounds, so that it can be overridden to simulate silently.
+/// \param s Sound.
+/// \param pos Position of sound.
+/// \param volume Volume.
+
+void CObjectManager::PlaySound(eSound s, const Vector2& pos, float volume){
+  m_pAudio->play(s, pos, volume);
+} //PlaySound
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Reader functions
+
+/// Reader function for ball in play flag.
+/// \return true if there is a ball in play.
+
+const bool CObjectManager::GetBallInPlay() const{
+  return m_bBallInPlay;
+} //GetBallInPlay
+
+/// Reader function for the score.
+/// \return Current score.
+
+const UINT CObjectManager::GetScore() const{
+  return m_nScore;
+} //GetScore
+
+/// Reader function for the time.
+/// \return Time simulated so far in seconds.
+
+const float CObjectManager::GetTime() const{
+  return m_fTime;
+} //GetTime
+
+/// Get the number of times that each of the table's objects has been hit
+/// hard enough to score, in the order that they were made. Balls are left out,
+/// so the counts line up for any two object managers with the same table.
+/// \param hits [out] Number of hits on each object.
+
+void CObjectManager::GetHits(std::vector<UINT>& hits) const{
+  hits.clear();
+
+  for(auto const& p: m_stdObjects)
+    if(p->GetMotionType() != eMotion::Dynamic)
+      hits.push_back(p->GetHits());
+} //GetHits
+
+////////////////////////////////////////////////////////////////////////////////////////
+// Code for snapshots
+
+/// Save everything that changes while the game is played to a snapshot.
+/// This must be called between frames, when there are no events waiting.
+/// A snapshot holds only the current ball, so none can be taken while any
+/// of the extra balls from `AddBalls()` are still in play.
+/// \param s [out] Snapshot.
+/// \return true if the state fits in a snapshot.
+
+bool CObjectManager::Snapshot(CSnapshot& s) const{
+  const auto& balls = m_stdShapes[(UINT)eMotion::Dynamic]; //shorthand
+
+  for(auto const& p: m_stdExtraBalls)
+    if(std::find(balls.begin(), balls.end(), p) != balls.end())
+      return false; //extra ball in play
+
+  s.m_fTime = m_fTime;
+  s.m_nScore = m_nScore;
+
+  s.m_bBallInPlay = m_bBallInPlay;
+  s.m_vBallPos = m_bBallInPlay? m_pBall->GetPos(): Vector2::Zero;
+  s.m_vBallVel = m_bBallInPlay? m_pBall->GetVel(): Vector2::Zero;
+
+  m_pLeftFlipper->GetState(s.m_cLeftFlipper);
+  m_pRightFlipper->GetState(s.m_cRightFlipper);
+  m_pLeftGate->GetState(s.m_cLeftGate);
+  m_pRightGate->GetState(s.m_cRightGate);
+
+  s.m_nNumObjects = 0;
+
+  for(auto const& p: m_stdObjects)
+    if(p->GetMotionType() != eMotion::Dynamic){
+      if(s.m_nNumObjects == CSnapshot::MAXOBJECTS)return false;
+      CObjectState& t = s.m_pObject[s.m_nNumObjects++];
+      t.m_fLastHitTime = p->m_fLastHitTime;
+      t.m_nHits = p->m_nHits;
+      t.m_bRecentHit = p->m_bRecentHit;
+    } //if
+
+  s.m_nNumContacts = 0;
+
+  for(auto const& c: m_stdSensorContacts){
+    if(s.m_nNumContacts == CSnapshot::MAXCONTACTS)return false;
+    const auto i = std::find(m_stdSensors.begin(), m_stdSensors.end(), c.m_pSensor);
+    CContactState& t = s.m_pContact[s.m_nNumContacts++];
+    t.m_nSensor = (UINT16)(i - m_stdSensors.begin());
+    t.m_bSeen = c.m_bSeen;
+  } //for
+
+  return true;
+} //Snapshot
+
+/// Restore everything that changes while the game is played from a snapshot
+/// taken from this object manager, or from another one with the same table.
+/// The ball is made or removed if its being in play has changed since. Only
+/// the current ball's sensor contacts are replaced, so any extra balls from
+/// `AddBalls()` added since keep theirs. This must be called between frames.
+/// \param s Snapshot.
+
+void CObjectManager::Rollback(const CSnapshot& s){
+  m_fTime = s.m_fTime;
+  m_nScore = s.m_nScore;
+
+  if(!s.m_bBallInPlay)
+    RemoveBall();
+
+  else{
+    if(!m_bBallInPlay)
+      MakeBall(s.m_vBallPos);
+
+    m_pBall->SetPos(s.m_vBallPos);
+    m_pBall->SetVel(s.m_vBallVel);
+  } //else
+
+  m_pLeftFlipper->SetState(s.m_cLeftFlipper);
+  m_pRightFlipper->SetState(s.m_cRightFlipper);
+  m_pLeftGate->SetState(s.m_cLeftGate);
+  m_pRightGate->SetState(s.m_cRightGate);
+
+  UINT n = 0; //index into object states
+
+  for(auto const& p: m_stdObjects)
+    if(p->GetMotionType() != eMotion::Dynamic && n < s.m_nNumObjects){
+      const CObjectState& t = s.m_pObject[n++];
+      p->m_fLastHitTime = t.m_fLastHitTime;
+      p->m_nHits = t.m_nHits;
+      p->m_bRecentHit = t.m_bRecentHit;
+    } //if
+
+  RemoveContacts(m_pBall);
+
+  for(UINT i=0; i<s.m_nNumContacts && m_bBallInPlay; i++){
+    const CContactState& t = s.m_pContact[i];
+    const CSensorContact c = {m_stdSensors[t.m_nSensor], m_pBall, t.m_bSeen};
+    m_stdSensorContacts.push_back(c);
+  } //for
+
+  for(auto const& p: m_stdObjects)
+    p->Update(m_fTime);
+} //Rollback
@@ -7,7 +7,12 @@
 #include <vector>
 
 #include "DynamicCircle.h"
+#include "EventBuffer.h"
+#include "Grid.h"
 #include "Parts.h"
+#include "Profile.h"
+#include "Snapshot.h"
+#include "Table.h"
 
 #include "Object.h"
 
@@ -17,9 +22,27 @@
 #include "SpriteDesc.h"
 #include "Polygon.h"
 
+/// \brief Shape pair.
+///
+/// A dynamic circle and a shape that it might collide with, gathered by
+/// the broad phase for the narrow phase to test. If the shape is a gate's
+/// one-way line segment then the gate is tested instead.
+
+class CShapePair{
+  public:
+    CShape* m_pShape; ///< Pointer to shape.
+    CDynamicCircle* m_pCirc; ///< Pointer to dynamic circle.
+    CGate* m_pGate; ///< Pointer to gate, or nullptr if the shape isn't one.
+}; //CShapePair
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// \brief The object manager.
 ///
-/// A collection of all of the game objects.
+/// A collection of all of the game objects. Everything that changes as the
+/// game is played, including the ball, the score, and the time, belongs to
+/// the object manager rather than being shared, so that any number of them
+/// can be simulated independently.
 
 class CObjectManager: 
   public CCommon, 
@@ -28,6 +51,8 @@ class CObjectManager:
 
   private:  
     std::vector<CShape*> m_stdShapes[(UINT)eMotion::Size]; ///< Array of lists of shapes.
+    std::vector<CShape*> m_stdSensors; ///< Sensor list, kept out of the shape lists.
+    std::vector<CSensorContact> m_stdSensorContacts; ///< Sensors and the balls that overlap them.
     std::vector<CObject*> m_stdObjects; ///< Object list.
     
     CGate* m_pLeftGate = nullptr; ///< Pointer to left gate.
@@ -37,13 +62,44 @@ class CObjectManager:
 
     CAabb2D m_cAABB; ///< AABB for the whole window.
 
-    CFlipper* m_pLeftFlipper = nullptr; ///< Pointer to left flipper.
-    CFlipper* m_pRightFlipper = nullptr; ///< Pointer to right flipper.
+
+    CGrid m_cGrid; ///< Spatial index for static and kinematic shapes.
+
+    CEventBuffer m_cEvents; ///< Collision events for the current frame.
+    std::vector<CObject*> m_stdLostObjects; ///< Objects for balls lost this frame, deleted after the events.
+    std::vector<CShape*> m_stdExtraBalls; ///< Balls other than the current one, deleted by the destructor.
+
+    std::vector<CShapePair> m_stdPairs; ///< Shape pairs for the narrow phase, reused every broad phase.
+    std::vector<CShape*> m_stdQuery; ///< Buffer for spatial index queries in the broad phase.
+    std::vector<CAabb2D> m_stdBallAABB; ///< Grown AABBs of the dynamic shapes in the broad phase.
+    CMoveProfile* m_pProfile = nullptr; ///< Pointer to move profile, if being profiled.
+
+    CTableFile m_cTableFile; ///< Table file that the table was loaded from, if any.
+    BYTE* m_pArena = nullptr; ///< Memory for the shapes and objects loaded from the table file.
+    size_t m_nArenaSize = 0; ///< Size of arena in bytes.
     
     CShape* MakeShape(CShapeDesc*, const CObjDesc&); ///< Make a shape.
+    void DeleteShape(CShape*); ///< Delete a shape.
+    void DeleteObject(CObject*); ///< Delete an object.
+    bool InArena(const void*) const; ///< Test whether memory is in the arena.
+    eRole GetRole(CShape*); ///< Get role of a shape.
+    CGate* GetGate(CShape*) const; ///< Get gate that a shape belongs to.
 
     void BroadPhase(); ///< Broad phase collision detection and response.
+    void GatherPairs(); ///< Gather shape pairs for the narrow phase.
     bool NarrowPhase(CShape*, CDynamicCircle*); ///< Narrow phase collision detection and response. 
+    void ProcessEvents(); ///< Play sounds, score, and light up objects for collision events.
+
+    bool Overlaps(CShape*, CDynamicCircle*); ///< Sensor overlap test.
+    void UpdateSensors(); ///< Sensor overlap tests for all balls.
+    void EndSensorFrame(); ///< Make stay and exit events for sensors.
+    void ExitSensors(CShape*); ///< Make exit events for a lost ball.
+    void RemoveContacts(CShape*); ///< Remove a ball from the sensors silently.
+
+    void GetGridShapes(std::vector<CShape*>&); ///< Get shapes for spatial index.
+
+    void MakeBall(const Vector2&); ///< Make a ball.
+    void RemoveBall(); ///< Remove the ball.
      
     void MakeBumper(UINT, const Vector2&, float, eSprite, eSprite, eSound , UINT); ///< Make a polygonal bumper.
 
@@ -52,8 +108,21 @@ class CObjectManager:
     void MakeThingL(); ///< Make a thing (left).
     void MakeThingR(); ///< Make a thing (right).
 
+  protected:
+    CFlipper* m_pLeftFlipper = nullptr; ///< Pointer to left flipper.
+    CFlipper* m_pRightFlipper = nullptr; ///< Pointer to right flipper.
+
+    CDynamicCircle* m_pBall = nullptr; ///< Pointer to current ball, if any.
+    bool m_bBallInPlay = false; ///< Is there a ball currently in play?
+    UINT m_nScore = 0; ///< Current score.
+    float m_fTime = 0.0f; ///< Time simulated so far in seconds.
+    float m_fWorldTimeStep = m_fTimeStep; ///< Time step for this world.
+    float m_fWorldGravity = m_fGravity; ///< Gravitational constant for this world.
+
+    virtual void PlaySound(eSound, const Vector2&, float=1.0f); ///< Play a sound.
+
   public:
-    ~CObjectManager(); ///< Destructor.
+    virtual ~CObjectManager(); ///< Destructor.
     
     CShape* AddShape(CShapeDesc*, const CObjDesc&); ///< Add shape.
 
@@ -63,9 +132,35 @@ class CObjectManager:
 
     void MakeWorldEdges(); ///< Create shapes for world edges.
     void MakeShapes(); ///< Create shapes.
+    void MakeGrid(); ///< Create spatial index.
+
+    bool LoadTable(const wchar_t*); ///< Create shapes and spatial index from a table file.
+    bool SaveTable(const wchar_t*); ///< Save shapes and spatial index to a table file.
+
+    bool RayCast(const Vector2&, const Vector2&, CRayHit&); ///< First hit on a ray.
+    UINT RayCastAll(const Vector2&, const Vector2&, CRayHit*, UINT); ///< All hits on a ray.
+    bool CircleCast(const Vector2&, const Vector2&, float, CRayHit&); ///< First hit by a swept circle.
+    UINT QueryPoint(const Vector2&, CShape**, UINT); ///< Shapes containing a point.
+    UINT QueryAABB(const CAabb2D&, CShape**, UINT); ///< Shapes overlapping an AABB.
     
     void LeftFlip(bool); ///< Flip left flipper.
     void RightFlip(bool); ///< Flip right flipper.
+
+    void LoadBall(); ///< Put a ball in the chute.
+    bool LaunchBall(float); ///< Launch the ball from the chute.
+    void Launch(float); ///< Press the launch button.
+    void AddBalls(UINT, UINT); ///< Add balls at random.
+
+    void SetPhysics(float, float); ///< Set time step and gravity.
+    void SetProfile(CMoveProfile*); ///< Set move profile.
+
+    const bool GetBallInPlay() const; ///< Is there a ball in play?
+    const UINT GetScore() const; ///< Get score.
+    const float GetTime() const; ///< Get time.
+    void GetHits(std::vector<UINT>&) const; ///< Get number of hits on each object.
+
+    bool Snapshot(CSnapshot&) const; ///< Save state to a snapshot.
+    void Rollback(const CSnapshot&); ///< Restore state from a snapshot.
 }; //CObjectManager
 
 #endif //__L4RC_GAME_OBJECTMANAGER_H__
@@ -9,31 +9,30 @@
 ////////////////////////////////////////////////////////////////////////////////////
 // CGate functions.
 
-/// Construct a closed and unlatched gate from a line segment.
+/// Construct a closed and unlatched gate from a line segment. The gate
+/// doesn't own the line segment, its maker is responsible for deleting it.
 /// \param p Pointer to a line segment.
 
 CGate::CGate(CLineSeg* p):
   m_pLineSeg(p){
 } //constructor
 
-CGate::~CGate(){
-  delete m_pLineSeg;
-} //destructor
-
 /// If a dynamic circle collides with a gate and it is moving in the
 /// correct direction, then the gate opens and the dynamic circle is
 /// allowed through. Otherwise the dynamic circle bounces off the
-/// gate as usual.
+/// gate as usual. Either way an event is recorded, which both plays
+/// the sound and marks the gate as occupied. A circle touching a gate
+/// that is already open records an event that only does the latter.
 /// \param p Pointer to a dynamic circle.
+/// \param events Event buffer.
 /// \return true if the dynamic circle bounces off the gate.
 
-bool CGate::NarrowPhase(CDynamicCircle* p){
+bool CGate::NarrowPhase(CDynamicCircle* p, CEventBuffer& events){
   bool bHit = false; //return result
   
   CContactDesc cd(m_pLineSeg, p); //contact descriptor
   
   if(m_pLineSeg->PreCollide(cd)){ //there's a collision 
-    m_bOccupied = true; //ball is in gate, holding it open
     bHit = true; //it's a hit
 
     if(!m_bOpen){ //gate is closed
@@ -43,23 +42,28 @@ bool CGate::NarrowPhase(CDynamicCircle* p){
       if(nhat.Dot(v) <= 0.0f){ //right way
         //m_pLineSeg->CanCollide(false); //disable collision
         m_bOpen = true; //mark open
-        
-        if(cd.m_fSpeed > 100.0f) 
-          m_pAudio->play(eSound::Tink, cd.m_vPOI);
+        events.Push(eEvent::GateOpen, m_pLineSeg, p, cd.m_vPOI, cd.m_fSpeed);
       } //if
 
       else{ //wrong way, bounce off 
         p->PostCollide(cd); //bounce off closed gate
-
-        if(cd.m_fSpeed > 100.0f) 
-          m_pAudio->play(eSound::Click, cd.m_vPOI, cd.m_fSpeed/1000.0f);
+        events.Push(eEvent::GateBounce, m_pLineSeg, p, cd.m_vPOI, cd.m_fSpeed);
       } //else
     } //if
+
+    else events.Push(eEvent::GateHold, m_pLineSeg, p, cd.m_vPOI, cd.m_fSpeed); //ball is in gate
   } //if
 
   return bHit;
 } //NarrowPhase
 
+/// Mark the gate as occupied, that is, held open by a ball in this frame.
+/// This is called for each of the gate's events.
+
+void CGate::Occupy(){
+  m_bOccupied = true;
+} //Occupy
+
 /// Close gate if open and there is no ball currently holding
 /// it open. Unset the occupied flag ready for use the the next frame.
 /// We assume that this is called at the end of the frame.
@@ -71,6 +75,29 @@ void CGate::CloseGate(){
   m_bOccupied = false; //assume no ball is holding the gate open in the next frame
 } //CloseGate
 
+/// Reader function for the line segment.
+/// \return Pointer to the line segment representing the gate.
+
+CLineSeg* CGate::GetLineSeg() const{
+  return m_pLineSeg;
+} //GetLineSeg
+
+/// Get the gate's state for a snapshot.
+/// \param s [out] Gate state.
+
+void CGate::GetState(CGateState& s) const{
+  s.m_bOpen = m_bOpen;
+  s.m_bOccupied = m_bOccupied;
+} //GetState
+
+/// Restore the gate's state from a snapshot.
+/// \param s Gate state.
+
+void CGate::SetState(const CGateState& s){
+  m_bOpen = s.m_bOpen;
+  m_bOccupied = s.m_bOccupied;
+} //SetState
+
 ////////////////////////////////////////////////////////////////////////////////////
 // CFlipper functions.
 
@@ -105,26 +132,29 @@ void CFlipper::Flip(bool bUp){
 
 /// Enforce bounds on the orientation of flipper, assuming that
 /// if it rotates counterclockwise then it is a right flipper,
-/// otherwise it is a left flipper.
+/// otherwise it is a left flipper. Reaching either bound makes an
+/// event so that the sound is played later with the collision sounds.
+/// \param events Event buffer.
 
-void CFlipper::EnforceBounds(){
+void CFlipper::EnforceBounds(CEventBuffer& events){
   const float down = (m_bCCW? 11.0f: 7.0f)*XM_PI/6.0f; //angle when fully down
   const float up = (m_bCCW? 1.0f: 3.0f)*XM_PI/4.0f; //angle when fully up
 
   const float a = m_pFlipper->GetOrientation(); //current angle
   const Vector2 pos = m_pFlipper->GetRotCenter(); //center of rotation
+  CShape* pShape = m_pFlipper->GetShapes()[0]; //identifies this flipper in events
 
   if(m_bCCW){ //rotating counterclockwise
     if(a < XM_PI && a > up){ //gone past up angle
       m_pFlipper->SetOrientation(up); //reset to up angle
       m_pFlipper->SetRotSpeed(0.0f); //stop
-      m_pAudio->play(eSound::FlipUp, pos);
+      events.Push(eEvent::FlipUp, pShape, nullptr, pos, 0.0f);
     } //if
 
     else if(a > XM_PI && a < down){ //gone past down angle
       m_pFlipper->SetOrientation(down); //reset to down angle
       m_pFlipper->SetRotSpeed(0.0f); //stop
-      m_pAudio->play(eSound::FlipDown, pos);
+      events.Push(eEvent::FlipDown, pShape, nullptr, pos, 0.0f);
     } //else if
   } //if
 
@@ -132,13 +162,43 @@ void CFlipper::EnforceBounds(){
     if(a < up){ //gone past up angle
       m_pFlipper->SetOrientation(up); //reset to up angle
       m_pFlipper->SetRotSpeed(0.0f); //stop
-      m_pAudio->play(eSound::FlipUp, pos);
+      events.Push(eEvent::FlipUp, pShape, nullptr, pos, 0.0f);
     } //if
   
     else if(a > down){ //gone past down angle
       m_pFlipper->SetOrientation(down); //reset to down angle
       m_pFlipper->SetRotSpeed(0.0f); //stop
-      m_pAudio->play(eSound::FlipDown, pos);
+      events.Push(eEvent::FlipDown, pShape, nullptr, pos, 0.0f);
     } //if
   } //else
-} //EnforceBounds
\ No newline at end of file
+} //EnforceBounds
+
+/// Reader function for the compound shape.
+/// \return Pointer to the compound shape that the flipper is made of.
+
+CCompoundShape* CFlipper::GetCompoundShape() const{
+  return m_pFlipper;
+} //GetCompoundShape
+
+/// Get the flipper's state for a snapshot.
+/// \param s [out] Flipper state.
+
+void CFlipper::GetState(CFlipperState& s) const{
+  s.m_fOrientation = m_pFlipper->GetOrientation();
+  s.m_fRotSpeed = m_pFlipper->GetRotSpeed();
+  s.m_bFlipUp = m_bFlipUp;
+} //GetState
+
+/// Restore the flipper's state from a snapshot. The shapes are rotated
+/// to the restored orientation straight away instead of at the next move,
+/// so that they are drawn and queried in the right place.
+/// \param s Flipper state.
+
+void CFlipper::SetState(const CFlipperState& s){
+  m_pFlipper->SetOrientation(s.m_fOrientation);
+  m_pFlipper->SetRotSpeed(s.m_fRotSpeed);
+  m_bFlipUp = s.m_bFlipUp;
+
+  for(auto const& p: m_pFlipper->GetShapes())
+    p->Rotate(p->GetRotCenter(), s.m_fOrientation);
+} //SetState
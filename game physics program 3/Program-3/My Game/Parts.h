@@ -11,6 +11,8 @@
 #include "Common.h"
 
 #include "Compound.h"
+#include "EventBuffer.h"
+#include "Snapshot.h"
 
 /// \brief A gate.
 ///
@@ -26,6 +28,11 @@
 /// segment's normal vector `CLineSeg::m_vNormal` then they can cross. Recall that
 /// the direction of `CLineSeg::m_vNormal` depends on the order in which
 /// `CLineSeg`'s end points were specified, so make sure you get it right.
+///
+/// The line segment is a one-way shape that lives in the spatial index with
+/// the rest of the table, so a gate is only tested when a ball is near it.
+/// Every contact makes an event, and the events that the object manager
+/// processes at the end of the frame are what mark the gate as occupied.
 
 class CGate: 
   public LComponent,
@@ -39,10 +46,14 @@ class CGate:
 
   public:
     CGate(CLineSeg* p); ///< Constructor.
-    ~CGate(); ///< Destructor.
 
+    void Occupy(); ///< Mark as held open by a ball.
     void CloseGate(); ///< Check latch to see if gate should be closed.
-    bool NarrowPhase(CDynamicCircle*); ///< Narrow phase collision detection and response.
+    bool NarrowPhase(CDynamicCircle*, CEventBuffer&); ///< Narrow phase collision detection and response.
+    CLineSeg* GetLineSeg() const; ///< Get line segment.
+
+    void GetState(CGateState&) const; ///< Get state.
+    void SetState(const CGateState&); ///< Set state.
 }; //CGate
 
 /// \brief A flipper.
@@ -73,7 +84,11 @@ class CFlipper:
     ~CFlipper(); ///< Destructor.
     
     void Flip(bool); ///< Flip flipper.
-    void EnforceBounds(); ///< Enforce bounds.
+    void EnforceBounds(CEventBuffer&); ///< Enforce bounds.
+    CCompoundShape* GetCompoundShape() const; ///< Get compound shape.
+
+    void GetState(CFlipperState&) const; ///< Get state.
+    void SetState(const CFlipperState&); ///< Set state.
 }; //CFlipper
 
 #endif //__L4RC_GAME_PARTS_H__
\ No newline at end of file
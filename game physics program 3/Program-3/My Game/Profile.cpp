@@ -0,0 +1,24 @@
+/// \file Profile.cpp
+/// \brief Code for the profile timer class CProfileTimer.
+
+#include "Profile.h"
+
+/// Start timing if there is a move profile.
+/// \param p Pointer to move profile, or nullptr for none.
+/// \param t Time in the move profile to add to.
+
+CProfileTimer::CProfileTimer(CMoveProfile* p, UINT64 CMoveProfile::* t){
+  if(p != nullptr){
+    m_pTime = &(p->*t);
+    m_tStart = std::chrono::steady_clock::now();
+  } //if
+} //constructor
+
+/// Add the elapsed time to the move profile, if there is one.
+
+CProfileTimer::~CProfileTimer(){
+  if(m_pTime != nullptr){
+    const auto dt = std::chrono::steady_clock::now() - m_tStart;
+    *m_pTime += (UINT64)std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count();
+  } //if
+} //destructor
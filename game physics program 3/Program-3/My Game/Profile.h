@@ -0,0 +1,42 @@
+/// \file Profile.h
+/// \brief Interface for the move profile class CMoveProfile and the profile timer class CProfileTimer.
+
+#ifndef __L4RC_GAME_PROFILE_H__
+#define __L4RC_GAME_PROFILE_H__
+
+#include <chrono>
+
+#include "GameDefines.h"
+
+/// \brief Move profile.
+///
+/// Where the time goes in `CObjectManager::move()`, accumulated
+/// over a number of frames. Times are in nanoseconds.
+
+class CMoveProfile{
+  public:
+    UINT64 m_nMotion = 0; ///< Time spent moving shapes.
+    UINT64 m_nBroad = 0; ///< Time spent gathering shape pairs to test.
+    UINT64 m_nNarrow = 0; ///< Time spent testing shape pairs and sensors.
+    UINT64 m_nUpdate = 0; ///< Time spent on flippers, gates, events, and objects.
+    UINT64 m_nPairs = 0; ///< Number of shape pairs tested.
+    UINT m_nFrames = 0; ///< Number of frames.
+}; //CMoveProfile
+
+/// \brief Profile timer.
+///
+/// Adds the time from its construction to its destruction to one of the
+/// times in a move profile. It does nothing if there is no move profile,
+/// so it costs a branch when the object manager isn't being profiled.
+
+class CProfileTimer{
+  private:
+    UINT64* m_pTime = nullptr; ///< Pointer to time to add to, if any.
+    std::chrono::steady_clock::time_point m_tStart; ///< Start time.
+
+  public:
+    CProfileTimer(CMoveProfile*, UINT64 CMoveProfile::*); ///< Constructor.
+    ~CProfileTimer(); ///< Destructor.
+}; //CProfileTimer
+
+#endif //__L4RC_GAME_PROFILE_H__
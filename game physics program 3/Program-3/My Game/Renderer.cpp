@@ -46,3 +46,119 @@ void CRenderer::LoadImages(){
 
   EndResourceUpload();
 } //LoadImages
+
+/// Make a line sprite for a line segment, that is, a single copy of a line
+/// sprite stretched to the segment's length and rotated to its angle, instead
+/// of the many sprites that `DrawLine()` tiles it with. This takes a square
+/// root and an arctangent, so line sprites should be made once and kept.
+/// \param t Sprite to draw the line with.
+/// \param p0 Start point.
+/// \param p1 End point.
+/// \param line [out] Line sprite.
+
+void CRenderer::MakeLine(eSprite t, const Vector2& p0, const Vector2& p1, CLineSprite& line){
+  const Vector2 dv = p1 - p0; //segment
+
+  line.m_vP0 = p0;
+  line.m_vP1 = p1;
+
+  LSpriteDesc2D& d = line.m_cDesc; //shorthand
+  d.m_nSpriteIndex = (UINT)t; 
+  d.m_vPos = 0.5f*(p0 + p1); //center of segment
+  d.m_fRoll = atan2f(dv.y, dv.x); //orientation angle
+  d.m_fXScale = dv.Length()/GetWidth(t); //stretch to length of segment
+} //MakeLine
+
+/// Draw line sprites made by `MakeLine()`. They are recorded into the draw
+/// list as lines. Since we're in batched mode, these all get sent to the
+/// GPU together.
+/// \param lines Line sprites.
+
+void CRenderer::DrawLines(std::vector<CLineSprite>& lines){
+  for(CLineSprite& l: lines){
+    if(m_pDrawList)
+      m_pDrawList->Line((uint16_t)l.m_cDesc.m_nSpriteIndex, l.m_vP0.x, l.m_vP0.y, l.m_vP1.x, l.m_vP1.y);
+
+    if(m_bSubmit)
+      LSpriteRenderer::Draw(&l.m_cDesc);
+  } //for
+} //DrawLines
+
+/// Start or stop recording draw calls into a draw list. With submission
+/// turned off the GPU is left alone, so the cost of making the draw calls
+/// can be measured by itself.
+/// \param p Pointer to a draw list, or nullptr to stop recording.
+/// \param submit Whether to pass draw calls on to the base class too.
+
+void CRenderer::SetDrawList(CDrawList* p, bool submit){
+  m_pDrawList = p;
+  m_bSubmit = submit || p == nullptr;
+} //SetDrawList
+
+/// Begin a frame, starting a new frame in the draw list if there is one.
+
+void CRenderer::BeginFrame(){
+  if(m_pDrawList)
+    m_pDrawList->BeginFrame();
+
+  if(m_bSubmit)
+    LSpriteRenderer::BeginFrame();
+} //BeginFrame
+
+/// End a frame.
+
+void CRenderer::EndFrame(){
+  if(m_bSubmit)
+    LSpriteRenderer::EndFrame();
+} //EndFrame
+
+/// Draw a sprite.
+/// \param t Sprite.
+/// \param pos Position.
+/// \param roll Orientation.
+
+void CRenderer::Draw(eSprite t, const Vector2& pos, float roll){
+  if(m_pDrawList)
+    m_pDrawList->Sprite((uint16_t)t, pos.x, pos.y, roll);
+
+  if(m_bSubmit)
+    LSpriteRenderer::Draw(t, pos, roll);
+} //Draw
+
+/// Draw a sprite from a sprite descriptor. Only its sprite, position,
+/// and orientation are recorded.
+/// \param p Pointer to sprite descriptor.
+
+void CRenderer::Draw(LSpriteDesc2D* p){
+  if(m_pDrawList)
+    m_pDrawList->Sprite((uint16_t)p->m_nSpriteIndex, p->m_vPos.x, p->m_vPos.y, p->m_fRoll);
+
+  if(m_bSubmit)
+    LSpriteRenderer::Draw(p);
+} //Draw
+
+/// Draw a line.
+/// \param t Sprite to draw the line with.
+/// \param p0 Start point.
+/// \param p1 End point.
+
+void CRenderer::DrawLine(eSprite t, const Vector2& p0, const Vector2& p1){
+  if(m_pDrawList)
+    m_pDrawList->Line((uint16_t)t, p0.x, p0.y, p1.x, p1.y);
+
+  if(m_bSubmit)
+    LSpriteRenderer::DrawLine(t, p0, p1);
+} //DrawLine
+
+/// Draw text in screen coordinates. The color isn't recorded.
+/// \param text Null-terminated text.
+/// \param pos Position.
+/// \param color Color.
+
+void CRenderer::DrawScreenText(const char* text, const Vector2& pos, const XMVECTORF32& color){
+  if(m_pDrawList)
+    m_pDrawList->Text(text, pos.x, pos.y);
+
+  if(m_bSubmit)
+    LSpriteRenderer::DrawScreenText(text, pos, color);
+} //DrawScreenText
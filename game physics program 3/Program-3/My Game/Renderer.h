@@ -4,19 +4,61 @@
 #ifndef __L4RC_GAME_RENDERER_H__
 #define __L4RC_GAME_RENDERER_H__
 
+#include <vector>
+
+#include "DrawList.h"
 #include "GameDefines.h"
 #include "SpriteRenderer.h"
 
+/// \brief Line sprite.
+///
+/// A line segment and a sprite descriptor that draws it as one copy of a line
+/// sprite stretched to its length and rotated to its angle. The end points are
+/// kept so that the segment can be recorded into a draw list as a line, and so
+/// that it can be moved without recomputing the angle and length.
+
+class CLineSprite{
+  public:
+    Vector2 m_vP0; ///< Start point.
+    Vector2 m_vP1; ///< End point.
+    LSpriteDesc2D m_cDesc; ///< Sprite descriptor.
+}; //CLineSprite
+
 /// \brief The renderer.
 ///
 /// CRenderer handles the game-specific rendering tasks, relying on
 /// the base class to do all of the actual API-specific rendering.
+/// The draw functions that the game uses hide the base class ones, so that
+/// every call can be recorded into a draw list. With submission turned off,
+/// nothing reaches the base class and the draw list is the only backend.
+///
+/// The base class draw functions are not virtual, and hiding them by name
+/// hides all of their overloads, not just the ones declared here. A draw call
+/// made through an `LSpriteRenderer` pointer or reference goes straight to the
+/// base class and is neither recorded nor suppressed, so the game must always
+/// draw through a `CRenderer`. An overload that isn't declared here can't be
+/// called on a `CRenderer` at all, and must be added here before it is used.
 
 class CRenderer: public LSpriteRenderer{
+  private:
+    CDrawList* m_pDrawList = nullptr; ///< Pointer to draw list being recorded, if any.
+    bool m_bSubmit = true; ///< Whether to pass draw calls on to the base class.
+
   public:
     CRenderer(); ///< Constructor.
 
     void LoadImages(); ///< Load images. 
+    void SetDrawList(CDrawList*, bool=true); ///< Set draw list to record into.
+
+    void BeginFrame(); ///< Begin a frame.
+    void EndFrame(); ///< End a frame.
+
+    void Draw(eSprite, const Vector2&, float=0.0f); ///< Draw a sprite.
+    void Draw(LSpriteDesc2D*); ///< Draw a sprite from a sprite descriptor.
+    void DrawLine(eSprite, const Vector2&, const Vector2&); ///< Draw a line.
+    void MakeLine(eSprite, const Vector2&, const Vector2&, CLineSprite&); ///< Make a line sprite.
+    void DrawLines(std::vector<CLineSprite>&); ///< Draw line sprites.
+    void DrawScreenText(const char*, const Vector2&, const XMVECTORF32& = Colors::Black); ///< Draw text.
 }; //CRenderer
 
 #endif //__L4RC_GAME_RENDERER_H__
\ No newline at end of file
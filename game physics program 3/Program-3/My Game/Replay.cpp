@@ -0,0 +1,311 @@
+/// \file Replay.cpp
+/// \brief Code for the replay classes CReplay, CReplayRecorder, and CReplayPlayer.
+
+#include <algorithm>
+#include <type_traits>
+
+#include "Replay.h"
+
+static_assert(sizeof(CReplayHeader) == 24, "replay header layout has changed");
+static_assert(std::is_trivially_copyable<CKeyframe>::value, "keyframes must be trivially copyable");
+
+/// Advance a xorshift random number generator, which is small enough
+/// to be saved in every keyframe.
+/// \param state [in, out] Generator state, must not be zero.
+/// \return A random number in [0, 1).
+
+static float NextRandom(UINT32& state){
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+
+  return (state >> 8)/16777216.0f;
+} //NextRandom
+
+/// Append an unsigned varint, 7 bits per byte with the high bit
+/// set on every byte except the last.
+/// \param v [in, out] Byte stream.
+/// \param n Number to append.
+
+static void PutVarint(std::vector<BYTE>& v, UINT32 n){
+  while(n >= 0x80){
+    v.push_back(BYTE(n | 0x80));
+    n >>= 7;
+  } //while
+
+  v.push_back(BYTE(n));
+} //PutVarint
+
+/// Read an unsigned varint.
+/// \param v Byte stream.
+/// \param offset [in, out] Offset of varint, moved past it.
+/// \param n [out] Number read.
+/// \return true if there was a whole varint to read.
+
+static bool GetVarint(const std::vector<BYTE>& v, UINT32& offset, UINT32& n){
+  n = 0;
+
+  for(UINT shift=0; shift<35 && offset<v.size(); shift+=7){
+    const BYTE b = v[offset++];
+    n |= UINT32(b & 0x7F) << shift;
+    if((b & 0x80) == 0)return true;
+  } //for
+
+  return false;
+} //GetVarint
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CReplay functions.
+
+/// Throw away the recording.
+
+void CReplay::Clear(){
+  m_nSeed = 0;
+  m_nNumFrames = 0;
+  m_stdStream.clear();
+  m_stdKeyframes.clear();
+} //Clear
+
+/// Save to a replay file.
+/// \param name File name.
+/// \return true if it was saved.
+
+bool CReplay::Save(const wchar_t* name) const{
+  CReplayHeader h = {0};
+
+  h.m_nMagic = REPLAY_MAGIC;
+  h.m_nVersion = REPLAY_VERSION;
+  h.m_nSeed = m_nSeed;
+  h.m_nNumFrames = m_nNumFrames;
+  h.m_nNumKeyframes = (UINT32)m_stdKeyframes.size();
+  h.m_nStreamSize = (UINT32)m_stdStream.size();
+
+  HANDLE hFile = CreateFileW(name, GENERIC_WRITE, 0, nullptr,
+    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(hFile == INVALID_HANDLE_VALUE)return false;
+
+  const DWORD ksize = DWORD(h.m_nNumKeyframes*sizeof(CKeyframe)); //size of keyframes
+  DWORD written[3] = {0}; //number of bytes written
+
+  const BOOL ok = WriteFile(hFile, &h, sizeof(h), &written[0], nullptr) &&
+    WriteFile(hFile, m_stdKeyframes.data(), ksize, &written[1], nullptr) &&
+    WriteFile(hFile, m_stdStream.data(), h.m_nStreamSize, &written[2], nullptr);
+  CloseHandle(hFile);
+
+  return ok && written[0] == sizeof(h) && written[1] == ksize &&
+    written[2] == h.m_nStreamSize;
+} //Save
+
+/// Load from a replay file.
+/// \param name File name.
+/// \return true if it was loaded, otherwise the replay is left empty.
+
+bool CReplay::Load(const wchar_t* name){
+  Clear();
+
+  HANDLE hFile = CreateFileW(name, GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(hFile == INVALID_HANDLE_VALUE)return false;
+
+  CReplayHeader h = {0};
+  DWORD read = 0; //number of bytes read
+  bool ok = ReadFile(hFile, &h, sizeof(h), &read, nullptr) && read == sizeof(h) &&
+    h.m_nMagic == REPLAY_MAGIC && h.m_nVersion == REPLAY_VERSION &&
+    h.m_nNumKeyframes > 0 && h.m_nNumKeyframes <= h.m_nNumFrames/REPLAY_KEYFRAME + 1;
+
+  if(ok){
+    m_stdKeyframes.resize(h.m_nNumKeyframes);
+    m_stdStream.resize(h.m_nStreamSize);
+
+    const DWORD ksize = DWORD(h.m_nNumKeyframes*sizeof(CKeyframe)); //size of keyframes
+
+    ok = ReadFile(hFile, m_stdKeyframes.data(), ksize, &read, nullptr) && read == ksize &&
+      ReadFile(hFile, m_stdStream.data(), h.m_nStreamSize, &read, nullptr) &&
+      read == h.m_nStreamSize;
+  } //if
+
+  CloseHandle(hFile);
+
+  for(UINT i=0; ok && i<m_stdKeyframes.size(); i++){ //check keyframes
+    const CKeyframe& k = m_stdKeyframes[i];
+    ok = k.m_nFrame == i*REPLAY_KEYFRAME && k.m_nOffset <= h.m_nStreamSize &&
+      k.m_nLastFrame <= k.m_nFrame && k.m_nRandom != 0 &&
+      k.m_cSnapshot.m_nNumObjects <= CSnapshot::MAXOBJECTS &&
+      k.m_cSnapshot.m_nNumContacts <= CSnapshot::MAXCONTACTS;
+  } //for
+
+  if(!ok){
+    Clear();
+    return false;
+  } //if
+
+  m_nSeed = h.m_nSeed;
+  m_nNumFrames = h.m_nNumFrames;
+
+  return true;
+} //Load
+
+/// Reader function for the number of frames.
+/// \return Number of frames recorded.
+
+const UINT32 CReplay::GetNumFrames() const{
+  return m_nNumFrames;
+} //GetNumFrames
+
+/// Get the size of the recording, which is what it takes up in memory
+/// and, give or take the header, on disk.
+/// \return Size in bytes.
+
+const size_t CReplay::GetSize() const{
+  return m_stdStream.size() + m_stdKeyframes.size()*sizeof(CKeyframe);
+} //GetSize
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CReplayRecorder functions.
+
+/// Throw away what is in a replay and start recording into it. The first
+/// frame always gets an input record, since the flippers in the first
+/// keyframe could be in either state.
+/// \param pReplay Pointer to replay.
+/// \param seed Random number seed.
+
+void CReplayRecorder::Begin(CReplay* pReplay, UINT32 seed){
+  m_pReplay = pReplay;
+  m_pReplay->Clear();
+  m_pReplay->m_nSeed = seed;
+
+  m_nFrame = 0;
+  m_nLastFrame = 0;
+  m_nRandom = seed == 0? 1: seed; //xorshift can't have a zero state
+  m_nInput = 0xFF; //force a record on the first frame
+} //Begin
+
+/// Record the input for the current frame, which only takes up space
+/// if a flipper has changed or the launch button has been pressed.
+/// \param input Bitwise OR of INPUT_LEFT, INPUT_RIGHT, and INPUT_LAUNCH.
+
+void CReplayRecorder::Record(BYTE input){
+  if(m_pReplay == nullptr || input == m_nInput)return;
+
+  PutVarint(m_pReplay->m_stdStream, m_nFrame - m_nLastFrame);
+  m_pReplay->m_stdStream.push_back(input);
+
+  m_nLastFrame = m_nFrame;
+  m_nInput = input & ~INPUT_LAUNCH;
+} //Record
+
+/// End the input for the current frame. This must be called after the input
+/// for the frame has been recorded and applied and before the frame is moved.
+/// A keyframe is saved on every `REPLAY_KEYFRAME`th frame. If the snapshot
+/// won't fit then recording stops, leaving what has been recorded so far.
+/// \param pObjMan Pointer to the object manager being recorded.
+
+void CReplayRecorder::Step(const CObjectManager* pObjMan){
+  if(m_pReplay == nullptr)return;
+
+  if(m_nFrame%REPLAY_KEYFRAME == 0){
+    auto& keys = m_pReplay->m_stdKeyframes; //shorthand
+    keys.emplace_back();
+    CKeyframe& k = keys.back();
+
+    k.m_nFrame = m_nFrame;
+    k.m_nOffset = (UINT32)m_pReplay->m_stdStream.size();
+    k.m_nLastFrame = m_nLastFrame;
+    k.m_nRandom = m_nRandom;
+
+    if(!pObjMan->Snapshot(k.m_cSnapshot)){ //too big, stop recording
+      keys.pop_back();
+      m_pReplay = nullptr;
+      return;
+    } //if
+  } //if
+
+  m_pReplay->m_nNumFrames = ++m_nFrame;
+} //Step
+
+/// Get a random number for the launch speed. While recording, all launch
+/// speeds must come from here so that the replay can make them again.
+/// \return A random number in [0, 1).
+
+float CReplayRecorder::Random(){
+  return NextRandom(m_nRandom);
+} //Random
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CReplayPlayer functions.
+
+/// Constructor.
+/// \param pReplay Pointer to replay.
+
+CReplayPlayer::CReplayPlayer(const CReplay* pReplay):
+  m_pReplay(pReplay){
+} //constructor
+
+/// Seek to a frame by rolling back to the last keyframe at or before it and
+/// then playing forward. Seeking to frame zero starts from the beginning.
+/// \param pObjMan Pointer to the object manager to play into.
+/// \param frame Frame number.
+
+void CReplayPlayer::Seek(CObjectManager* pObjMan, UINT32 frame){
+  const auto& keys = m_pReplay->m_stdKeyframes; //shorthand
+  if(keys.empty())return;
+
+  frame = std::min(frame, m_pReplay->m_nNumFrames);
+
+  const auto p = std::upper_bound(keys.begin(), keys.end(), frame,
+    [](UINT32 f, const CKeyframe& k){return f < k.m_nFrame;});
+  const CKeyframe& k = *(p - 1); //keyframes start at frame zero
+
+  pObjMan->Rollback(k.m_cSnapshot);
+  m_nFrame = k.m_nFrame;
+  m_nOffset = k.m_nOffset;
+  m_nLastFrame = k.m_nLastFrame;
+  m_nRandom = k.m_nRandom;
+
+  //the keyframe was taken after the input for its frame, so move it first
+
+  if(m_nFrame < frame){
+    pObjMan->move();
+    m_nFrame++;
+  } //if
+
+  while(m_nFrame < frame && Step(pObjMan));
+} //Seek
+
+/// Apply the input recorded for the current frame, then move.
+/// \param pObjMan Pointer to the object manager to play into.
+/// \return true if there are more frames to play.
+
+bool CReplayPlayer::Step(CObjectManager* pObjMan){
+  if(m_nFrame >= m_pReplay->m_nNumFrames)return false;
+
+  const auto& v = m_pReplay->m_stdStream; //shorthand
+  UINT32 offset = m_nOffset; //offset of next record
+  UINT32 delta = 0; //frames from last record
+
+  while(GetVarint(v, offset, delta) && offset < v.size() &&
+    m_nLastFrame + delta == m_nFrame)
+  {
+    const BYTE input = v[offset++];
+
+    pObjMan->LeftFlip((input & INPUT_LEFT) != 0);
+    pObjMan->RightFlip((input & INPUT_RIGHT) != 0);
+
+    if(input & INPUT_LAUNCH)
+      pObjMan->Launch(1000.0f + 1000.0f*NextRandom(m_nRandom));
+
+    m_nOffset = offset;
+    m_nLastFrame = m_nFrame;
+  } //while
+
+  pObjMan->move();
+
+  return ++m_nFrame < m_pReplay->m_nNumFrames;
+} //Step
+
+/// Reader function for the current frame number.
+/// \return Number of the next frame to be played.
+
+const UINT32 CReplayPlayer::GetFrame() const{
+  return m_nFrame;
+} //GetFrame
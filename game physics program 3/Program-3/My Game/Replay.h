@@ -0,0 +1,136 @@
+/// \file Replay.h
+/// \brief Interface for the replay classes CReplay, CReplayRecorder, and CReplayPlayer.
+
+#ifndef __L4RC_GAME_REPLAY_H__
+#define __L4RC_GAME_REPLAY_H__
+
+#include <vector>
+
+#include "ObjectManager.h"
+#include "Snapshot.h"
+
+const wchar_t REPLAY_FILE[] = L"replay.rpl"; ///< Replay file name.
+
+const UINT32 REPLAY_MAGIC = 0x4C505250; ///< Replay file magic number, "PRPL" in little-endian.
+const UINT32 REPLAY_VERSION = 1; ///< Replay file format version.
+const UINT32 REPLAY_KEYFRAME = 600; ///< Number of frames between keyframes.
+
+const BYTE INPUT_LEFT = 1; ///< Input flag for left flipper up.
+const BYTE INPUT_RIGHT = 2; ///< Input flag for right flipper up.
+const BYTE INPUT_LAUNCH = 4; ///< Input flag for the launch button being pressed.
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Replay file header.
+///
+/// A replay file is this header followed by the keyframes and then the
+/// input stream.
+
+class CReplayHeader{
+  public:
+    UINT32 m_nMagic; ///< Magic number, must be REPLAY_MAGIC.
+    UINT32 m_nVersion; ///< Format version, must be REPLAY_VERSION.
+    UINT32 m_nSeed; ///< Random number seed.
+    UINT32 m_nNumFrames; ///< Number of frames recorded.
+    UINT32 m_nNumKeyframes; ///< Number of keyframes.
+    UINT32 m_nStreamSize; ///< Size of input stream in bytes.
+}; //CReplayHeader
+
+/// \brief Keyframe.
+///
+/// Everything needed to start playing a replay part way through: a snapshot
+/// taken at the start of a frame, after that frame's input, along with where
+/// the input stream and the random number generator had got to.
+
+class CKeyframe{
+  public:
+    UINT32 m_nFrame; ///< Frame number.
+    UINT32 m_nOffset; ///< Offset into input stream of the next input record.
+    UINT32 m_nLastFrame; ///< Frame number of the last input record.
+    UINT32 m_nRandom; ///< Random number generator state.
+    CSnapshot m_cSnapshot; ///< Snapshot.
+}; //CKeyframe
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Replay.
+///
+/// A recording of a game, one frame per physics step. Input is stored as a
+/// stream of records, one for each frame in which the flippers change or the
+/// launch button is pressed. Each record is the number of frames since the
+/// previous record as a varint, which is 1 byte for anything under 128 frames,
+/// followed by a byte of input flags. Launch speeds come from a random number
+/// generator whose seed is stored in the replay, so they don't need recording.
+/// A keyframe every `REPLAY_KEYFRAME` frames makes the replay seekable.
+
+class CReplay{
+  friend class CReplayRecorder;
+  friend class CReplayPlayer;
+
+  private:
+    UINT32 m_nSeed = 0; ///< Random number seed.
+    UINT32 m_nNumFrames = 0; ///< Number of frames recorded.
+    std::vector<BYTE> m_stdStream; ///< Input stream.
+    std::vector<CKeyframe> m_stdKeyframes; ///< Keyframes.
+
+  public:
+    void Clear(); ///< Clear.
+
+    bool Save(const wchar_t*) const; ///< Save to a replay file.
+    bool Load(const wchar_t*); ///< Load from a replay file.
+
+    const UINT32 GetNumFrames() const; ///< Get number of frames.
+    const size_t GetSize() const; ///< Get size in bytes.
+}; //CReplay
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Replay recorder.
+///
+/// Records the input to an object manager into a replay. The input for a frame
+/// must be recorded before the frame is stepped. Recording costs a comparison
+/// per frame, plus a couple of bytes when the input changes and a snapshot
+/// every `REPLAY_KEYFRAME` frames.
+
+class CReplayRecorder{
+  private:
+    CReplay* m_pReplay = nullptr; ///< Pointer to replay being recorded.
+    UINT32 m_nFrame = 0; ///< Current frame number.
+    UINT32 m_nLastFrame = 0; ///< Frame number of the last input record.
+    UINT32 m_nRandom = 1; ///< Random number generator state.
+    BYTE m_nInput = 0; ///< Flipper input flags.
+
+  public:
+    void Begin(CReplay*, UINT32); ///< Start recording.
+    void Record(BYTE); ///< Record input for the current frame.
+    void Step(const CObjectManager*); ///< End the current frame's input.
+
+    float Random(); ///< Get a random number.
+}; //CReplayRecorder
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Replay player.
+///
+/// Plays a replay back into an object manager, which must have the same
+/// table as the one that it was recorded on. Nothing is drawn, so it runs
+/// as fast as the physics allows.
+
+class CReplayPlayer{
+  private:
+    const CReplay* m_pReplay = nullptr; ///< Pointer to replay being played.
+    UINT32 m_nFrame = 0; ///< Current frame number.
+    UINT32 m_nOffset = 0; ///< Offset into input stream of the next input record.
+    UINT32 m_nLastFrame = 0; ///< Frame number of the last input record.
+    UINT32 m_nRandom = 1; ///< Random number generator state.
+
+  public:
+    CReplayPlayer(const CReplay*); ///< Constructor.
+
+    void Seek(CObjectManager*, UINT32); ///< Seek to a frame.
+    bool Step(CObjectManager*); ///< Play a frame.
+
+    const UINT32 GetFrame() const; ///< Get current frame number.
+}; //CReplayPlayer
+
+#endif //__L4RC_GAME_REPLAY_H__
@@ -0,0 +1,85 @@
+/// \file Snapshot.h
+/// \brief Interface for the snapshot class CSnapshot and the state records that it is made of.
+
+#ifndef __L4RC_GAME_SNAPSHOT_H__
+#define __L4RC_GAME_SNAPSHOT_H__
+
+#include <type_traits>
+
+#include "GameDefines.h"
+
+/// \brief Gate state.
+
+class CGateState{
+  public:
+    bool m_bOpen; ///< true if gate is open.
+    bool m_bOccupied; ///< true if ball is holding gate open.
+}; //CGateState
+
+/// \brief Flipper state.
+
+class CFlipperState{
+  public:
+    float m_fOrientation; ///< Orientation.
+    float m_fRotSpeed; ///< Rotation speed.
+    bool m_bFlipUp; ///< Whether flipping up.
+}; //CFlipperState
+
+/// \brief Object state.
+///
+/// The state of an object's light and hit count.
+
+class CObjectState{
+  public:
+    float m_fLastHitTime; ///< Time of last hit.
+    UINT m_nHits; ///< Number of times hit hard enough to score.
+    bool m_bRecentHit; ///< Was hit recently.
+}; //CObjectState
+
+/// \brief Sensor contact state.
+///
+/// A sensor that the ball overlaps, by its index in the sensor list.
+
+class CContactState{
+  public:
+    UINT16 m_nSensor; ///< Index of sensor.
+    bool m_bSeen; ///< Whether they overlapped in the current frame.
+}; //CContactState
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Snapshot.
+///
+/// Everything about an object manager that changes while the game is played,
+/// between frames, in a fixed-size record with no pointers in it. It can be
+/// copied with `memcpy`, kept in an array, or written to a file, and restoring
+/// it takes no allocation unless a ball has to be made or removed. Things that
+/// never change, such as the shapes of the table, are left out.
+
+class CSnapshot{
+  public:
+    static const UINT MAXOBJECTS = 256; ///< Maximum number of objects.
+    static const UINT MAXCONTACTS = 16; ///< Maximum number of sensor contacts.
+
+    float m_fTime; ///< Time simulated so far in seconds.
+    UINT m_nScore; ///< Score.
+
+    bool m_bBallInPlay; ///< Is there a ball in play?
+    Vector2 m_vBallPos; ///< Ball position.
+    Vector2 m_vBallVel; ///< Ball velocity.
+
+    CFlipperState m_cLeftFlipper; ///< Left flipper state.
+    CFlipperState m_cRightFlipper; ///< Right flipper state.
+    CGateState m_cLeftGate; ///< Left gate state.
+    CGateState m_cRightGate; ///< Right gate state.
+
+    UINT m_nNumObjects; ///< Number of object states.
+    CObjectState m_pObject[MAXOBJECTS]; ///< Object states, balls excepted.
+
+    UINT m_nNumContacts; ///< Number of sensor contact states.
+    CContactState m_pContact[MAXCONTACTS]; ///< Sensor contact states.
+}; //CSnapshot
+
+static_assert(std::is_trivially_copyable<CSnapshot>::value, "CSnapshot must be trivially copyable");
+
+#endif //__L4RC_GAME_SNAPSHOT_H__
@@ -0,0 +1,468 @@
+/// \file Table.cpp
+/// \brief Code for the table file classes CTableFile and CTableWriter.
+
+#include <new>
+
+#include "Table.h"
+#include "Point.h"
+#include "LineSeg.h"
+#include "Circle.h"
+#include "Arc.h"
+
+static_assert(sizeof(CTableHeader) == 72, "table header layout has changed");
+static_assert(sizeof(CShapeRecord) == 56, "shape record layout has changed");
+static_assert(sizeof(CObjectRecord) == 20, "object record layout has changed");
+
+/// Check that an array of records lies inside a file and starts
+/// on a 4-byte boundary.
+/// \param offset Offset of the array from the start of the file.
+/// \param count Number of records.
+/// \param size Size of a record.
+/// \param filesize File size.
+/// \return true if the array is inside the file.
+
+static bool InFile(UINT32 offset, UINT64 count, size_t size, size_t filesize){
+  return offset%4 == 0 && offset + count*size <= filesize;
+} //InFile
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CTableFile functions.
+
+CTableFile::~CTableFile(){
+  Close();
+} //destructor
+
+/// Open a table file and map it into memory. The whole file must check out,
+/// otherwise it is closed again and the caller can make the table some other way.
+/// \param name File name.
+/// \return true if the file was opened and is a valid table file.
+
+bool CTableFile::Open(const wchar_t* name){
+  Close();
+
+  m_hFile = CreateFileW(name, GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(m_hFile == INVALID_HANDLE_VALUE)return false; //no file
+
+  LARGE_INTEGER size; //file size
+
+  if(!GetFileSizeEx(m_hFile, &size) || size.QuadPart < (LONGLONG)sizeof(CTableHeader)){
+    Close();
+    return false;
+  } //if
+
+  m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  if(m_hMapping != nullptr)
+    m_pData = (const BYTE*)MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+
+  if(m_pData == nullptr || !Validate((size_t)size.QuadPart)){
+    Close();
+    return false;
+  } //if
+
+  return true;
+} //Open
+
+/// Unmap and close the table file. Anything made from it that points
+/// into it, such as a loaded grid, must not be used afterwards.
+
+void CTableFile::Close(){
+  if(m_pData != nullptr)
+    UnmapViewOfFile(m_pData);
+
+  if(m_hMapping != nullptr)
+    CloseHandle(m_hMapping);
+
+  if(m_hFile != INVALID_HANDLE_VALUE)
+    CloseHandle(m_hFile);
+
+  m_hFile = INVALID_HANDLE_VALUE;
+  m_hMapping = nullptr;
+  m_pData = nullptr;
+
+  m_pHeader = nullptr;
+  m_pShapes = nullptr;
+  m_pMaterials = nullptr;
+  m_pObjects = nullptr;
+  m_pCellStart = nullptr;
+  m_pCellShapes = nullptr;
+} //Close
+
+/// Check the header, check that every section lies inside the file, and
+/// point the record pointers at their sections. Then check that every index
+/// in the records is in range, so that nothing made from them can read
+/// outside the file. This touches each record once but converts nothing.
+/// \param filesize File size.
+/// \return true if the file is a valid table file.
+
+bool CTableFile::Validate(size_t filesize){
+  const CTableHeader& h = *(const CTableHeader*)m_pData; //shorthand
+
+  if(h.m_nMagic != TABLE_MAGIC || h.m_nVersion != TABLE_VERSION || h.m_nSize != filesize)
+    return false;
+
+  if(h.m_nNumGridShapes > h.m_nNumShapes || h.m_nGridCols < 1 || h.m_nGridRows < 1 ||
+    !(h.m_fGridCellSize > 0.0f))
+      return false;
+
+  const UINT64 ncells = (UINT64)h.m_nGridCols*h.m_nGridRows; //number of grid cells
+
+  if(!InFile(h.m_nShapeOffset,     h.m_nNumShapes,     sizeof(CShapeRecord),    filesize) ||
+     !InFile(h.m_nMaterialOffset,  h.m_nNumMaterials,  sizeof(CMaterialRecord), filesize) ||
+     !InFile(h.m_nObjectOffset,    h.m_nNumObjects,    sizeof(CObjectRecord),   filesize) ||
+     !InFile(h.m_nCellStartOffset, ncells + 1,         sizeof(UINT),            filesize) ||
+     !InFile(h.m_nCellShapeOffset, h.m_nNumCellShapes, sizeof(UINT),            filesize))
+    return false;
+
+  //pointer fixup
+
+  m_pHeader = &h;
+  m_pShapes = (const CShapeRecord*)(m_pData + h.m_nShapeOffset);
+  m_pMaterials = (const CMaterialRecord*)(m_pData + h.m_nMaterialOffset);
+  m_pObjects = (const CObjectRecord*)(m_pData + h.m_nObjectOffset);
+  m_pCellStart = (const UINT*)(m_pData + h.m_nCellStartOffset);
+  m_pCellShapes = (const UINT*)(m_pData + h.m_nCellShapeOffset);
+
+  //grid cells
+
+  if(m_pCellStart[0] != 0 || m_pCellStart[ncells] != h.m_nNumCellShapes)
+    return false;
+
+  for(UINT64 c=0; c<ncells; c++)
+    if(m_pCellStart[c] > m_pCellStart[c + 1])
+      return false;
+
+  for(UINT k=0; k<h.m_nNumCellShapes; k++)
+    if(m_pCellShapes[k] >= h.m_nNumGridShapes)
+      return false;
+
+  //shapes
+
+  UINT nRoles[(UINT)eRole::Size] = {0}; //number of shapes in each role
+
+  for(UINT i=0; i<h.m_nNumShapes; i++){
+    const CShapeRecord& r = m_pShapes[i];
+
+    switch((eShape)r.m_nShape){
+      case eShape::Point: case eShape::LineSeg: case eShape::Circle: case eShape::Arc: break;
+      default: return false;
+    } //switch
+
+    if(r.m_nMotion != (UINT8)eMotion::Static && r.m_nMotion != (UINT8)eMotion::Kinematic)
+      return false;
+
+    if(r.m_nRole >= (UINT8)eRole::Size || r.m_nMaterial >= h.m_nNumMaterials ||
+      r.m_nObject >= h.m_nNumObjects)
+        return false;
+
+    const eRole role = (eRole)r.m_nRole;
+
+    if((role == eRole::LeftGate || role == eRole::RightGate) &&
+      ((eShape)r.m_nShape != eShape::LineSeg || (r.m_nFlags & TABLE_ONEWAY) == 0 ||
+        i >= h.m_nNumGridShapes))
+        return false; //gates are one-way line segments in the grid
+
+    nRoles[r.m_nRole]++;
+  } //for
+
+  if(nRoles[(UINT)eRole::LeftGate] != 1 || nRoles[(UINT)eRole::RightGate] != 1 ||
+    nRoles[(UINT)eRole::LeftFlipper] == 0 || nRoles[(UINT)eRole::RightFlipper] == 0)
+      return false;
+
+  //objects
+
+  for(UINT i=0; i<h.m_nNumObjects; i++){
+    const CObjectRecord& r = m_pObjects[i];
+
+    if(r.m_nUnlitSprite >= (UINT)eSprite::Size || r.m_nLitSprite >= (UINT)eSprite::Size ||
+      r.m_nSound > (UINT)eSound::Size)
+        return false;
+  } //for
+
+  return true;
+} //Validate
+
+/// Reader function for the number of shapes.
+/// \return Number of shape records.
+
+UINT CTableFile::GetNumShapes() const{
+  return m_pHeader? m_pHeader->m_nNumShapes: 0;
+} //GetNumShapes
+
+/// Reader function for the number of shapes in the grid.
+/// \return Number of shape records at the start that the grid refers to.
+
+UINT CTableFile::GetNumGridShapes() const{
+  return m_pHeader? m_pHeader->m_nNumGridShapes: 0;
+} //GetNumGridShapes
+
+/// Get the size of the class of the shape that a record describes, so that
+/// the caller can allocate memory for all of the shapes at once.
+/// \param i Shape record index.
+/// \return Size in bytes.
+
+size_t CTableFile::GetShapeSize(UINT i) const{
+  const bool k = m_pShapes[i].m_nMotion == (UINT8)eMotion::Kinematic;
+
+  switch((eShape)m_pShapes[i].m_nShape){
+    case eShape::Point:   return k? sizeof(CKinematicPoint):   sizeof(CPoint);
+    case eShape::LineSeg: return k? sizeof(CKinematicLineSeg): sizeof(CLineSeg);
+    case eShape::Circle:  return k? sizeof(CKinematicCircle):  sizeof(CCircle);
+    case eShape::Arc:     return k? sizeof(CKinematicArc):     sizeof(CArc);
+  } //switch
+
+  return 0;
+} //GetShapeSize
+
+/// Reader function for the motion type of a shape.
+/// \param i Shape record index.
+/// \return Motion type.
+
+eMotion CTableFile::GetMotionType(UINT i) const{
+  return (eMotion)m_pShapes[i].m_nMotion;
+} //GetMotionType
+
+/// Reader function for the role of a shape.
+/// \param i Shape record index.
+/// \return Role.
+
+eRole CTableFile::GetRole(UINT i) const{
+  return (eRole)m_pShapes[i].m_nRole;
+} //GetRole
+
+/// Construct the shape that a record describes in memory provided by the
+/// caller, which must be at least GetShapeSize(i) bytes and suitably aligned.
+/// The shape must be destroyed by calling its destructor, not by delete.
+/// \param i Shape record index.
+/// \param p Pointer to memory for the shape.
+/// \return Pointer to the shape.
+
+CShape* CTableFile::MakeShape(UINT i, void* p) const{
+  const CShapeRecord& r = m_pShapes[i]; //shorthand
+  const bool k = r.m_nMotion == (UINT8)eMotion::Kinematic;
+  const float e = m_pMaterials[r.m_nMaterial].m_fElasticity;
+
+  CShape* pShape = nullptr; //result
+
+  switch((eShape)r.m_nShape){
+    case eShape::Point: {
+      CPointDesc d(r.m_vPos, e);
+      d.m_eMotionType = (eMotion)r.m_nMotion;
+      d.m_bIsSensor = (r.m_nFlags & TABLE_SENSOR) != 0;
+      if(k)pShape = new(p) CKinematicPoint(d);
+      else pShape = new(p) CPoint(d);
+    } //case
+    break;
+
+    case eShape::LineSeg: {
+      CLineSegDesc d(r.m_vPt0, r.m_vPt1, e);
+      d.m_eMotionType = (eMotion)r.m_nMotion;
+      d.m_bIsSensor = (r.m_nFlags & TABLE_SENSOR) != 0;
+      d.m_bOneWay = (r.m_nFlags & TABLE_ONEWAY) != 0;
+      if(k)pShape = new(p) CKinematicLineSeg(d);
+      else pShape = new(p) CLineSeg(d);
+    } //case
+    break;
+
+    case eShape::Circle: {
+      CCircleDesc d(r.m_vPos, r.m_fRadius, e);
+      d.m_eMotionType = (eMotion)r.m_nMotion;
+      d.m_bIsSensor = (r.m_nFlags & TABLE_SENSOR) != 0;
+      if(k)pShape = new(p) CKinematicCircle(d);
+      else pShape = new(p) CCircle(d);
+    } //case
+    break;
+
+    case eShape::Arc: {
+      CArcDesc d(r.m_vPos, r.m_fRadius, r.m_fAngle0, r.m_fAngle1, e);
+      d.m_eMotionType = (eMotion)r.m_nMotion;
+      d.m_bIsSensor = (r.m_nFlags & TABLE_SENSOR) != 0;
+      if(k)pShape = new(p) CKinematicArc(d);
+      else pShape = new(p) CArc(d);
+    } //case
+    break;
+  } //switch
+
+  pShape->SetCanCollide((r.m_nFlags & TABLE_NOCOLLIDE) == 0);
+
+  if(k){
+    pShape->SetRotCenter(r.m_vRotCenter);
+    pShape->SetOrientation(r.m_fOrientation);
+  } //if
+
+  return pShape;
+} //MakeShape
+
+/// Get the object descriptor for a shape from its object record.
+/// \param i Shape record index.
+/// \return Object descriptor.
+
+CObjDesc CTableFile::GetObjDesc(UINT i) const{
+  const CObjectRecord& r = m_pObjects[m_pShapes[i].m_nObject]; //shorthand
+
+  CObjDesc d((eSprite)r.m_nUnlitSprite, (eSprite)r.m_nLitSprite, (eSound)r.m_nSound);
+  d.m_vSpriteOffset = r.m_vSpriteOffset;
+  d.m_nScore = r.m_nScore;
+
+  return d;
+} //GetObjDesc
+
+/// Load a grid from the table file. The grid uses the cell arrays in
+/// place, so this file must stay open for as long as the grid is used.
+/// \param grid [out] The grid.
+/// \param shapes Shapes made from the first GetNumGridShapes() records, in order.
+
+void CTableFile::LoadGrid(CGrid& grid, const std::vector<CShape*>& shapes) const{
+  const CTableHeader& h = *m_pHeader; //shorthand
+
+  grid.Load(h.m_vGridOrigin, h.m_fGridCellSize, h.m_nGridCols, h.m_nGridRows,
+    m_pCellStart, m_pCellShapes, shapes);
+} //LoadGrid
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CTableWriter functions.
+
+/// Find a material record with a given elasticity, adding one if there isn't one.
+/// \param e Elasticity.
+/// \return Index of material record.
+
+UINT16 CTableWriter::AddMaterial(float e){
+  for(UINT16 i=0; i<(UINT16)m_stdMaterials.size(); i++)
+    if(m_stdMaterials[i].m_fElasticity == e)
+      return i;
+
+  CMaterialRecord r = {e};
+  m_stdMaterials.push_back(r);
+
+  return (UINT16)(m_stdMaterials.size() - 1);
+} //AddMaterial
+
+/// Find an object record matching an object descriptor, adding one if there isn't one.
+/// \param d Object descriptor.
+/// \return Index of object record.
+
+UINT16 CTableWriter::AddObject(const CObjDesc& d){
+  CObjectRecord r = {0};
+  r.m_nUnlitSprite = (UINT16)d.m_eUnlitSprite;
+  r.m_nLitSprite = (UINT16)d.m_eLitSprite;
+  r.m_nSound = (UINT16)d.m_eSound;
+  r.m_nScore = d.m_nScore;
+  r.m_vSpriteOffset = d.m_vSpriteOffset;
+
+  for(UINT16 i=0; i<(UINT16)m_stdObjects.size(); i++){
+    const CObjectRecord& s = m_stdObjects[i]; //shorthand
+
+    if(s.m_nUnlitSprite == r.m_nUnlitSprite && s.m_nLitSprite == r.m_nLitSprite &&
+      s.m_nSound == r.m_nSound && s.m_nScore == r.m_nScore &&
+      s.m_vSpriteOffset == r.m_vSpriteOffset)
+        return i;
+  } //for
+
+  m_stdObjects.push_back(r);
+
+  return (UINT16)(m_stdObjects.size() - 1);
+} //AddObject
+
+/// Add a record for a static or kinematic shape. Kinematic shapes must not
+/// have been rotated yet, since they are recorded in their unrotated geometry.
+/// \param p Pointer to a shape.
+/// \param d Object descriptor for the shape.
+/// \param role What the shape is used for.
+
+void CTableWriter::AddShape(CShape* p, const CObjDesc& d, eRole role){
+  CShapeRecord r = {0};
+
+  r.m_nShape = (UINT8)p->GetShapeType();
+  r.m_nMotion = (UINT8)p->GetMotionType();
+  r.m_nRole = (UINT8)role;
+  r.m_nFlags = (p->GetSensor()? TABLE_SENSOR: 0) | (p->GetCanCollide()? 0: TABLE_NOCOLLIDE) |
+    (p->GetOneWay()? TABLE_ONEWAY: 0);
+  r.m_nMaterial = AddMaterial(p->GetElasticity());
+  r.m_nObject = AddObject(d);
+  r.m_vPos = p->GetPos();
+
+  switch(p->GetShapeType()){
+    case eShape::LineSeg: {
+      CLineSeg* pLineSeg = (CLineSeg*)p;
+      pLineSeg->GetEndPts(r.m_vPt0, r.m_vPt1);
+
+      if(perp(r.m_vPt0 - r.m_vPt1).Dot(pLineSeg->GetNormal()) < 0.0f) //normal faces the other way
+        std::swap(r.m_vPt0, r.m_vPt1);
+    } //case
+    break;
+
+    case eShape::Circle:
+      r.m_fRadius = ((CCircle*)p)->GetRadius();
+    break;
+
+    case eShape::Arc:
+      r.m_fRadius = ((CArc*)p)->GetRadius();
+      ((CArc*)p)->GetAngles(r.m_fAngle0, r.m_fAngle1);
+    break;
+  } //switch
+
+  if(p->GetMotionType() == eMotion::Kinematic){
+    r.m_vRotCenter = p->GetRotCenter();
+    r.m_fOrientation = p->GetOrientation();
+  } //if
+
+  m_stdShapes.push_back(r);
+} //AddShape
+
+/// Save the records to a table file along with a grid. The grid's shape
+/// numbers must match the order in which the shapes were added, so the
+/// first shapes added must be the ones in the grid. The whole file is laid
+/// out in memory first and written in one go.
+/// \param name File name.
+/// \param grid Grid built over the first shapes added.
+/// \return true if the file was written.
+
+bool CTableWriter::Save(const wchar_t* name, const CGrid& grid){
+  const UINT ncells = grid.GetNumCols()*grid.GetNumRows(); //number of grid cells
+
+  CTableHeader h = {0};
+  h.m_nMagic = TABLE_MAGIC;
+  h.m_nVersion = TABLE_VERSION;
+
+  h.m_nNumShapes = (UINT32)m_stdShapes.size();
+  h.m_nNumGridShapes = grid.GetNumShapes();
+  h.m_nNumMaterials = (UINT32)m_stdMaterials.size();
+  h.m_nNumObjects = (UINT32)m_stdObjects.size();
+  h.m_nNumCellShapes = grid.GetNumCellShapes();
+
+  h.m_vGridOrigin = grid.GetOrigin();
+  h.m_fGridCellSize = grid.GetCellSize();
+  h.m_nGridCols = grid.GetNumCols();
+  h.m_nGridRows = grid.GetNumRows();
+
+  //lay out the sections, every record size is a multiple of 4
+
+  h.m_nShapeOffset = sizeof(CTableHeader);
+  h.m_nMaterialOffset = h.m_nShapeOffset + h.m_nNumShapes*sizeof(CShapeRecord);
+  h.m_nObjectOffset = h.m_nMaterialOffset + h.m_nNumMaterials*sizeof(CMaterialRecord);
+  h.m_nCellStartOffset = h.m_nObjectOffset + h.m_nNumObjects*sizeof(CObjectRecord);
+  h.m_nCellShapeOffset = h.m_nCellStartOffset + (ncells + 1)*sizeof(UINT);
+  h.m_nSize = h.m_nCellShapeOffset + h.m_nNumCellShapes*sizeof(UINT);
+
+  std::vector<BYTE> blob(h.m_nSize); //file contents
+
+  memcpy(blob.data(), &h, sizeof(CTableHeader));
+  memcpy(blob.data() + h.m_nShapeOffset, m_stdShapes.data(), h.m_nNumShapes*sizeof(CShapeRecord));
+  memcpy(blob.data() + h.m_nMaterialOffset, m_stdMaterials.data(), h.m_nNumMaterials*sizeof(CMaterialRecord));
+  memcpy(blob.data() + h.m_nObjectOffset, m_stdObjects.data(), h.m_nNumObjects*sizeof(CObjectRecord));
+  memcpy(blob.data() + h.m_nCellStartOffset, grid.GetCellStart(), (ncells + 1)*sizeof(UINT));
+  memcpy(blob.data() + h.m_nCellShapeOffset, grid.GetCellShapes(), h.m_nNumCellShapes*sizeof(UINT));
+
+  //write it
+
+  HANDLE hFile = CreateFileW(name, GENERIC_WRITE, 0, nullptr,
+    CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(hFile == INVALID_HANDLE_VALUE)return false;
+
+  DWORD written = 0; //number of bytes written
+  const BOOL ok = WriteFile(hFile, blob.data(), (DWORD)blob.size(), &written, nullptr);
+  CloseHandle(hFile);
+
+  return ok && written == blob.size();
+} //Save
@@ -0,0 +1,178 @@
+/// \file Table.h
+/// \brief Interface for the table file records and the classes CTableFile and CTableWriter.
+
+#ifndef __L4RC_GAME_TABLE_H__
+#define __L4RC_GAME_TABLE_H__
+
+#include <vector>
+
+#include "GameDefines.h"
+#include "Grid.h"
+#include "Object.h"
+
+const wchar_t TABLE_FILE[] = L"Media\\pinball.tbl"; ///< Table file name.
+
+const UINT32 TABLE_MAGIC = 0x4C425450; ///< Table file magic number, "PTBL" in little-endian.
+const UINT32 TABLE_VERSION = 2; ///< Table file format version.
+
+const UINT8 TABLE_SENSOR = 1; ///< Shape record flag for sensors.
+const UINT8 TABLE_NOCOLLIDE = 2; ///< Shape record flag for shapes that can't collide.
+const UINT8 TABLE_ONEWAY = 4; ///< Shape record flag for one-way shapes.
+
+/// \brief Shape role.
+///
+/// What a shape in a table file is used for besides being
+/// a shape, so that the parts made out of it can be rebuilt.
+/// `Size` must be last.
+
+enum class eRole: UINT8{
+  None, LeftGate, RightGate, LeftFlipper, RightFlipper, Bumper,
+  Size //MUST be last
+}; //eRole
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Table file header.
+///
+/// A table file is a flat little-endian blob that starts with this header.
+/// Each section is an array of records that starts at a byte offset from
+/// the start of the file, and every offset is a multiple of 4. The shape
+/// records come first in the order that the grid numbers them, so the grid's
+/// cell arrays can be used straight out of the file.
+
+class CTableHeader{
+  public:
+    UINT32 m_nMagic; ///< Magic number, must be TABLE_MAGIC.
+    UINT32 m_nVersion; ///< Format version, must be TABLE_VERSION.
+    UINT32 m_nSize; ///< File size in bytes.
+
+    UINT32 m_nNumShapes; ///< Number of shape records.
+    UINT32 m_nNumGridShapes; ///< Number of shapes in the grid, which are the first ones.
+    UINT32 m_nNumMaterials; ///< Number of material records.
+    UINT32 m_nNumObjects; ///< Number of object records.
+    UINT32 m_nNumCellShapes; ///< Number of grid cell shape numbers.
+
+    UINT32 m_nShapeOffset; ///< Offset of shape records.
+    UINT32 m_nMaterialOffset; ///< Offset of material records.
+    UINT32 m_nObjectOffset; ///< Offset of object records.
+    UINT32 m_nCellStartOffset; ///< Offset of grid cell start indices.
+    UINT32 m_nCellShapeOffset; ///< Offset of grid cell shape numbers.
+
+    Vector2 m_vGridOrigin; ///< Bottom left corner of grid.
+    float m_fGridCellSize; ///< Width and height of a grid cell.
+    INT32 m_nGridCols; ///< Number of columns of grid cells.
+    INT32 m_nGridRows; ///< Number of rows of grid cells.
+}; //CTableHeader
+
+/// \brief Table file shape record.
+///
+/// Everything needed to construct a static or kinematic shape. Kinematic
+/// shapes are recorded in their unrotated geometry along with their center
+/// of rotation and orientation.
+
+class CShapeRecord{
+  public:
+    UINT8 m_nShape; ///< Shape type, an eShape.
+    UINT8 m_nMotion; ///< Motion type, an eMotion.
+    UINT8 m_nRole; ///< Role, an eRole.
+    UINT8 m_nFlags; ///< Bitwise OR of TABLE_SENSOR, TABLE_NOCOLLIDE, and TABLE_ONEWAY.
+    UINT16 m_nMaterial; ///< Index of material record.
+    UINT16 m_nObject; ///< Index of object record.
+
+    Vector2 m_vPos; ///< Position.
+    Vector2 m_vPt0; ///< Line segment end point, its normal is counterclockwise from m_vPt0 - m_vPt1.
+    Vector2 m_vPt1; ///< Line segment end point.
+    float m_fRadius; ///< Circle or arc radius.
+    float m_fAngle0; ///< Arc start angle.
+    float m_fAngle1; ///< Arc end angle.
+
+    Vector2 m_vRotCenter; ///< Center of rotation for kinematic shapes.
+    float m_fOrientation; ///< Orientation for kinematic shapes.
+}; //CShapeRecord
+
+/// \brief Table file material record.
+
+class CMaterialRecord{
+  public:
+    float m_fElasticity; ///< Elasticity.
+}; //CMaterialRecord
+
+/// \brief Table file object record.
+///
+/// The sprites, sound, and score that link a shape to the game.
+
+class CObjectRecord{
+  public:
+    UINT16 m_nUnlitSprite; ///< Unlit sprite, an eSprite.
+    UINT16 m_nLitSprite; ///< Lit sprite, an eSprite.
+    UINT16 m_nSound; ///< Collision sound, an eSound.
+    UINT16 m_nPadding; ///< Unused, zero.
+    UINT32 m_nScore; ///< Score for collision.
+    Vector2 m_vSpriteOffset; ///< Sprite offset in local coordinates.
+}; //CObjectRecord
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Table file.
+///
+/// A table file mapped into memory. Opening it checks that every section lies
+/// inside the file and that every index is in range, after which the records
+/// are read where they lie, with no parsing and no copying. Shapes are
+/// constructed in memory provided by the caller, so that a whole table
+/// can be made with a single allocation.
+
+class CTableFile{
+  private:
+    HANDLE m_hFile = INVALID_HANDLE_VALUE; ///< File handle.
+    HANDLE m_hMapping = nullptr; ///< File mapping handle.
+    const BYTE* m_pData = nullptr; ///< Mapped file contents.
+
+    const CTableHeader* m_pHeader = nullptr; ///< Pointer to header.
+    const CShapeRecord* m_pShapes = nullptr; ///< Pointer to shape records.
+    const CMaterialRecord* m_pMaterials = nullptr; ///< Pointer to material records.
+    const CObjectRecord* m_pObjects = nullptr; ///< Pointer to object records.
+    const UINT* m_pCellStart = nullptr; ///< Pointer to grid cell start indices.
+    const UINT* m_pCellShapes = nullptr; ///< Pointer to grid cell shape numbers.
+
+    bool Validate(size_t); ///< Check header and records, and fix up pointers.
+
+  public:
+    ~CTableFile(); ///< Destructor.
+
+    bool Open(const wchar_t*); ///< Open and map a table file.
+    void Close(); ///< Unmap and close.
+
+    UINT GetNumShapes() const; ///< Get number of shapes.
+    UINT GetNumGridShapes() const; ///< Get number of shapes in the grid.
+    size_t GetShapeSize(UINT) const; ///< Get size of a shape's class.
+    eMotion GetMotionType(UINT) const; ///< Get motion type of a shape.
+    eRole GetRole(UINT) const; ///< Get role of a shape.
+    CShape* MakeShape(UINT, void*) const; ///< Construct a shape in place.
+    CObjDesc GetObjDesc(UINT) const; ///< Get object descriptor for a shape.
+
+    void LoadGrid(CGrid&, const std::vector<CShape*>&) const; ///< Load grid.
+}; //CTableFile
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Table file writer.
+///
+/// Gathers shapes and their object descriptors into records, sharing
+/// identical material and object records, and saves them to a table file
+/// along with a grid built over the first shapes.
+
+class CTableWriter{
+  private:
+    std::vector<CShapeRecord> m_stdShapes; ///< Shape records.
+    std::vector<CMaterialRecord> m_stdMaterials; ///< Material records.
+    std::vector<CObjectRecord> m_stdObjects; ///< Object records.
+
+    UINT16 AddMaterial(float); ///< Add material record.
+    UINT16 AddObject(const CObjDesc&); ///< Add object record.
+
+  public:
+    void AddShape(CShape*, const CObjDesc&, eRole); ///< Add shape record.
+    bool Save(const wchar_t*, const CGrid&); ///< Save table file.
+}; //CTableWriter
+
+#endif //__L4RC_GAME_TABLE_H__
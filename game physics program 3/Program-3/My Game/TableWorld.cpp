@@ -0,0 +1,69 @@
+/// \file TableWorld.cpp
+/// \brief Code for the table world class CTableWorld.
+
+#include "TableWorld.h"
+
+const float FLIP_REACH = 75.0f; ///< Distance from a flipper's center of rotation at which it gets flipped.
+
+/// Make the table from the table file if there is one, otherwise in code.
+/// \param seed Random number seed.
+
+CTableWorld::CTableWorld(UINT seed):
+  m_cRandom(seed),
+  m_nSeed(seed)
+{
+  if(!LoadTable(TABLE_FILE)){
+    MakeWorldEdges(); //make world edges
+    MakeShapes(); //make shapes
+    MakeGrid(); //make spatial index
+  } //if
+} //constructor
+
+/// Play no sound, since there may be many table worlds at once
+/// and none of them are being watched.
+/// \param s Sound.
+/// \param pos Position of sound.
+/// \param volume Volume.
+
+void CTableWorld::PlaySound(eSound s, const Vector2& pos, float volume){
+} //PlaySound
+
+/// Flip each flipper up while the ball is falling within its reach, and let
+/// it fall back down otherwise. This is a crude player, but a consistent one.
+
+void CTableWorld::AutoFlip(){
+  const Vector2 p = m_pBall->GetPos(); //ball position
+  const bool bFalling = m_pBall->GetVel().y < 0.0f; //whether ball is falling
+
+  const Vector2 left = m_pLeftFlipper->GetCompoundShape()->GetRotCenter();
+  const Vector2 right = m_pRightFlipper->GetCompoundShape()->GetRotCenter();
+
+  LeftFlip(bFalling && (p - left).Length() < FLIP_REACH);
+  RightFlip(bFalling && (p - right).Length() < FLIP_REACH);
+} //AutoFlip
+
+/// Play one ball from loading it into the chute until it drains
+/// or the time limit is reached, and record what happened.
+/// \param tmax Time limit in seconds.
+/// \param r [out] What happened.
+
+void CTableWorld::Run(float tmax, CWorldResult& r){
+  std::uniform_real_distribution<float> u(0.0f, 1.0f);
+  bool bLaunched = false; //whether the ball has been launched
+
+  LoadBall();
+
+  while(m_bBallInPlay && m_fTime < tmax){
+    if(!bLaunched)
+      bLaunched = LaunchBall(1000.0f + 1000.0f*u(m_cRandom));
+    else AutoFlip();
+
+    move();
+  } //while
+
+  r.m_nSeed = m_nSeed;
+  r.m_nScore = m_nScore;
+  r.m_bDrained = !m_bBallInPlay;
+  r.m_fDrainTime = m_fTime;
+  GetHits(r.m_stdHits);
+} //Run
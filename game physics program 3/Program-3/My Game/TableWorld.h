@@ -0,0 +1,47 @@
+/// \file TableWorld.h
+/// \brief Interface for the world result class CWorldResult and the table world class CTableWorld.
+
+#ifndef __L4RC_GAME_TABLEWORLD_H__
+#define __L4RC_GAME_TABLEWORLD_H__
+
+#include <random>
+#include <vector>
+
+#include "ObjectManager.h"
+
+/// \brief World result.
+///
+/// What happened to the ball in a table world.
+
+class CWorldResult{
+  public:
+    UINT m_nSeed = 0; ///< Random number seed.
+    UINT m_nScore = 0; ///< Final score.
+    bool m_bDrained = false; ///< Whether the ball drained before the time limit.
+    float m_fDrainTime = 0.0f; ///< Time at which the ball drained, or the time limit if it didn't.
+    std::vector<UINT> m_stdHits; ///< Number of scoring hits on each object.
+}; //CWorldResult
+
+/// \brief Table world.
+///
+/// An object manager that plays a single ball by itself, without sound. It
+/// loads the ball, launches it at a random speed, and works the flippers
+/// whenever the ball comes down within their reach, until the ball drains
+/// or time runs out. It has its own shapes, score, time, and random number
+/// generator, so table worlds can be simulated on different threads at once.
+
+class CTableWorld: public CObjectManager{
+  private:
+    std::mt19937 m_cRandom; ///< Random number generator.
+    UINT m_nSeed = 0; ///< Random number seed.
+
+    void PlaySound(eSound, const Vector2&, float); ///< Play no sound.
+    void AutoFlip(); ///< Work the flippers.
+
+  public:
+    CTableWorld(UINT); ///< Constructor.
+
+    void Run(float, CWorldResult&); ///< Play one ball.
+}; //CTableWorld
+
+#endif //__L4RC_GAME_TABLEWORLD_H__
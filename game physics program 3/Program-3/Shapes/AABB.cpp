@@ -3,7 +3,7 @@
 
 #include "AABB.h"
 
-int CAabb2D::m_nTestCount = 0;
+thread_local int CAabb2D::m_nTestCount = 0;
 
 //////////////////////////////////////////////////////////////////////////////////////
 //Constructors.
@@ -90,28 +90,28 @@ void CAabb2D::Translate(const Vector2& p){
 /// Reader function for the width.
 /// \return AABB width.
 
-float CAabb2D::GetWidth(){
+float CAabb2D::GetWidth() const{
   return m_vBottomRt.x - m_vTopLeft.x;
 } //GetWidth
 
 /// Reader function for the height.
 /// \return AABB height.
 
-float CAabb2D::GetHt(){
+float CAabb2D::GetHt() const{
   return m_vTopLeft.y - m_vBottomRt.y;
 } //GetHt
 
 /// Reader function for the top left corner.
 /// \return The top left corner.
 
-const Vector2& CAabb2D::GetTopLeft(){
+const Vector2& CAabb2D::GetTopLeft() const{
   return m_vTopLeft;
 } //GetTopLeft
 
 /// Reader function for the bottom right corner.
 /// \return The bottom right corner.
 
-const Vector2& CAabb2D::GetBottomRt(){
+const Vector2& CAabb2D::GetBottomRt() const{
   return m_vBottomRt;
 } //GetBottomRt
 
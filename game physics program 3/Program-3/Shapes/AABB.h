@@ -25,7 +25,7 @@ class CAabb2D{
     Vector2 m_vTopLeft; ///< Top left point.
     Vector2 m_vBottomRt; ///< Bottom right point.
 
-    static int m_nTestCount; ///< Number of AABB to AABB intersection tests.
+    static thread_local int m_nTestCount; ///< Number of AABB to AABB intersection tests on this thread.
 
   public:
     CAabb2D(const Vector2&, const Vector2& ); ///< Constructor.
@@ -39,10 +39,10 @@ class CAabb2D{
     friend bool operator&&(const CAabb2D&, const CAabb2D&); ///< AABB intersection test.
     friend bool operator&&(const CAabb2D&, const Vector2&); ///< AABB intersection test.
 
-    float GetWidth(); ///< Get width of AABB.
-    float GetHt(); ///< Get height of AABB.
-    const Vector2& GetTopLeft(); ///< Get top left corner.
-    const Vector2& GetBottomRt(); ///< Get bottom right corner.
+    float GetWidth() const; ///< Get width of AABB.
+    float GetHt() const; ///< Get height of AABB.
+    const Vector2& GetTopLeft() const; ///< Get top left corner.
+    const Vector2& GetBottomRt() const; ///< Get bottom right corner.
 
     int GetTestCount(); ///< Get number of AABB to AABB intersection tests.
 }; //CAabb2D
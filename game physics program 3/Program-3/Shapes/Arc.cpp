@@ -152,6 +152,55 @@ bool CArc::PreCollide(CContactDesc& c){
   return poi.PreCollide(c);
 } //PreCollide
 
+/// Cast a circle along a ray and find where it first hits this arc.
+/// The swept circle hits the arc when its center enters a band around the
+/// arc whose half-width is the radius, either from outside the band (that is,
+/// entering the outer circle) or from inside (that is, leaving the inner
+/// circle), or when its center hits a circle of that radius at either end point.
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param t [out] Fraction of the way along the ray at the first hit.
+/// \param n [out] Unit normal at the hit.
+/// \return true if there was a hit.
+
+bool CArc::RayCast(const Vector2& p, const Vector2& d, float r, float& t, Vector2& n){
+  float tmin = 2.0f; //time of first hit, anything over 1 means no hit
+  float t0, t1; //roots
+
+  const Vector2 c = GetPos(); //center
+
+  if(RayCircleRoots(p, d, c, m_fRadius + r, t0, t1) && t0 >= 0.0f){ //enters outer circle
+    const Vector2 q = p + t0*d;
+
+    if(PtInSector(q)){
+      tmin = t0;
+      n = Normalize(q - c);
+    } //if
+  } //if
+
+  if(m_fRadius > r && RayCircleRoots(p, d, c, m_fRadius - r, t0, t1) && t1 >= 0.0f && t1 < tmin){ //leaves inner circle
+    const Vector2 q = p + t1*d;
+
+    if(PtInSector(q)){
+      tmin = t1;
+      n = Normalize(c - q);
+    } //if
+  } //if
+
+  if(r > 0.0f) //swept circle can hit the ends
+    for(const Vector2& e: {m_vPt0, m_vPt1})
+      if(RayCircleRoots(p, d, e, r, t0, t1) && t0 >= 0.0f && t0 < tmin){
+        tmin = t0;
+        n = Normalize(p + t0*d - e);
+      } //if
+
+  FailIf(tmin > 1.0f); //no hit
+
+  t = tmin;
+  return true;
+} //RayCast
+
 /// Reader function for the end points.
 /// \param p0 [out] First end point.
 /// \param p1 [out] Second end point.
@@ -169,6 +218,16 @@ void CArc::GetTangents(Vector2& v0, Vector2& v1){
   v0 = m_vTangent0; v1 = m_vTangent1;
 } //GetTangents
 
+/// Reader function for the angles. Angles are returned
+/// in the same order as GetEndPoints(). The arc extends
+/// counterclockwise from the first to the second.
+/// \param a0 [out] Angle from center to first end point.
+/// \param a1 [out] Angle from center to second end point.
+
+void CArc::GetAngles(float& a0, float& a1){
+  a0 = m_fAngle0; a1 = m_fAngle1;
+} //GetAngles
+
 ///////////////////////////////////////////////////////////////////////////////////
 // CKinematicArc functions.
 
@@ -203,5 +262,13 @@ void CKinematicArc::Reset(){
   Update();
 } //Reset
 
+/// Get the radius of the smallest disk centered at the center of rotation
+/// that contains this shape at every orientation.
+/// \return Radius of swept area.
+
+float CKinematicArc::GetSweepRadius() const{
+  return (m_vOldPos - m_vRotCenter).Length() + m_fRadius;
+} //GetSweepRadius
+
 
 
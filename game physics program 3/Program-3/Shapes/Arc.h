@@ -62,11 +62,13 @@ class CArc: public CCircle{
     CArc(CArcDesc&); ///< Constructor.
 
     bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool RayCast(const Vector2&, const Vector2&, float, float&, Vector2&); ///< Ray or swept circle cast.
 
     bool PtInSector(const Vector2&); ///< Point in sector test.
     
     void GetEndPts(Vector2&, Vector2&); ///< Get end points.
     void GetTangents(Vector2&, Vector2&); ///< Get tangents.   
+    void GetAngles(float&, float&); ///< Get angles.
 }; //CArc
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,6 +88,7 @@ class CKinematicArc: public CArc{
     
     void Rotate(const Vector2&, float); ///< Rotate.
     void Reset(); ///< Reset orientation.
+    float GetSweepRadius() const; ///< Get radius of swept area.
 }; //CKinematicArc
 
 #endif //__L4RC_PHYSICS_ARC_H__
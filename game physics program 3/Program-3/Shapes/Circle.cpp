@@ -82,6 +82,28 @@ bool CCircle::PreCollide(CContactDesc& c){
   return CPoint(poi).PreCollide(c);
 } //PreCollide
 
+/// Cast a circle along a ray and find where it first hits this circle. 
+/// That happens when the ray enters a circle with the same center whose radius
+/// is the sum of the radii.
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param t [out] Fraction of the way along the ray at the hit.
+/// \param n [out] Unit normal at the hit.
+/// \return true if there was a hit.
+
+bool CCircle::RayCast(const Vector2& p, const Vector2& d, float r, float& t, Vector2& n){
+  float t0, t1; //roots
+
+  FailIf(!RayCircleRoots(p, d, GetPos(), m_fRadius + r, t0, t1)); //misses completely
+  FailIf(t0 < 0.0f || t0 > 1.0f); //starts inside or falls short
+
+  t = t0;
+  n = Normalize(p + t0*d - GetPos());
+
+  return true;
+} //RayCast
+
 /// Compute the points of intersection of tangents passing through a point.
 /// Note that there are two possible tangents to a circle that pass through
 /// a given point outside the circle. If the point is inside the circle,
@@ -198,3 +220,11 @@ void CKinematicCircle::Reset(){
   SetPos(m_vOldPos);
 } //Reset
 
+/// Get the radius of the smallest disk centered at the center of rotation
+/// that contains this shape at every orientation.
+/// \return Radius of swept area.
+
+float CKinematicCircle::GetSweepRadius() const{
+  return (m_vOldPos - m_vRotCenter).Length() + m_fRadius;
+} //GetSweepRadius
+
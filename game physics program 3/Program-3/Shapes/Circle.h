@@ -35,6 +35,7 @@ class CCircle: public CShape{
     CCircle(const CCircleDesc&); ///< Constructor.
 
     bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool RayCast(const Vector2&, const Vector2&, float, float&, Vector2&); ///< Ray or swept circle cast.
     
     bool PtInCircle(const Vector2&); ///< Point in circle test.
     Vector2 ClosestPt(const Vector2&); ///< Closest point on circle.
@@ -61,6 +62,7 @@ class CKinematicCircle: public CCircle{
     
     void Rotate(const Vector2&, float); ///< Rotate.
     void Reset(); ///< Reset orientation.
+    float GetSweepRadius() const; ///< Get radius of swept area.
 }; //CKinematicCircle
 
 #endif //__L4RC_PHYSICS_CIRCLE_H__
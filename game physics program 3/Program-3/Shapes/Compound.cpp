@@ -83,4 +83,9 @@ float CCompoundShape::GetRotSpeed(){
   else return 0.0f;
 } //GetRotSpeed
 
+/// Reader function for the shape list.
+/// \return The shape list.
 
+const std::vector<CShape*>& CCompoundShape::GetShapes() const{
+  return m_stdShapes;
+} //GetShapes
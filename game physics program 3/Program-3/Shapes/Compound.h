@@ -29,6 +29,8 @@ class CCompoundShape{
     float GetOrientation(); ///< Get orientation.
     float GetRotSpeed(); ///< Get rotation speed.
     Vector2 GetRotCenter(); ///< Get center of rotation.
+
+    const std::vector<CShape*>& GetShapes() const; ///< Get shape list.
 }; //CCompoundShape
 
 #endif //__L4RC_PHYSICS_COMPOUND_H__
@@ -129,12 +129,33 @@ void CDynamicCircle::PostCollide(const CContactDesc& cd){
   } //switch
 } //PostCollide
 
+/// Collision response for a dynamic circle hit by a kinematic shape part way
+/// through its last rotation, as found by CShape::SweptPreCollide. After the
+/// usual response, if the shape was swinging into this circle then the circle
+/// is carried around the center of rotation through the rest of the rotation,
+/// so that it ends up touching the shape in its current orientation instead
+/// of inside or behind it.
+/// \param cd Contact descriptor that has been filled in by collision detection.
+/// \param s Fraction of the kinematic shape's last rotation at the time of impact.
+
+void CDynamicCircle::PostCollideSwept(const CContactDesc& cd, float s){
+  PostCollideKinematic(cd);
+
+  CShape* p = cd.m_pShape; //pointer to the kinematic shape being collided with
+  const Vector2 v = p->GetRotDelta()*perp(cd.m_vPOI - p->GetRotCenter()); //POI's motion direction
+
+  if(s < 1.0f && v.Dot(cd.m_vNorm) > 0.0f) //swinging into this circle
+    SetPos(RotatePt(GetPos(), p->GetRotCenter(), (1.0f - s)*p->GetRotDelta()));
+} //PostCollideSwept
+
 /// Move the shape using Euler integration, depending on the
 /// physics time step and the gravity constant.
+/// \param dt Time step.
+/// \param g Gravitational constant.
 
-void CDynamicCircle::move(){ 
-  SetPos(GetPos() + m_fTimeStep*m_vVel); //move
-  m_vVel.y += m_fTimeStep*m_fGravity; //acceleration due to gravity
+void CDynamicCircle::move(float dt, float g){ 
+  SetPos(GetPos() + dt*m_vVel); //move
+  m_vVel.y += dt*g; //acceleration due to gravity
 } //move
 
 /// Reader function for the velocity.
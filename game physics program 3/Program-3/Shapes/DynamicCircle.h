@@ -36,10 +36,11 @@ class CDynamicCircle: public CCircle{
 
   public:
     CDynamicCircle(const CDynamicCircleDesc&); ///< Constructor.
-    void move(); ///< Move using Euler integration.
+    void move(float, float); ///< Move using Euler integration.
     
     bool AABBCollide(CDynamicCircle*);  ///< Collide detection using AABBs.
     void PostCollide(const CContactDesc&);  ///< Collision response 
+    void PostCollideSwept(const CContactDesc&, float); ///< Collision response at time of impact.
 
     Vector2 GetVel(); ///< Get velocity.  
     void SetVel(const Vector2&); ///< Set velocity.
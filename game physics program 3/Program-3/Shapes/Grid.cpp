@@ -0,0 +1,502 @@
+/// \file Grid.cpp
+/// \brief Code for the uniform grid class CGrid.
+
+#include <algorithm>
+#include <cfloat>
+
+#include "Grid.h"
+#include "Circle.h"
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CGrid functions for building the grid.
+
+/// Build the grid from a list of shapes. The grid covers a given AABB, extended
+/// if necessary to cover all of the shapes. The shape numbers for each cell are
+/// gathered in two passes, the first counts them and the second fills them in,
+/// so that they end up in one contiguous array.
+/// \param box AABB to be covered by the grid.
+/// \param size Width and height of a cell.
+/// \param shapes List of static and kinematic shapes.
+
+void CGrid::Build(const CAabb2D& box, float size, const std::vector<CShape*>& shapes){
+  Clear();
+  m_stdShapes = shapes;
+
+  CAabb2D ext = box; //extent of grid
+
+  for(auto const& p: m_stdShapes){ //extend to cover all shapes
+    const CAabb2D b = GetInsertionAABB(p);
+    ext += b.GetTopLeft();
+    ext += b.GetBottomRt();
+  } //for
+
+  m_vOrigin = Vector2(ext.GetTopLeft().x, ext.GetBottomRt().y);
+  m_fCellSize = size;
+  m_fInvCellSize = 1.0f/size;
+  m_nCols = (std::max)(1, (int)ceilf(ext.GetWidth()*m_fInvCellSize));
+  m_nRows = (std::max)(1, (int)ceilf(ext.GetHt()*m_fInvCellSize));
+
+  const UINT ncells = m_nCols*m_nRows; //number of cells
+  m_stdCellStart.assign(ncells + 1, 0);
+
+  //first pass, count the shapes in each cell
+
+  for(auto const& p: m_stdShapes){
+    int i0, j0, i1, j1;
+    GetCellRange(GetInsertionAABB(p), i0, j0, i1, j1);
+
+    for(int j=j0; j<=j1; j++)
+      for(int i=i0; i<=i1; i++)
+        m_stdCellStart[j*m_nCols + i + 1]++;
+  } //for
+
+  for(UINT c=1; c<=ncells; c++) //prefix sum converts counts to start indices
+    m_stdCellStart[c] += m_stdCellStart[c - 1];
+
+  //second pass, fill in the shape numbers
+
+  m_stdCellShapes.resize(m_stdCellStart[ncells]);
+  std::vector<UINT> next(m_stdCellStart.begin(), m_stdCellStart.end() - 1); //next free slot in each cell
+
+  for(UINT s=0; s<m_stdShapes.size(); s++){
+    int i0, j0, i1, j1;
+    GetCellRange(GetInsertionAABB(m_stdShapes[s]), i0, j0, i1, j1);
+
+    for(int j=j0; j<=j1; j++)
+      for(int i=i0; i<=i1; i++)
+        m_stdCellShapes[next[j*m_nCols + i]++] = s;
+  } //for
+
+  m_pCellStart = m_stdCellStart.data();
+  m_pCellShapes = m_stdCellShapes.data();
+
+  m_stdStamp.assign(m_stdShapes.size(), 0);
+  m_nStamp = 0;
+} //Build
+
+/// Load a grid that was built earlier, for example by Build in a tool
+/// that saved it to a file. The cell arrays are used in place and not copied,
+/// so they must outlive the grid or the next call to Clear. The shape numbers
+/// in the cells index the shape list.
+/// \param origin Bottom left corner of grid.
+/// \param size Width and height of a cell.
+/// \param cols Number of columns of cells.
+/// \param rows Number of rows of cells.
+/// \param start Index of each cell's first shape number, plus one for the end.
+/// \param cells Shape numbers grouped by cell.
+/// \param shapes List of static and kinematic shapes.
+
+void CGrid::Load(const Vector2& origin, float size, int cols, int rows,
+  const UINT* start, const UINT* cells, const std::vector<CShape*>& shapes)
+{
+  Clear();
+  m_stdShapes = shapes;
+
+  m_vOrigin = origin;
+  m_fCellSize = size;
+  m_fInvCellSize = 1.0f/size;
+  m_nCols = cols;
+  m_nRows = rows;
+
+  m_pCellStart = start;
+  m_pCellShapes = cells;
+
+  m_stdStamp.assign(m_stdShapes.size(), 0);
+  m_nStamp = 0;
+} //Load
+
+/// Remove all shapes from the grid. The shapes themselves are not deleted.
+
+void CGrid::Clear(){
+  m_stdShapes.clear();
+  m_stdCellStart.clear();
+  m_stdCellShapes.clear();
+  m_stdStamp.clear();
+
+  m_pCellStart = nullptr;
+  m_pCellShapes = nullptr;
+
+  m_nCols = m_nRows = 0;
+  m_nStamp = 0;
+} //Clear
+
+/// Get the AABB with which a shape is inserted into the grid. For a kinematic
+/// shape this is the AABB of the circle swept out by the corners of its
+/// AABB as it rotates about its center of rotation, which covers the shape
+/// at every orientation.
+/// \param p Pointer to a shape.
+/// \return AABB to insert the shape with.
+
+CAabb2D CGrid::GetInsertionAABB(CShape* p) const{
+  CAabb2D b = p->GetAABB();
+
+  if(p->GetMotionType() == eMotion::Kinematic){
+    const Vector2 c = p->GetRotCenter();
+    const Vector2& tl = b.GetTopLeft();
+    const Vector2& br = b.GetBottomRt();
+
+    float r = 0.0f; //radius of swept circle
+
+    for(const Vector2& v: {tl, br, Vector2(tl.x, br.y), Vector2(br.x, tl.y)})
+      r = (std::max)(r, (v - c).Length());
+
+    b = CAabb2D(c + Vector2(-r, r), c + Vector2(r, -r));
+  } //if
+
+  return b;
+} //GetInsertionAABB
+
+/// Get the range of cells that overlap an AABB, clamped to the grid.
+/// \param b An AABB.
+/// \param i0 [out] Leftmost column.
+/// \param j0 [out] Bottom row.
+/// \param i1 [out] Rightmost column.
+/// \param j1 [out] Top row.
+
+void CGrid::GetCellRange(const CAabb2D& b, int& i0, int& j0, int& i1, int& j1) const{
+  GetCell(Vector2(b.GetTopLeft().x, b.GetBottomRt().y), i0, j0);
+  GetCell(Vector2(b.GetBottomRt().x, b.GetTopLeft().y), i1, j1);
+} //GetCellRange
+
+/// Get the cell that contains a point, clamped to the grid.
+/// \param p A point.
+/// \param i [out] Column.
+/// \param j [out] Row.
+
+void CGrid::GetCell(const Vector2& p, int& i, int& j) const{
+  i = (int)floorf((p.x - m_vOrigin.x)*m_fInvCellSize);
+  j = (int)floorf((p.y - m_vOrigin.y)*m_fInvCellSize);
+
+  i = (std::max)(0, (std::min)(m_nCols - 1, i));
+  j = (std::max)(0, (std::min)(m_nRows - 1, j));
+} //GetCell
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CGrid functions for queries.
+
+/// Start a new query by bumping the stamp. If it wraps around to zero,
+/// clear all of the shape stamps so that no shape looks already tested.
+
+void CGrid::NextStamp(){
+  if(++m_nStamp == 0){ //wrapped around
+    m_stdStamp.assign(m_stdStamp.size(), 0);
+    m_nStamp = 1;
+  } //if
+} //NextStamp
+
+/// Insert a hit into a list of hits sorted by time, keeping at most
+/// a given number of the nearest hits.
+/// \param buf Hit buffer.
+/// \param count Number of hits currently in the buffer.
+/// \param n Size of the buffer.
+/// \param hit Hit to be inserted.
+/// \return Number of hits in the buffer afterwards.
+
+UINT CGrid::InsertHit(CRayHit* buf, UINT count, UINT n, const CRayHit& hit){
+  if(n == 0)return 0; //no buffer
+  if(count == n && hit.m_fTime >= buf[n - 1].m_fTime)return count; //full of nearer hits
+
+  UINT i = (std::min)(count, n - 1); //slot to fill, the farthest hit falls off the end if full
+
+  while(i > 0 && buf[i - 1].m_fTime > hit.m_fTime){ //make room
+    buf[i] = buf[i - 1];
+    i--;
+  } //while
+
+  buf[i] = hit;
+  return (std::min)(count + 1, n);
+} //InsertHit
+
+/// Cast a ray or swept circle against the untested shapes in one cell.
+/// \param i Column.
+/// \param j Row.
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param buf Hit buffer.
+/// \param n Size of hit buffer.
+/// \param count Number of hits currently in the buffer.
+/// \return Number of hits in the buffer afterwards.
+
+UINT CGrid::CastCell(int i, int j, const Vector2& p, const Vector2& d, float r,
+  CRayHit* buf, UINT n, UINT count)
+{
+  const UINT cell = j*m_nCols + i;
+
+  for(UINT k=m_pCellStart[cell]; k<m_pCellStart[cell + 1]; k++){
+    const UINT s = m_pCellShapes[k]; //shape number
+
+    if(m_stdStamp[s] != m_nStamp){ //not tested yet in this query
+      m_stdStamp[s] = m_nStamp;
+      CShape* pShape = m_stdShapes[s];
+      CRayHit hit;
+
+      if(pShape->GetCanCollide() && pShape->RayCast(p, d, r, hit.m_fTime, hit.m_vNorm)){
+        hit.m_pShape = pShape;
+        hit.m_vPos = p + hit.m_fTime*d;
+        count = InsertHit(buf, count, n, hit);
+      } //if
+    } //if
+  } //for
+
+  return count;
+} //CastCell
+
+/// Cast a ray or swept circle through the grid. A ray walks the cells that
+/// it passes through in order (J. Amanatides and A. Woo, "A fast voxel
+/// traversal algorithm for ray tracing", Eurographics, 1987), and stops as
+/// soon as the buffer holds hits that are nearer than anything in the cells
+/// that it hasn't reached yet. A swept circle tests the cells that overlap the
+/// AABB of the region that it sweeps out.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param buf Hit buffer.
+/// \param n Size of hit buffer.
+/// \return Number of hits in the buffer, nearest first.
+
+UINT CGrid::Cast(const Vector2& p0, const Vector2& p1, float r, CRayHit* buf, UINT n){
+  if(n == 0 || m_stdShapes.empty())return 0; //nothing to do
+
+  NextStamp();
+
+  const Vector2 d = p1 - p0; //ray vector
+  UINT count = 0; //number of hits
+
+  if(r > 0.0f){ //swept circle
+    CAabb2D box(p0 + Vector2(-r, r), p0 + Vector2(r, -r));
+    box += p1 + Vector2(-r, r);
+    box += p1 + Vector2(r, -r);
+
+    int i0, j0, i1, j1;
+    GetCellRange(box, i0, j0, i1, j1);
+
+    for(int j=j0; j<=j1; j++)
+      for(int i=i0; i<=i1; i++)
+        count = CastCell(i, j, p0, d, r, buf, n, count);
+
+    return count;
+  } //if
+
+  //clip the ray to the grid
+
+  const float lo[2] = {m_vOrigin.x, m_vOrigin.y}; //bottom left of grid
+  const float hi[2] = {lo[0] + m_nCols*m_fCellSize, lo[1] + m_nRows*m_fCellSize}; //top right of grid
+  const float p[2] = {p0.x, p0.y}; //start of ray
+  const float v[2] = {d.x, d.y}; //ray vector
+
+  float tmin = 0.0f; //time ray enters grid
+  float tmax = 1.0f; //time ray leaves grid
+
+  for(int k=0; k<2; k++){
+    if(v[k] == 0.0f){ //parallel to this axis
+      if(p[k] < lo[k] || p[k] > hi[k])return 0; //and outside the grid
+    } //if
+
+    else{
+      float ta = (lo[k] - p[k])/v[k];
+      float tb = (hi[k] - p[k])/v[k];
+      if(ta > tb)std::swap(ta, tb);
+
+      tmin = (std::max)(tmin, ta);
+      tmax = (std::min)(tmax, tb);
+    } //else
+  } //for
+
+  if(tmin > tmax)return 0; //ray misses grid
+
+  //walk the cells
+
+  int i, j; //current cell
+  GetCell(p0 + tmin*d, i, j);
+
+  const int di = d.x > 0.0f? 1: -1; //column step
+  const int dj = d.y > 0.0f? 1: -1; //row step
+
+  const float dtx = d.x != 0.0f? m_fCellSize/fabsf(d.x): FLT_MAX; //time to cross a column
+  const float dty = d.y != 0.0f? m_fCellSize/fabsf(d.y): FLT_MAX; //time to cross a row
+
+  float tx = d.x != 0.0f? (m_vOrigin.x + (di > 0? i + 1: i)*m_fCellSize - p0.x)/d.x: FLT_MAX; //time to next column
+  float ty = d.y != 0.0f? (m_vOrigin.y + (dj > 0? j + 1: j)*m_fCellSize - p0.y)/d.y: FLT_MAX; //time to next row
+
+  while(true){
+    count = CastCell(i, j, p0, d, 0.0f, buf, n, count);
+
+    const float texit = (std::min)(tx, ty); //time ray leaves this cell
+
+    if(count == n && buf[n - 1].m_fTime <= texit)break; //nothing further on can be nearer
+    if(texit > tmax)break; //end of ray
+
+    if(tx < ty){ //next column
+      i += di;
+      tx += dtx;
+      if(i < 0 || i >= m_nCols)break;
+    } //if
+
+    else{ //next row
+      j += dj;
+      ty += dty;
+      if(j < 0 || j >= m_nRows)break;
+    } //else
+  } //while
+
+  return count;
+} //Cast
+
+/// Find the first shape hit by a ray.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param hit [out] The first hit.
+/// \return true if there was a hit.
+
+bool CGrid::RayCast(const Vector2& p0, const Vector2& p1, CRayHit& hit){
+  return Cast(p0, p1, 0.0f, &hit, 1) > 0;
+} //RayCast
+
+/// Find all shapes hit by a ray, nearest first. If there are more hits than
+/// will fit in the buffer, then only the nearest ones are kept.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param buf Hit buffer.
+/// \param n Size of hit buffer.
+/// \return Number of hits in the buffer.
+
+UINT CGrid::RayCastAll(const Vector2& p0, const Vector2& p1, CRayHit* buf, UINT n){
+  return Cast(p0, p1, 0.0f, buf, n);
+} //RayCastAll
+
+/// Find the first shape hit by a circle swept along a ray.
+/// \param p0 Start of ray.
+/// \param p1 End of ray.
+/// \param r Radius of circle.
+/// \param hit [out] The first hit.
+/// \return true if there was a hit.
+
+bool CGrid::CircleCast(const Vector2& p0, const Vector2& p1, float r, CRayHit& hit){
+  return Cast(p0, p1, r, &hit, 1) > 0;
+} //CircleCast
+
+/// Find the shapes that contain a point. Only circles have an inside,
+/// so points, line segments, and arcs never contain anything.
+/// \param p A point.
+/// \param buf Shape buffer.
+/// \param n Size of shape buffer.
+/// \return Number of shapes in the buffer.
+
+UINT CGrid::QueryPoint(const Vector2& p, CShape** buf, UINT n){
+  if(m_stdShapes.empty())return 0; //nothing to do
+
+  const Vector2 q = p - m_vOrigin; //relative to grid
+  if(q.x < 0.0f || q.y < 0.0f || q.x > m_nCols*m_fCellSize || q.y > m_nRows*m_fCellSize)
+    return 0; //outside the grid
+
+  int i, j; //cell
+  GetCell(p, i, j);
+  const UINT cell = j*m_nCols + i;
+  UINT count = 0; //number of shapes found
+
+  for(UINT k=m_pCellStart[cell]; k<m_pCellStart[cell + 1] && count<n; k++){
+    CShape* pShape = m_stdShapes[m_pCellShapes[k]];
+
+    if(pShape->GetCanCollide() && pShape->GetShapeType() == eShape::Circle &&
+      ((CCircle*)pShape)->PtInCircle(p))
+        buf[count++] = pShape;
+  } //for
+
+  return count;
+} //QueryPoint
+
+/// Find the shapes whose AABBs overlap an AABB.
+/// \param b An AABB.
+/// \param buf Shape buffer.
+/// \param n Size of shape buffer.
+/// \return Number of shapes in the buffer.
+
+UINT CGrid::QueryAABB(const CAabb2D& b, CShape** buf, UINT n){
+  if(m_stdShapes.empty())return 0; //nothing to do
+
+  NextStamp();
+
+  int i0, j0, i1, j1;
+  GetCellRange(b, i0, j0, i1, j1);
+  UINT count = 0; //number of shapes found
+
+  for(int j=j0; j<=j1; j++)
+    for(int i=i0; i<=i1; i++){
+      const UINT cell = j*m_nCols + i;
+
+      for(UINT k=m_pCellStart[cell]; k<m_pCellStart[cell + 1] && count<n; k++){
+        const UINT s = m_pCellShapes[k]; //shape number
+
+        if(m_stdStamp[s] != m_nStamp){ //not tested yet in this query
+          m_stdStamp[s] = m_nStamp;
+          CShape* pShape = m_stdShapes[s];
+
+          if(pShape->GetCanCollide() && (b && pShape->GetAABB()))
+            buf[count++] = pShape;
+        } //if
+      } //for
+    } //for
+
+  return count;
+} //QueryAABB
+
+///////////////////////////////////////////////////////////////////////////////////////
+// CGrid reader functions.
+
+/// Reader function for the origin.
+/// \return Bottom left corner of grid.
+
+const Vector2& CGrid::GetOrigin() const{
+  return m_vOrigin;
+} //GetOrigin
+
+/// Reader function for the cell size.
+/// \return Width and height of a cell.
+
+float CGrid::GetCellSize() const{
+  return m_fCellSize;
+} //GetCellSize
+
+/// Reader function for the number of columns.
+/// \return Number of columns of cells.
+
+int CGrid::GetNumCols() const{
+  return m_nCols;
+} //GetNumCols
+
+/// Reader function for the number of rows.
+/// \return Number of rows of cells.
+
+int CGrid::GetNumRows() const{
+  return m_nRows;
+} //GetNumRows
+
+/// Reader function for the number of shapes.
+/// \return Number of shapes in the shape list.
+
+UINT CGrid::GetNumShapes() const{
+  return (UINT)m_stdShapes.size();
+} //GetNumShapes
+
+/// Reader function for the number of cell shape numbers, which is
+/// the sum over all cells of the number of shapes in that cell.
+/// \return Number of cell shape numbers.
+
+UINT CGrid::GetNumCellShapes() const{
+  return m_pCellStart? m_pCellStart[m_nCols*m_nRows]: 0;
+} //GetNumCellShapes
+
+/// Reader function for the cell start indices.
+/// \return Pointer to number of columns times number of rows plus one start indices.
+
+const UINT* CGrid::GetCellStart() const{
+  return m_pCellStart;
+} //GetCellStart
+
+/// Reader function for the cell shape numbers.
+/// \return Pointer to shape numbers grouped by cell.
+
+const UINT* CGrid::GetCellShapes() const{
+  return m_pCellShapes;
+} //GetCellShapes
@@ -0,0 +1,93 @@
+/// \file Grid.h
+/// \brief Interface for the ray hit class CRayHit and the uniform grid class CGrid.
+
+#ifndef __L4RC_PHYSICS_GRID_H__
+#define __L4RC_PHYSICS_GRID_H__
+
+#include <vector>
+
+#include "Shape.h"
+
+/// \brief Ray hit.
+///
+/// A record of a ray or a swept circle hitting a shape.
+
+class CRayHit{
+  public:
+    CShape* m_pShape = nullptr; ///< Pointer to the shape that was hit.
+    float m_fTime = 0.0f; ///< Fraction of the way along the ray.
+    Vector2 m_vPos; ///< Ray point or swept circle center at time of hit.
+    Vector2 m_vNorm; ///< Unit normal to the shape at the hit.
+}; //CRayHit
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// \brief Uniform grid.
+///
+/// A uniform grid is a spatial index that divides the world into square cells
+/// and records which shapes overlap each cell, so that queries need only look
+/// at the shapes in the cells that they touch. It is intended for shapes that
+/// don't translate, that is, static and kinematic shapes. Kinematic shapes are
+/// inserted with an AABB that covers every orientation about their center of
+/// rotation, so the grid never needs to be rebuilt. The cell contents are stored
+/// compactly with all of the shape numbers for each cell together in one array,
+/// and an array of start indices into it, one per cell plus one for the end.
+/// These two arrays are either built here or loaded from elsewhere, for example
+/// a memory-mapped table file, in which case the grid uses them in place.
+///
+/// Queries write their results into buffers provided by the caller, so they
+/// allocate nothing. Each shape has a stamp that records the last query that
+/// tested it, so that shapes that overlap more than one cell get tested once.
+
+class CGrid{
+  private:
+    Vector2 m_vOrigin; ///< Bottom left corner of grid.
+    float m_fCellSize = 1.0f; ///< Width and height of a cell.
+    float m_fInvCellSize = 1.0f; ///< Reciprocal of cell size.
+    int m_nCols = 0; ///< Number of columns of cells.
+    int m_nRows = 0; ///< Number of rows of cells.
+
+    std::vector<CShape*> m_stdShapes; ///< Shapes, indexed by shape number.
+    std::vector<UINT> m_stdCellStart; ///< Index of each cell's first shape number in m_stdCellShapes.
+    std::vector<UINT> m_stdCellShapes; ///< Shape numbers grouped by cell.
+
+    const UINT* m_pCellStart = nullptr; ///< Cell start indices in use, built or loaded.
+    const UINT* m_pCellShapes = nullptr; ///< Cell shape numbers in use, built or loaded.
+
+    std::vector<UINT> m_stdStamp; ///< Stamp of the last query to test each shape.
+    UINT m_nStamp = 0; ///< Stamp for current query.
+
+    CAabb2D GetInsertionAABB(CShape*) const; ///< Get AABB used to insert a shape.
+    void GetCellRange(const CAabb2D&, int&, int&, int&, int&) const; ///< Get cells overlapping an AABB.
+    void GetCell(const Vector2&, int&, int&) const; ///< Get cell containing a point.
+
+    void NextStamp(); ///< Start a new query.
+    UINT Cast(const Vector2&, const Vector2&, float, CRayHit*, UINT); ///< Ray or circle cast.
+    UINT CastCell(int, int, const Vector2&, const Vector2&, float, CRayHit*, UINT, UINT); ///< Cast against one cell.
+
+  public:
+    void Build(const CAabb2D&, float, const std::vector<CShape*>&); ///< Build grid.
+    void Load(const Vector2&, float, int, int, const UINT*, const UINT*,
+      const std::vector<CShape*>&); ///< Load prebuilt grid.
+    void Clear(); ///< Remove all shapes.
+
+    bool RayCast(const Vector2&, const Vector2&, CRayHit&); ///< First hit on a ray.
+    UINT RayCastAll(const Vector2&, const Vector2&, CRayHit*, UINT); ///< All hits on a ray.
+    bool CircleCast(const Vector2&, const Vector2&, float, CRayHit&); ///< First hit by a swept circle.
+
+    UINT QueryPoint(const Vector2&, CShape**, UINT); ///< Shapes containing a point.
+    UINT QueryAABB(const CAabb2D&, CShape**, UINT); ///< Shapes overlapping an AABB.
+
+    const Vector2& GetOrigin() const; ///< Get origin.
+    float GetCellSize() const; ///< Get cell size.
+    int GetNumCols() const; ///< Get number of columns.
+    int GetNumRows() const; ///< Get number of rows.
+    UINT GetNumShapes() const; ///< Get number of shapes.
+    UINT GetNumCellShapes() const; ///< Get number of cell shape numbers.
+    const UINT* GetCellStart() const; ///< Get cell start indices.
+    const UINT* GetCellShapes() const; ///< Get cell shape numbers.
+
+    static UINT InsertHit(CRayHit*, UINT, UINT, const CRayHit&); ///< Insert hit into sorted list.
+}; //CGrid
+
+#endif //__L4RC_PHYSICS_GRID_H__
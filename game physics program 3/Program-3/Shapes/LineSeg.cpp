@@ -100,6 +100,7 @@ CLineSeg::CLineSeg(CLineSegDesc& r):
 {
   m_eShapeType = eShape::LineSeg;
   m_fElasticity = r.m_fElasticity;
+  m_bOneWay = r.m_bOneWay;
   SetPos(r.m_vPos);
   Update();
 } //constructor
@@ -167,6 +168,54 @@ bool CLineSeg::PreCollide(CContactDesc& c){
   return poi.PreCollide(c);
 } //PreCollide
 
+/// Cast a circle along a ray and find where it first hits this line segment.
+/// The swept circle hits the line segment when its center hits a capsule
+/// made up of two line segments parallel to this one at distance equal to
+/// the radius, plus a circle of that radius at each end point. 
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param t [out] Fraction of the way along the ray at the first hit.
+/// \param n [out] Unit normal at the hit.
+/// \return true if there was a hit.
+
+bool CLineSeg::RayCast(const Vector2& p, const Vector2& d, float r, float& t, Vector2& n){
+  float tmin = 2.0f; //time of first hit, anything over 1 means no hit
+
+  const Vector2 u = m_vPt1 - m_vPt0; //along line segment
+  const Vector2 nhat = Normalize(perp(u)); //normal to line segment
+
+  const float dist = (p - m_vPt0).Dot(nhat); //signed distance from start of ray to line
+  const float s = dist >= 0.0f? 1.0f: -1.0f; //which side the ray starts on
+  const float dn = d.Dot(nhat); //rate of approach to line
+
+  if(fabsf(dist) >= r && s*dn < 0.0f){ //starts outside capsule heading towards line
+    const float t0 = (s*r - dist)/dn; //time at which swept circle touches line
+    const Vector2 q = p + t0*d - s*r*nhat; //point of contact on line
+    const float k = (q - m_vPt0).Dot(u)/u.LengthSquared(); //fraction along line segment
+
+    if(t0 <= 1.0f && k >= 0.0f && k <= 1.0f){ //hits between the end points
+      tmin = t0;
+      n = s*nhat;
+    } //if
+  } //if
+
+  if(r > 0.0f) //swept circle can hit the ends
+    for(const Vector2& e: {m_vPt0, m_vPt1}){
+      float t0, t1; //roots
+
+      if(RayCircleRoots(p, d, e, r, t0, t1) && t0 >= 0.0f && t0 < tmin){
+        tmin = t0;
+        n = Normalize(p + t0*d - e);
+      } //if
+    } //for
+
+  FailIf(tmin > 1.0f); //no hit
+
+  t = tmin;
+  return true;
+} //RayCast
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // CKinematicLineSeg functions.
 
@@ -206,3 +255,13 @@ void CKinematicLineSeg::Reset(){
   
   Update(); 
 } //Reset
+
+/// Get the radius of the smallest disk centered at the center of rotation
+/// that contains this shape at every orientation.
+/// \return Radius of swept area.
+
+float CKinematicLineSeg::GetSweepRadius() const{
+  const float r0 = (m_vOldPt0 - m_vRotCenter).Length();
+  const float r1 = (m_vOldPt1 - m_vRotCenter).Length();
+  return max(r0, r1);
+} //GetSweepRadius
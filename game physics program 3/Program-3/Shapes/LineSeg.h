@@ -54,6 +54,7 @@ class CLineSeg: public CLine{
     CLineSeg(CLineSegDesc&); ///< Constructor.  
 
     bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool RayCast(const Vector2&, const Vector2&, float, float&, Vector2&); ///< Ray or swept circle cast.
 
     void GetEndPts(Vector2&, Vector2&); ///< Get end points.
     void GetTangents(Vector2&, Vector2&); ///< Get tangents. 
@@ -76,6 +77,7 @@ class CKinematicLineSeg: public CLineSeg{
     
     void Rotate(const Vector2&, float); ///< Rotate.
     void Reset(); ///< Reset orientation.
+    float GetSweepRadius() const; ///< Get radius of swept area.
 }; //CKinematicLineSeg
 
 #endif //__L4RC_PHYSICS_LINESEG_H__
@@ -70,6 +70,28 @@ bool CPoint::PreCollide(CContactDesc& c){
   return true;
 } //PreCollide
 
+/// Cast a circle along a ray and find where it first hits this point.
+/// A ray of zero radius can't hit a point.
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle.
+/// \param t [out] Fraction of the way along the ray at the hit.
+/// \param n [out] Unit normal at the hit.
+/// \return true if there was a hit.
+
+bool CPoint::RayCast(const Vector2& p, const Vector2& d, float r, float& t, Vector2& n){
+  float t0, t1; //roots
+
+  FailIf(r <= 0.0f); //rays miss points
+  FailIf(!RayCircleRoots(p, d, GetPos(), r, t0, t1)); //misses completely
+  FailIf(t0 < 0.0f || t0 > 1.0f); //starts inside or falls short
+
+  t = t0;
+  n = Normalize(p + t0*d - GetPos());
+
+  return true;
+} //RayCast
+
 ///////////////////////////////////////////////////////////////////////////////////
 // CKinematicPoint functions.
 
@@ -97,3 +119,11 @@ void CKinematicPoint::Reset(){
   SetPos(m_vOldPos);
 } //Reset
 
+/// Get the radius of the smallest disk centered at the center of rotation
+/// that contains this shape at every orientation.
+/// \return Radius of swept area.
+
+float CKinematicPoint::GetSweepRadius() const{
+  return (m_vOldPos - m_vRotCenter).Length();
+} //GetSweepRadius
+
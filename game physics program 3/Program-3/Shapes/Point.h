@@ -28,6 +28,7 @@ class CPoint: public CShape{
     CPoint(const Vector2&); ///< Constructor.
 
     bool PreCollide(CContactDesc&); ///< Collision detection.
+    bool RayCast(const Vector2&, const Vector2&, float, float&, Vector2&); ///< Ray or swept circle cast.
 }; //CPoint
 
 //////////////////////////////////////////////////////////////////////////
@@ -45,6 +46,7 @@ class CKinematicPoint: public CPoint{
     
     void Rotate(const Vector2&, float); ///< Rotate.
     void Reset(); ///< Reset orientation.
+    float GetSweepRadius() const; ///< Get radius of swept area.
 }; //CKinematicPoint
 
 #endif //__L4RC_PHYSICS_POINT_H__
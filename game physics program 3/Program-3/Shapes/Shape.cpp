@@ -2,6 +2,7 @@
 /// \brief Code for CShapeDesc and CShape.
 
 #include "Shape.h"
+#include "Contact.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////
 //CShapeDesc functions
@@ -32,6 +33,7 @@ CShape::CShape(const CShapeDesc& r){
   m_eMotionType = r.m_eMotionType; 
   m_fElasticity = r.m_fElasticity;
   m_bIsSensor = r.m_bIsSensor; 
+  m_bOneWay = r.m_bOneWay;
 
   SetPos(m_vPos); //move AABB
 } //constructor
@@ -80,6 +82,14 @@ const bool CShape::GetSensor() const{
   return m_bIsSensor;
 } //GetSensor
 
+/// Reader function for the one-way setting. Which side circles may cross
+/// from, and when, is up to whoever handles the collisions.
+/// \return true if this shape is one-way.
+
+const bool CShape::GetOneWay() const{
+  return m_bOneWay;
+} //GetOneWay
+
 /// Writer function for the position. This both changes the
 /// shape's position and translates its AABB.
 /// \param p New position.
@@ -168,18 +178,117 @@ bool CShape::PreCollide(CContactDesc& c){
   return false;
 } //PreCollide
 
+/// Cast a circle along a ray and find where it first hits this shape, if
+/// anywhere. A radius of zero casts a plain ray. This virtual function
+/// is a stub that will be overridden by the appropriate functions
+/// for various specific shapes. Only hits from outside the shape count,
+/// so a ray that starts inside a circle does not hit it.
+/// \param p Start of ray.
+/// \param d Ray vector, the ray ends at p + d.
+/// \param r Radius of swept circle, zero for a ray.
+/// \param t [out] Fraction of the way along the ray at the first hit.
+/// \param n [out] Unit normal to this shape at the hit.
+/// \return true if there was a hit.
+
+bool CShape::RayCast(const Vector2& p, const Vector2& d, float r, float& t, Vector2& n){
+  return false;
+} //RayCast
+
 /// Virtual move function. This is for shapes that move, obviously not
 /// static ones. Kinematic shapes are handled here. Dynamic shapes
 /// get handled by a virtual function in CDynamicCircle.
+/// \param dt Time step.
+/// \param g Gravitational constant, which doesn't affect kinematic shapes.
 
-void CShape::move(){
+void CShape::move(float dt, float g){
   if(m_eMotionType == eMotion::Kinematic){
-    m_fOrientation += XM_2PI*m_fRotSpeed*m_fTimeStep; //add change in orientation
+    m_fRotDelta = XM_2PI*m_fRotSpeed*dt; //change in orientation
+    m_fOrientation += m_fRotDelta; //add change in orientation
     m_fOrientation = NormalizeAngle(m_fOrientation); //normalize it for safety
     Rotate(m_vRotCenter, m_fOrientation); //this call to a virtual function will be promoted up to a kinematic shape when possible
   } //if
 } //move
 
+/// Get the radius of the smallest disk centered at the center of rotation
+/// that contains this shape at every orientation. This virtual function is
+/// a stub that will be overridden by the appropriate functions for various
+/// specific kinematic shapes.
+/// \return Radius of swept area.
+
+float CShape::GetSweepRadius() const{
+  return 0.0f;
+} //GetSweepRadius
+
+/// Check whether a circle might touch the area that this shape swept out
+/// in its last move. The swept area lies inside a disk around the center
+/// of rotation, so a circle that doesn't touch that disk can't have been hit.
+/// \param p Circle center.
+/// \param r Circle radius.
+/// \return true if the circle might touch the swept area.
+
+bool CShape::InSweep(const Vector2& p, float r) const{
+  const float R = GetSweepRadius() + r; //disk radius
+  return (p - m_vRotCenter).LengthSquared() <= R*R;
+} //InSweep
+
+/// Collision detection with a dynamic circle for a kinematic shape, finding
+/// the time of impact within its last rotation. A kinematic shape jumps from
+/// its previous orientation to its current one in a single move, which can
+/// take it right past a circle. Instead, it is posed at enough orientations in
+/// between that no part of it moves further than the circle's radius from one
+/// to the next, and the first one that collides is refined by bisection. The
+/// contact descriptor is filled in for the shape posed at the time of impact,
+/// and the shape is then put back in its current orientation.
+/// \param c [in, out] Contact descriptor for this collision.
+/// \param s [out] Fraction of the last rotation at the time of impact.
+/// \return true if there was a collision.
+
+bool CShape::SweptPreCollide(CContactDesc& c, float& s){
+  s = 1.0f;
+
+  if(m_fRotDelta == 0.0f) //not rotating
+    return PreCollide(c);
+
+  const Vector2 p = c.m_pCircle->GetPos(); //circle center
+  const float r = c.m_pCircle->GetRadius(); //circle radius
+
+  FailIf(!InSweep(p, r));
+
+  const float a0 = m_fOrientation - m_fRotDelta; //previous orientation
+  const float dist = fabsf(m_fRotDelta)*GetSweepRadius(); //furthest distance moved
+  const UINT n = max(1U, (UINT)ceilf(dist/r)); //number of steps
+
+  float lo = 0.0f; //fraction at which there is no collision
+  float hi = -1.0f; //fraction at which there is a collision, negative for none yet
+
+  for(UINT i=0; i<=n && hi < 0.0f; i++){ //step through the rotation
+    const float t = (float)i/n;
+    Rotate(m_vRotCenter, a0 + t*m_fRotDelta);
+
+    if(PreCollide(c))hi = t;
+    else lo = t;
+  } //for
+
+  if(hi > 0.0f){ //refine time of impact
+    for(UINT i=0; i<8; i++){
+      const float t = (lo + hi)/2.0f;
+      Rotate(m_vRotCenter, a0 + t*m_fRotDelta);
+
+      if(PreCollide(c))hi = t;
+      else lo = t;
+    } //for
+
+    Rotate(m_vRotCenter, a0 + hi*m_fRotDelta);
+    PreCollide(c); //contact at time of impact
+  } //if
+
+  Rotate(m_vRotCenter, m_fOrientation); //back to current orientation
+  FailIf(hi < 0.0f);
+
+  s = hi;
+  return true;
+} //SweptPreCollide
+
 //////////////////////////////////////////////////////////////////
 //More CShape functions
 
@@ -197,6 +306,13 @@ const float CShape::GetRotSpeed() const{
   return m_fRotSpeed;
 } //GetRotSpeed
 
+/// Reader function for the change in orientation in the last move.
+/// \return Change in orientation.
+
+const float CShape::GetRotDelta() const{
+  return m_fRotDelta;
+} //GetRotDelta
+
 /// Reader function for the center of rotation.
 /// \return Center of rotation.
 
@@ -42,6 +42,7 @@ class CShapeDesc{
     float m_fElasticity = 1.0f; ///< Elasticity, aka restitution, bounciness.
     eMotion m_eMotionType = eMotion::Static; ///< How shape moves.
     bool m_bIsSensor = false; ///< Sensor only, no rebound.
+    bool m_bOneWay = false; ///< One-way, circles may cross it from one side.
 
     CShapeDesc(eShape); ///< Constructor.
     CShapeDesc(); ///< Default constructor.
@@ -66,6 +67,7 @@ class CShape: public CShapeCommon{
     bool m_bIsSensor = false; ///< Sensor only, no rebound on collision.
     CAabb2D m_cAABB; ///< Axially aligned bounding box in World Space.
     bool m_bCanCollide = true; ///< Can collide with other shapes.
+    bool m_bOneWay = false; ///< One-way, circles may cross it from one side.
 
     float m_fOrientation = 0.0f; ///< Orientation angle.
 
@@ -74,6 +76,7 @@ class CShape: public CShapeCommon{
     //for kinematic shapes
     Vector2 m_vRotCenter; ///< Center of rotation.
     float m_fRotSpeed = 0.0f; ///< Rotation speed.
+    float m_fRotDelta = 0.0f; ///< Change in orientation in the last move.
     bool m_bRotating = false; ///< Whether rotating.
 
   public:  
@@ -84,6 +87,7 @@ class CShape: public CShapeCommon{
     const eMotion GetMotionType() const; ///< Get motion type.
     const CAabb2D& GetAABB() const; ///< Get AABB.
     const bool GetSensor() const; ///< Is this shape a sensor?
+    const bool GetOneWay() const; ///< Is this shape one-way?
 
     const Vector2& GetPos() const; ///< Get position.
     void SetPos(const Vector2&); ///< Set position.
@@ -99,14 +103,22 @@ class CShape: public CShapeCommon{
     virtual void Rotate(const Vector2&, float); ///< Rotate.
     virtual void Reset(); ///< Reset orientation.
     virtual bool PreCollide(CContactDesc&); ///< Collision detection.
-    virtual void move(); ///< Translate.
+    virtual void move(float, float); ///< Translate.
+    virtual float GetSweepRadius() const; ///< Get radius of swept area.
+
+    bool InSweep(const Vector2&, float) const; ///< Circle might touch swept area.
+    bool SweptPreCollide(CContactDesc&, float&); ///< Swept collision detection.
 
     const bool GetRotating() const; ///< Get whether rotating.
     void SetRotating(bool); ///< Start or stop rotating.
 
+  public: //for spatial queries
+    virtual bool RayCast(const Vector2&, const Vector2&, float, float&, Vector2&); ///< Ray or swept circle cast.
+
   public: //reader and writer functions
     const float GetOrientation() const; ///< Get orientation.
     const float GetRotSpeed() const; ///< Get rotation speed.
+    const float GetRotDelta() const; ///< Get change in orientation.
     const Vector2& GetRotCenter() const; ///< Get rotation speed.
     const float GetElasticity() const; ///< Get elasticity.
     
@@ -12,7 +12,10 @@
 /// that we can avoid passing its member variables
 /// around as parameters, which makes the code
 /// minisculely faster, and more importantly, reduces
-/// function clutter.
+/// function clutter. These are only the defaults. Each world
+/// copies them when it is made and passes its own to the
+/// shapes when it moves them, so that independent worlds can
+/// have their own time step and gravity.
 
 class CShapeCommon{
   protected:  
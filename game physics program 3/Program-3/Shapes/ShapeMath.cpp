@@ -61,4 +61,32 @@ Vector2 RotatePt(Vector2 p, const Vector2& q, const float a){
 Vector2 ParallelComponent(const Vector2& v0, const Vector2& v1){
   const Vector2 v1hat = Normalize(v1);
   return v0.Dot(v1hat)*v1hat;
-} //ParallelComponent
\ No newline at end of file
+} //ParallelComponent
+
+/// Find where a ray intersects a circle. The ray is \f$p + t\vec{d}\f$, so 
+/// the intersections are the roots of the quadratic in \f$t\f$ given by
+/// \f$|p + t\vec{d} - c|^2 = r^2\f$. The first root is where the ray enters
+/// the circle and the second is where it leaves.
+/// \param p Start of ray.
+/// \param d Direction of ray, not necessarily normalized.
+/// \param c Center of circle.
+/// \param r Radius of circle.
+/// \param t0 [out] Smaller root.
+/// \param t1 [out] Larger root.
+/// \return true if the ray's line intersects the circle.
+
+bool RayCircleRoots(const Vector2& p, const Vector2& d, const Vector2& c, float r, float& t0, float& t1){
+  const Vector2 v = p - c;
+
+  const float a = d.Dot(d);
+  const float b = 2.0f*v.Dot(d);
+  const float disc = b*b - 4.0f*a*(v.Dot(v) - r*r); //discriminant
+
+  FailIf(a == 0.0f || disc < 0.0f);
+
+  const float root = sqrtf(disc);
+  t0 = (-b - root)/(2.0f*a);
+  t1 = (-b + root)/(2.0f*a);
+
+  return true;
+} //RayCircleRoots
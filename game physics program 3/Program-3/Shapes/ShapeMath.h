@@ -31,5 +31,6 @@ Vector2 AngleToVector(const float); ///< Normal vector from orientation.
 Vector2 RotatePt(Vector2, const Vector2&, const float); ///< Rotate point.
 
 Vector2 ParallelComponent(const Vector2&, const Vector2&); ///< Compute parallel component of vector.
+bool RayCircleRoots(const Vector2&, const Vector2&, const Vector2&, float, float&, float&); ///< Ray circle intersection.
 
 #endif //__L4RC_PHYSICS_SHAPEMATH_H__
\ No newline at end of file
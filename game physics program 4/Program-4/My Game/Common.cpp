@@ -9,5 +9,6 @@
 CRenderer* CCommon::m_pRenderer = nullptr; 
 b2World* CCommon::m_pPhysicsWorld = nullptr; 
 CObjectManager* CCommon::m_pObjectManager = nullptr;
+float CCommon::m_fStepFraction = 1.0f;
 
 CWindmill* CCommon::m_pWindmill      = nullptr; 
@@ -30,6 +30,7 @@ class CCommon{
     static b2World* m_pPhysicsWorld; ///< Pointer to Box2D Physics World.
     static CRenderer* m_pRenderer; ///< Pointer to the renderer.
     static CObjectManager* m_pObjectManager; ///< Pointer to the object manager.
+    static float m_fStepFraction; ///< Fraction of a physics step to draw objects ahead by.
     
     static CWindmill* m_pWindmill; ///< Pointer to windmill.
 }; //CCommon
@@ -12,6 +12,8 @@
 
 #include "shellapi.h"
 
+static const float STEP_RATES[] = {30.0f, 60.0f, 120.0f}; ///< Physics step rates that F2 cycles through, in Hz.
+
 /// Call Render World's Release function to do the required
 /// Direct3D cleanup, then delete the renderer and the object manager.
 /// Also delete Physics World, which MUST be deleted after
@@ -140,6 +142,9 @@ void CGame::KeyboardHandler(){
   
   if(m_pKeyboard->TriggerDown(VK_BACK))
     BeginGame();
+
+  if(m_pKeyboard->TriggerDown(VK_F2)) //next physics step rate
+    m_nStepRate = (m_nStepRate + 1)%(sizeof(STEP_RATES)/sizeof(STEP_RATES[0]));
 } //KeyboardHandler
 
 /// Draw the appropriate background for the current level.
@@ -159,6 +164,36 @@ void CGame::RenderFrame(){
   m_pRenderer->EndFrame();
 } //RenderFrame
 
+/// Step Physics World by a whole number of fixed time steps, so that the
+/// cost, stability, and outcome of the simulation don't depend on the frame
+/// rate. The frame time is added to an accumulator, and a step is taken for
+/// each whole step time in it, saving the objects' transforms before each
+/// one. To stop a long frame from causing a spiral of ever longer frames,
+/// no more than `m_nMaxSteps` steps are taken and the rest of the time is
+/// dropped, which makes the game run slow instead. What is left in the
+/// accumulator, as a fraction of a step, is how far the objects are drawn
+/// between the last two steps. That makes them lag a step behind, but they
+/// move smoothly at any frame rate.
+/// \param dt Frame time in seconds.
+
+void CGame::StepPhysics(float dt){
+  const float step = 1.0f/STEP_RATES[m_nStepRate]; //step time
+  m_fAccumulator += dt;
+  UINT n = 0; //number of steps taken
+
+  while(m_fAccumulator >= step && n < m_nMaxSteps){
+    m_pObjectManager->SaveTransforms();
+    m_pPhysicsWorld->Step(step, 4, 6); //move all objects
+    m_fAccumulator -= step;
+    n++;
+  } //while
+
+  if(m_fAccumulator >= step) //too far behind
+    m_fAccumulator = fmodf(m_fAccumulator, step); //drop whole steps
+
+  m_fStepFraction = m_fAccumulator/step;
+} //StepPhysics
+
 /// Handle keyboard input, move the game objects and render 
 /// them in their new positions and orientations.  
 /// There's also some extra processing to be done
@@ -169,7 +204,7 @@ void CGame::ProcessFrame(){
   KeyboardHandler(); //handle keyboard input
   
   m_pTimer->Tick([&](){ 
-    m_pPhysicsWorld->Step(m_pTimer->GetFrameTime(), 4, 6); //move all objects
+    StepPhysics(m_pTimer->GetFrameTime()); //move all objects
   });
 
   RenderFrame(); //render a frame of animation 
@@ -17,7 +17,12 @@ class CGame:
   public CCommon
 { 
   private:  
+    UINT m_nStepRate = 1; ///< Index of physics step rate in `STEP_RATES`.
+    UINT m_nMaxSteps = 5; ///< Maximum number of physics steps per frame.
+    float m_fAccumulator = 0.0f; ///< Frame time not yet simulated, in seconds.
+
     void BeginGame(); ///< Begin playing the game.
+    void StepPhysics(float); ///< Step Physics World by fixed steps.
     void KeyboardHandler(); ///< The keyboard handler.
     void RenderFrame(); ///< Render an animation frame.
     void DrawBackground(); ///< Draw the background.
@@ -8,12 +8,15 @@
 /// This constructor assumes that a Physics World body
 /// has already been created for this object. It
 /// then has responsibility for deleting it in its destructor.
+/// The previous transform starts out the same as the body's,
+/// so that a new object isn't drawn moving from the origin.
 /// \param t Sprite type.
 /// \param b Pointer to Physics World body.
 
 CObject::CObject(eSprite t, b2Body* b){
   m_eSpriteType = t; 
   m_pBody = b;
+  SaveTransform();
 } //constructor
 
 /// This destructor assumes that Box2D hasn't been shut down yet.
@@ -23,12 +26,24 @@ CObject::~CObject(){
     m_pPhysicsWorld->DestroyBody(m_pBody);
 } //destructor
 
+/// Save the body's position and orientation before a physics step, so that
+/// it can be drawn part way between the steps.
+
+void CObject::SaveTransform(){
+  m_vPrevPos = m_pBody->GetPosition();
+  m_fPrevAngle = m_pBody->GetAngle();
+} //SaveTransform
+
 /// Draw in Render World.
-/// Position and orientation must be gotten from Physics World.
+/// Position and orientation must be gotten from Physics World. They are
+/// interpolated linearly between the transform before the last physics step
+/// and the current one by `m_fStepFraction`, because physics steps
+/// don't line up with frames.
 
 void CObject::draw(){
-  const float a = m_pBody->GetAngle(); //orientation
-  const b2Vec2 v = m_pBody->GetPosition(); //position in Physics World units
+  const float t = m_fStepFraction; //shorthand
+  const float a = (1.0f - t)*m_fPrevAngle + t*m_pBody->GetAngle(); //orientation
+  const b2Vec2 v = (1.0f - t)*m_vPrevPos + t*m_pBody->GetPosition(); //position in Physics World units
 
   if(m_eSpriteType != eSprite::Size)
     m_pRenderer->Draw(m_eSpriteType, PW2RW(v), a); //draw in Render World
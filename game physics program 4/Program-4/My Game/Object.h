@@ -17,14 +17,24 @@ class CObject:
   public CCommon,
   public LComponent
 { 
+  friend class CObjectManager; ///< Object manager needs access so it can manage.
+
   private:
     eSprite m_eSpriteType = eSprite::Size; ///< Sprite type.
     b2Body* m_pBody = nullptr; ///< Physics World body.
+    b2Vec2 m_vPrevPos; ///< Physics World position before the last physics step.
+    float m_fPrevAngle = 0.0f; ///< Orientation before the last physics step.
+
+    UINT m_nSlot = 0; ///< Index of slot in object manager.
+    UINT m_nIndex = 0; ///< Index in object manager's object list.
+    CObject* m_pPrevOfType = nullptr; ///< Previous object of the same sprite type.
+    CObject* m_pNextOfType = nullptr; ///< Next object of the same sprite type.
 
   public:
     CObject(eSprite, b2Body*); ///< Constructor.
     ~CObject(); ///< Destructor.
 
+    void SaveTransform(); ///< Save transform before a physics step.
     void draw(); ///< Draw object in Render World.
     const Vector2 GetPos() const; ///< Get position in Render World.
     const eSprite GetSpriteType() const; ///< Get sprite type.
@@ -51,27 +51,108 @@ void CObjectManager::CreateWorldEdges(){
   pBody->CreateFixture(&shape, 0); 
 } //CreateWorldEdges
 
-/// Create an object in the object manager.
+/// Create an object in the object manager. It goes at the end of the
+/// object list and the end of the list of objects of its sprite type,
+/// and into a free slot, or a new one if there are none free.
 /// \param t Sprite type.
 /// \param b Pointer to Physics World body.
-/// \return Pointer to the object created.
+/// \return Handle of the object created.
 
-CObject* CObjectManager::create(eSprite t, b2Body* b){ 
+const CObjectHandle CObjectManager::create(eSprite t, b2Body* b){ 
   CObject* p = new CObject(t, b);
+
+  if(m_nFreeSlot == SLOT_NONE){ //no free slots
+    m_nFreeSlot = (UINT)m_stdSlot.size();
+    m_stdSlot.push_back(CObjectSlot());
+  } //if
+
+  const UINT i = m_nFreeSlot; //slot index
+  CObjectSlot& slot = m_stdSlot[i]; //shorthand
+  m_nFreeSlot = slot.m_nNextFree;
+  slot.m_pObject = p;
+
+  p->m_nSlot = i;
+  p->m_nIndex = (UINT)m_stdList.size();
   m_stdList.push_back(p);
-  return p;
+
+  if(t != eSprite::Size){ //link to end of list for its sprite type
+    CObject*& last = m_pLastOfType[(UINT)t]; //shorthand
+    p->m_pPrevOfType = last;
+    if(last)last->m_pNextOfType = p;
+    else m_pFirstOfType[(UINT)t] = p;
+    last = p;
+  } //if
+
+  CObjectHandle h;
+  h.m_nSlot = i;
+  h.m_nGeneration = slot.m_nGeneration;
+  return h;
 } //create
 
+/// Get the object that a handle refers to.
+/// \param h Handle.
+/// \return Pointer to the object, or nullptr if it has been deleted.
+
+CObject* CObjectManager::Lookup(const CObjectHandle& h) const{
+  if(h.m_nSlot >= m_stdSlot.size())return nullptr; //no such slot
+  const CObjectSlot& slot = m_stdSlot[h.m_nSlot]; //shorthand
+  return slot.m_nGeneration == h.m_nGeneration? slot.m_pObject: nullptr;
+} //Lookup
+
+/// Remove an object from the object manager and delete it. It is unlinked
+/// from the list of objects of its sprite type, the last object in the
+/// object list is moved into its place, and its slot goes on the free list
+/// with its generation incremented so that old handles to it go stale.
+/// \param p Pointer to an object in the object manager.
+
+void CObjectManager::remove(CObject* p){
+  const UINT t = (UINT)p->m_eSpriteType; //sprite type index
+
+  if(t != (UINT)eSprite::Size){ //unlink from list for its sprite type
+    if(p->m_pPrevOfType)p->m_pPrevOfType->m_pNextOfType = p->m_pNextOfType;
+    else m_pFirstOfType[t] = p->m_pNextOfType;
+
+    if(p->m_pNextOfType)p->m_pNextOfType->m_pPrevOfType = p->m_pPrevOfType;
+    else m_pLastOfType[t] = p->m_pPrevOfType;
+  } //if
+
+  CObject* last = m_stdList.back(); //last object in object list
+  last->m_nIndex = p->m_nIndex;
+  m_stdList[p->m_nIndex] = last;
+  m_stdList.pop_back();
+
+  FreeSlot(p->m_nSlot);
+  delete p;
+} //remove
+
+/// Empty a slot and put it at the head of the free list, incrementing its
+/// generation so that handles to the object that was in it go stale.
+/// \param i Slot index.
+
+void CObjectManager::FreeSlot(UINT i){
+  CObjectSlot& slot = m_stdSlot[i]; //shorthand
+  slot.m_pObject = nullptr;
+  slot.m_nGeneration++;
+  slot.m_nNextFree = m_nFreeSlot;
+  m_nFreeSlot = i;
+} //FreeSlot
+
 /// Delete all of the entities managed by object manager. 
 /// This involves deleting all of the CObject instances pointed
 /// to by the object list, then clearing the object list itself.
-/// Ditto for the line list.
+/// Their slots are freed, so that handles to them go stale, and the
+/// lists for each sprite type are emptied.
 
 void CObjectManager::clear(){
-  for(auto const& p: m_stdList) //for each object
+  for(auto const& p: m_stdList){ //for each object
+    FreeSlot(p->m_nSlot);
     delete p; //delete object
+  } //for
 
   m_stdList.clear(); //clear the object list
+
+  for(UINT t=0; t<(UINT)eSprite::Size; t++)
+    m_pFirstOfType[t] = m_pLastOfType[t] = nullptr;
 } //clear
 
 /// Draw the game objects using Painter's Algorithm.
@@ -83,25 +164,40 @@ void CObjectManager::clear(){
 
 void CObjectManager::draw(){  
   for(auto const& p: m_stdList) //for each object
-    if(p != nullptr) //safety
-      p->draw(); //draw it in Render World
+    p->draw(); //draw it in Render World
 } //draw
 
-/// Delete the first object of a given sprite type.
+/// Ask the game objects to save their transforms before a physics step.
+
+void CObjectManager::SaveTransforms(){
+  for(auto const& p: m_stdList) //for each object
+    p->SaveTransform();
+} //SaveTransforms
+
+/// Delete the first object of a given sprite type, which is the oldest one,
+/// from the head of the list for that type.
 /// \param t Sprite type.
 /// \return true if one was actually deleted.
 
 bool CObjectManager::DeleteObject(eSprite t){
-  bool bDeleted = false; //return result
+  if(t == eSprite::Size)return false; //no list for this
+  CObject* p = m_pFirstOfType[(UINT)t]; //first object of this type
+  if(p == nullptr)return false; //there are none
+
+  remove(p);
+  return true;
+} //DeleteObject
+
+/// Delete the object that a handle refers to.
+/// \param h Handle.
+/// \return true if it was actually deleted, false if it was already gone.
 
-  for(auto& p: m_stdList) //for each object
-    if(p != nullptr && p->GetSpriteType() == t){ //right type
-      SAFE_DELETE(p); //delete it and set to null
-      bDeleted = true; //we deleted something
-      break; //only the first one
-    } //if
+bool CObjectManager::DeleteObject(const CObjectHandle& h){
+  CObject* p = Lookup(h); //object, if any
+  if(p == nullptr)return false; //stale handle
 
-  return bDeleted;
+  remove(p);
+  return true;
 } //DeleteObject
 
 
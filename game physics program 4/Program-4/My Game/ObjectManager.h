@@ -12,10 +12,46 @@
 #include "Common.h"
 #include "Settings.h"
 
+const UINT SLOT_NONE = 0xFFFFFFFF; ///< Slot index meaning no slot.
+
+/// \brief Object handle.
+///
+/// A reference to an object in the object manager that can be checked for
+/// staleness. It holds the index of the object's slot and the generation
+/// of the slot when the object was put in it. The generation goes up each
+/// time a slot is freed, so a handle to a deleted object never finds the
+/// object that gets its slot next.
+
+class CObjectHandle{
+  public:
+    UINT m_nSlot = SLOT_NONE; ///< Slot index.
+    UINT m_nGeneration = 0; ///< Slot generation.
+}; //CObjectHandle
+
+/// \brief Object slot.
+///
+/// An entry in the object manager's slot map, either holding an object
+/// or on the free list.
+
+class CObjectSlot{
+  public:
+    CObject* m_pObject = nullptr; ///< Object, or nullptr if free.
+    UINT m_nGeneration = 0; ///< Number of times this slot has been freed.
+    UINT m_nNextFree = SLOT_NONE; ///< Next free slot, if free.
+}; //CObjectSlot
+
 /// \brief The object manager.
 ///
 /// The object manager is an abstract representation of all of
-/// the objects in the game.
+/// the objects in the game. The objects are kept in a dense list with no
+/// gaps, which is what gets drawn, and in a generational slot map, which is
+/// what handles refer to. Deleting an object moves the last object in the
+/// list into its place and puts its slot on the free list, so creating and
+/// deleting are constant time, and the list never needs compacting or
+/// checking for null. This does change the drawing order of the object
+/// that is moved. Each object is also linked into an intrusive doubly
+/// linked list of the objects of its sprite type, oldest first, so that
+/// the first object of a type can be found and deleted in constant time.
 
 class CObjectManager:
   public LComponent, 
@@ -24,17 +60,28 @@ class CObjectManager:
 
   private:
     std::vector<CObject*> m_stdList; ///< Object list.
+    std::vector<CObjectSlot> m_stdSlot; ///< Slot map.
+    UINT m_nFreeSlot = SLOT_NONE; ///< First free slot.
+
+    CObject* m_pFirstOfType[(UINT)eSprite::Size] = {}; ///< Oldest object of each sprite type.
+    CObject* m_pLastOfType[(UINT)eSprite::Size] = {}; ///< Newest object of each sprite type.
+
+    void remove(CObject*); ///< Remove an object.
+    void FreeSlot(UINT); ///< Put a slot on the free list.
 
   public:
     ~CObjectManager(); ///< Destructor.
 
-    CObject* create(eSprite, b2Body*); ///< Create new object.
+    const CObjectHandle create(eSprite, b2Body*); ///< Create new object.
+    CObject* Lookup(const CObjectHandle&) const; ///< Get object from handle.
 
     void clear(); ///< Reset to initial conditions.
     void draw(); ///< Draw all objects.
+    void SaveTransforms(); ///< Save transforms before a physics step.
 
     void CreateWorldEdges(); ///< Create world edges.
     bool DeleteObject(eSprite); ///< Delete the first object of a given sprite type.
+    bool DeleteObject(const CObjectHandle&); ///< Delete the object with a given handle.
 }; //CObjectManager
 
 #endif //__L4RC_GAME_OBJECTMANAGER_H__